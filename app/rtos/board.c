@@ -7,12 +7,24 @@
  * Date           Author       Notes
  * 2017-07-24     Tanek        the first version
  * 2018-11-12     Ernest Chen  modify copyright
+ * 2026-10-17     weizx208     add SysTick tickless idle
+ * 2026-10-17     weizx208     use DWT cycle counter as trace timestamp
+ * 2026-10-17     weizx208     use DWT cycle counter as CPU usage timestamp
+ * 2026-10-17     weizx208     use DWT cycle counter as benchmark timestamp
+ * 2026-10-17     weizx208     use DWT cycle counter as interrupt latency timestamp
+ * 2026-10-17     weizx208     use DWT cycle counter as initialization timestamp
+ * 2026-10-17     weizx208     use DWT cycle counter as workqueue timestamp
+ * 2026-10-17     weizx208     use DWT cycle counter as kernel timestamp
  */
  
 #include <stdint.h>
 #include <rthw.h>
 #include <rtthread.h>
 
+#ifdef RT_USING_TICKLESS
+#include "mhscpu.h"
+#endif
+
 #define _SCB_BASE       (0xE000E010UL)
 #define _SYSTICK_CTRL   (*(rt_uint32_t *)(_SCB_BASE + 0x0))
 #define _SYSTICK_LOAD   (*(rt_uint32_t *)(_SCB_BASE + 0x4))
@@ -44,6 +56,97 @@ static uint32_t _SysTick_Config(rt_uint32_t ticks)
     return 0;
 }
 
+#ifdef RT_USING_TICKLESS
+#define _SYSTICK_ENABLE     (1UL << 0)
+#define _SYSTICK_COUNTFLAG  (1UL << 16)
+#define _SYSTICK_MAX_LOAD   (0xFFFFFFUL)
+
+static rt_uint32_t _systick_cycles;     /* SysTick cycles in one OS tick */
+static rt_uint32_t _systick_reload;     /* the reload value of tickless sleep */
+static rt_tick_t   _systick_timeout;    /* the ticks of tickless sleep */
+
+static void _systick_timer_start(rt_tick_t timeout)
+{
+    if (timeout > _SYSTICK_MAX_LOAD / _systick_cycles)
+    {
+        timeout = _SYSTICK_MAX_LOAD / _systick_cycles;
+    }
+
+    /* stop SysTick, the rest of current tick is counted in the sleep */
+    _SYSTICK_CTRL &= ~_SYSTICK_ENABLE;
+    _systick_reload  = _SYSTICK_VAL + _systick_cycles * (timeout - 1);
+    _systick_timeout = timeout;
+
+    _SYSTICK_LOAD = _systick_reload;
+    _SYSTICK_VAL  = 0;
+    _SYSTICK_CTRL |= _SYSTICK_ENABLE;
+}
+
+static rt_tick_t _systick_timer_stop(void)
+{
+    rt_uint32_t load, passed_cycles;
+    rt_tick_t passed;
+
+    /* stop SysTick without clearing the count flag */
+    _SYSTICK_CTRL = 0x06;
+
+    if (_SYSTICK_CTRL & _SYSTICK_COUNTFLAG)
+    {
+        /* woken up by SysTick, the pending interrupt will count the last tick */
+        load = (_systick_cycles - 1) - (_systick_reload - _SYSTICK_VAL);
+        if (load >= _systick_cycles)
+        {
+            load = _systick_cycles - 1;
+        }
+        passed = _systick_timeout - 1;
+    }
+    else
+    {
+        /* woken up by other interrupt, count the whole ticks passed */
+        passed_cycles = _systick_timeout * _systick_cycles - _SYSTICK_VAL;
+        passed = passed_cycles / _systick_cycles;
+        load = (passed + 1) * _systick_cycles - passed_cycles;
+    }
+
+    /* finish the current tick, and then restore the periodic tick */
+    _SYSTICK_LOAD = load;
+    _SYSTICK_VAL  = 0;
+    _SYSTICK_CTRL |= _SYSTICK_ENABLE;
+    _SYSTICK_LOAD = _systick_cycles - 1;
+
+    return passed;
+}
+
+static void _systick_sleep(void)
+{
+    __WFI();
+}
+
+static const struct rt_tickless_ops _systick_tickless_ops =
+{
+    _systick_timer_start,
+    _systick_timer_stop,
+    _systick_sleep,
+};
+#endif
+
+#define _DEMCR          (*(volatile rt_uint32_t *)0xE000EDFCUL)
+#define _DWT_CTRL       (*(volatile rt_uint32_t *)0xE0001000UL)
+#define _DWT_CYCCNT     (*(volatile rt_uint32_t *)0xE0001004UL)
+
+static rt_uint32_t _dwt_cycle_get(void)
+{
+    return _DWT_CYCCNT;
+}
+
+static void _dwt_cycle_init(void)
+{
+    /* enable the trace unit, and then the cycle counter */
+    _DEMCR     |= (1UL << 24);
+    _DWT_CYCCNT = 0;
+    _DWT_CTRL  |= (1UL << 0);
+}
+
 #if defined(RT_USING_USER_MAIN) && defined(RT_USING_HEAP)
 #define RT_HEAP_SIZE 1024
 static uint32_t rt_heap[RT_HEAP_SIZE];     // heap default size: 4K(1024 * 4)
@@ -69,6 +172,15 @@ void rt_hw_board_init()
     /* System Tick Configuration */
     _SysTick_Config(SystemCoreClock / RT_TICK_PER_SECOND);
 
+#ifdef RT_USING_TICKLESS
+    _systick_cycles = SystemCoreClock / RT_TICK_PER_SECOND;
+    rt_tickless_register(&_systick_tickless_ops);
+#endif
+
+    /* the cycle counter as timestamp of kernel */
+    _dwt_cycle_init();
+    rt_timestamp_set(_dwt_cycle_get, SystemCoreClock);
+
     /* Call components board initial (use INIT_BOARD_EXPORT()) */
 #ifdef RT_USING_COMPONENTS_INIT
     rt_components_board_init();
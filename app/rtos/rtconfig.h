@@ -28,10 +28,48 @@
 // <o>the max length of object name<2-16>
 //  <i>Default: 8
 #define RT_NAME_MAX    8
+// <c1>Using name hash index of objects
+//  <i>rt_object_find, rt_thread_find and rt_device_find look up the name in a hash table
+//  <i>It takes one more pointer in each object
+//#define RT_USING_OBJECT_HASH
+// </c>
+// <o>the buckets of object name hash table <8-1024>
+//  <i>Must be power of 2, about the number of named objects
+//  <i>Default: 64
+#define RT_OBJECT_HASH_SIZE         64
+// <c1>Using CPU instructions to find the highest ready priority
+//  <i>Cortex-M3 and above have the RBIT and CLZ instructions
+#define RT_USING_CPU_FFS
+// </c>
+// <c1>Using preemption threshold
+//  <i>A thread sets it by rt_thread_control, only the threads of higher priority preempt the thread
+//#define RT_USING_PREEMPT_THRESHOLD
+// </c>
+// <c1>Using earliest deadline first scheduling
+//  <i>The threads set by rt_thread_control run at RT_EDF_PRIORITY, the one of earliest deadline first
+//  <i>The budget of each job is charged by the tick, see finsh command "list_edf"
+//#define RT_USING_EDF
+// </c>
+// <o>the priority of earliest deadline first threads <1-254>
+//  <i>It's only for the threads in the class
+//  <i>Default: half of the maximal level of thread priority
+#define RT_EDF_PRIORITY             4
 // <c1>Using RT-Thread components initialization
 //  <i>Using RT-Thread components initialization
 #define RT_USING_COMPONENTS_INIT
 // </c>
+// <c1>Using staged and parallel initialization
+//  <i>The functions exported by INIT_*_NODE_EXPORT run concurrently after the ones they depend on
+//  <i>Each initialization function is timed, see finsh command "initstat"
+//#define RT_USING_INIT_PARALLEL
+// </c>
+// <o>the threads of parallel initialization <1-8>
+//  <i>Including the thread invoking rt_components_init
+//  <i>Default: 2
+#define RT_INIT_WORKERS             2
+// <o>the stack size of initialization threads <256-4096>
+//  <i>Default: 1024
+#define RT_INIT_WORKER_STACK_SIZE   1024
 
 #define RT_USING_USER_MAIN
 
@@ -53,6 +91,59 @@
 //  <i> Diable Thread stack over flow detect
 //#define RT_USING_OVERFLOW_CHECK
 // </c>
+// <c1>thread stack watermark
+//  <i>The idle thread scans the unused stack of threads, see finsh command "stackstat"
+//#define RT_USING_STACK_WATERMARK
+// </c>
+// <o>the words of stack scanned in each idle loop <1-256>
+//  <i>Default: 16
+#define RT_STACK_SCAN_WORDS         16
+// <c1>CPU usage of threads
+//  <i>Account the run time of threads and interrupts, see finsh command "top"
+//#define RT_USING_CPU_USAGE
+// </c>
+// <c1>kernel micro-benchmark
+//  <i>Measure the kernel services, see finsh command "kbench"
+//#define RT_USING_KBENCH
+// </c>
+// <o>the samples of each benchmark case <16-4096>
+//  <i>Default: 256
+#define RT_KBENCH_SAMPLES           256
+// <o>the priority of benchmark threads <1-31>
+//  <i>The woken up thread runs at one priority higher
+//  <i>Default: 3
+#define RT_KBENCH_PRIORITY          3
+// <o>the stack size of benchmark threads <256-4096>
+//  <i>Default: 512
+#define RT_KBENCH_STACK_SIZE        512
+// <c1>interrupt latency measurement
+//  <i>Measure the interrupt disabled, scheduler locked and interrupt service spans, see finsh command "irqlat"
+//#define RT_USING_IRQ_LATENCY
+// </c>
+// <o>the longest spans kept for each kind <1-64>
+//  <i>One for each caller
+//  <i>Default: 8
+#define RT_IRQ_LATENCY_TOP          8
+// <c1>kernel event trace
+//  <i>Record thread switch, interrupt, IPC and timer events in a ring buffer
+//#define RT_USING_TRACE
+// </c>
+// <o>the records of trace buffer <16-4096>
+//  <i>Must be power of 2, 12 bytes each record
+//  <i>Default: 256
+#define RT_TRACE_BUF_SIZE           256
+// <c1>binary log
+//  <i>RT_BLOG records the format string address and arguments, decoded by tools/blog_decode.py
+//#define RT_USING_BLOG
+// </c>
+// <o>the words of binary log buffer <64-16384>
+//  <i>Must be power of 2, (2 + arguments) words each record
+//  <i>Default: 1024
+#define RT_BLOG_BUF_SIZE            1024
+// <c1>record kernel debug log in binary log
+//  <i>RT_DEBUG_LOG uses RT_BLOG instead of rt_kprintf
+//#define RT_DEBUG_USING_BLOG
+// </c>
 // </h>
 
 // <h>Hook Configuration
@@ -66,6 +157,27 @@
 // </c>
 // </h>
 
+// <h>Timer Configuration
+// <c1>Using hierarchical timing wheel for timers
+//  <i>Start/stop timers in O(1) instead of the sorted timer list
+//  <i>Setting the tick backward by rt_tick_set() rebuilds the wheel in O(n)
+//#define RT_USING_TIMER_WHEEL
+// </c>
+// <o>The bits of slots in each level of timing wheel <2-8>
+//  <i>Default: 6 (64 slots)
+#define RT_TIMER_WHEEL_BITS         6
+// <o>The levels of timing wheel <1-5>
+//  <i>Default: 4
+#define RT_TIMER_WHEEL_LEVEL        4
+// <c1>Using tickless idle
+//  <i>Stop the periodic tick in idle until the next timer expires
+//#define RT_USING_TICKLESS
+// </c>
+// <o>The minimum ticks to enter tickless sleep <1-1000>
+//  <i>Default: 2
+#define RT_TICKLESS_THRESHOLD       2
+// </h>
+
 // <e>Software timers Configuration
 // <i> Enables user timers
 #define RT_USING_TIMER_SOFT         0
@@ -89,6 +201,10 @@
 //  <i>Using Mutex
 //#define RT_USING_MUTEX
 // </c>
+// <c1>Using fast path of Mutex
+//  <i>The mutex is taken and released by compare-and-swap without contention
+//#define RT_USING_MUTEX_FAST
+// </c>
 // <c1>Using Event
 //  <i>Using Event
 //#define RT_USING_EVENT
@@ -101,9 +217,34 @@
 //  <i>Using Message Queue
 //#define RT_USING_MESSAGEQUEUE
 // </c>
+// <c1>Using Ring Buffer
+//  <i>Single-producer/single-consumer ring buffer for byte streams
+//#define RT_USING_RINGBUF
+// </c>
+// <c1>Using Workqueue
+//  <i>The work submitted by rt_work_submit is run by a thread, such as the bottom half of interrupt
+//#define RT_USING_WORKQUEUE
+// </c>
+// <o>The priority of system workqueue thread <0-31>
+//  <i>Default: 2
+#define RT_SYSTEM_WORKQUEUE_PRIORITY    2
+// <o>The stack size of system workqueue thread <256-4096>
+//  <i>Default: 1024
+#define RT_SYSTEM_WORKQUEUE_STACKSIZE   1024
+// <c1>Using priority index of IPC suspended list
+//  <i>Threads are inserted into the list of RT_IPC_FLAG_PRIO object in constant time
+//  <i>Each semaphore, mutex and event takes (2 + RT_THREAD_PRIORITY_MAX) words more
+//  <i>That is 136 bytes at 32 priorities on 32-bit CPU, twice for mailbox and message queue
+//  <i>At most 32 priorities
+//#define RT_USING_IPC_PRIO_INDEX
+// </c>
 // </h>
 
 // <h>Memory Management Configuration
+// <c1>Memory Pool Management
+//  <i>Memory Pool Management, it's also the message store of zero-copy message queue
+//#define RT_USING_MEMPOOL
+// </c>
 // <c1>Dynamic Heap Management
 //  <i>Dynamic Heap Management
 //#define RT_USING_HEAP
@@ -112,6 +253,18 @@
 //  <i>using small memory
 #define RT_USING_SMALL_MEM
 // </c>
+// <c1>using TLSF memory
+//  <i>Two-Level Segregated Fit algorithm, malloc and free take a constant time
+//  <i>It replaces the small memory algorithm, so disable RT_USING_SMALL_MEM
+//#define RT_USING_TLSF
+// </c>
+// <c1>Using small memory cache of thread
+//  <i>Each thread keeps a few free blocks of 16 ~ 128 bytes in front of the heap
+//#define RT_USING_MEM_CACHE
+// </c>
+// <o>The maximum cached blocks of each size <2-255>
+//  <i>Default: 8
+#define RT_MEM_CACHE_DEPTH          8
 // <c1>using tiny size of memory
 //  <i>using tiny size of memory
 //#define RT_USING_TINY_SIZE
@@ -127,6 +280,20 @@
 //  <i>the buffer size of console
 //  <i>Default: 128  (128Byte)
 #define RT_CONSOLEBUF_SIZE          128
+// <c1>Using deferred console log
+//  <i>rt_kprintf puts the string into a buffer and the log thread writes it to console
+//  <i>rt_kprintf formats in a static line of RT_CONSOLEBUF_SIZE bytes, not the stack of caller
+//#define RT_USING_KLOG
+// </c>
+// <o>the buffer size of deferred console log <256-8192:256>
+//  <i>It shall be power of 2
+//  <i>Default: 1024
+#define RT_KLOG_BUF_SIZE            1024
+// <o>the lines to format deferred console log <1-8>
+//  <i>One line for each nesting context of rt_kprintf, a thread, the one preempts it and interrupts
+//  <i>The message is dropped when all the lines are taken
+//  <i>Default: 4
+#define RT_KLOG_LINES               4
 // </h>
 
 #if defined(RT_USING_FINSH)
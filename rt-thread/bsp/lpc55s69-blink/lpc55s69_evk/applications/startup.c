@@ -7,6 +7,7 @@
  * Date           Author       Notes
  * 2017-08-08     Yang         the first version
  * 2019-07-19     Magicoe      The first version for LPC55S6x
+ * 2026-10-17     weizx208     initialize system workqueue
  */
 
 #include <rthw.h>
@@ -40,6 +41,11 @@ void rtthread_startup(void)
     /* initialize timer thread */
     rt_system_timer_thread_init();
 
+#ifdef RT_USING_WORKQUEUE
+    /* system workqueue initialization */
+    rt_system_workqueue_init();
+#endif
+
     /* initialize idle thread */
     rt_thread_idle_init();
 
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of CPU usage accounting with a controlled clock.
+ *
+ * The timestamp is a counter set by rt_timestamp_set(), it only advances when
+ * the test advances it, so the time is charged to the one running at that
+ * moment, whatever the ticks and other threads do:
+ *
+ *   the thread of command  CPU_TEST_SELF   before it starts the threads
+ *   thread a               CPU_TEST_A      then it waits
+ *   thread b               CPU_TEST_B      then it waits
+ *   the interrupt          CPU_TEST_IRQ    in the handler
+ *
+ * The finsh command "cputest" checks the run time and the share of each one
+ * in the window, and returns non-zero if it fails. The monotonic clock of host
+ * is set back as the timestamp at last, as the BSP does.
+ */
+
+#include <time.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "cpuport.h"
+
+#if defined(RT_USING_CPU_USAGE) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define CPU_TEST_IRQ_VECTOR     2
+#define CPU_TEST_PRIORITY       5
+#define CPU_TEST_STACK_SIZE     4096
+
+#define CPU_TEST_SELF           100
+#define CPU_TEST_A              300
+#define CPU_TEST_B              500
+#define CPU_TEST_IRQ            100
+#define CPU_TEST_TOTAL          (CPU_TEST_SELF + CPU_TEST_A + CPU_TEST_B + CPU_TEST_IRQ)
+
+static struct rt_thread _test_a, _test_b;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_a_stack[CPU_TEST_STACK_SIZE];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_b_stack[CPU_TEST_STACK_SIZE];
+
+static struct rt_semaphore _test_sem;
+static volatile rt_uint32_t _test_clock;
+
+static rt_uint32_t _test_clock_get(void)
+{
+    return _test_clock;
+}
+
+/* the monotonic clock of host in nanoseconds */
+static rt_uint32_t _test_host_clock_get(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (rt_uint32_t)(now.tv_sec * 1000000000UL + now.tv_nsec);
+}
+
+static void _test_isr(int vector, void *param)
+{
+    _test_clock += CPU_TEST_IRQ;
+}
+
+static void _test_entry(void *parameter)
+{
+    _test_clock += (rt_uint32_t)(rt_ubase_t)parameter;
+
+    rt_sem_take(&_test_sem, RT_WAITING_FOREVER);
+}
+
+static int _test_check(const char *name, rt_uint64_t first, rt_uint64_t last,
+                       rt_uint32_t expected)
+{
+    rt_uint32_t share;
+
+    /* in per mille of the window */
+    share = (rt_uint32_t)((last - first) * 1000 / CPU_TEST_TOTAL);
+    rt_kprintf("cputest: %-6s %4d, %3d.%d%%\n", name, (rt_uint32_t)(last - first),
+               share / 10, share % 10);
+    if (last - first != expected)
+    {
+        rt_kprintf("cputest: %s is charged %d, not %d\n", name, (rt_uint32_t)(last - first),
+                   expected);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+static int cputest(void)
+{
+    int errors = 0;
+    rt_thread_t self = rt_thread_self();
+    rt_uint64_t self_first, irq_first;
+    rt_uint64_t self_last, irq_last, a_last, b_last;
+
+    rt_sem_init(&_test_sem, "tcpu", 0, RT_IPC_FLAG_FIFO);
+    rt_hw_interrupt_install(CPU_TEST_IRQ_VECTOR, _test_isr, RT_NULL, "cputest");
+    rt_hw_interrupt_umask(CPU_TEST_IRQ_VECTOR);
+    rt_thread_init(&_test_a, "tcpua", _test_entry, (void *)CPU_TEST_A,
+                   _test_a_stack, sizeof(_test_a_stack), CPU_TEST_PRIORITY, 10);
+    rt_thread_init(&_test_b, "tcpub", _test_entry, (void *)CPU_TEST_B,
+                   _test_b_stack, sizeof(_test_b_stack), CPU_TEST_PRIORITY, 10);
+
+    /* the accounting restarts from the clock set */
+    _test_clock = 0;
+    rt_timestamp_set(_test_clock_get, 1000000);
+    self_first = rt_cpu_usage_get(self);
+    irq_first  = rt_cpu_usage_get(RT_NULL);
+
+    _test_clock += CPU_TEST_SELF;
+    /* each thread preempts, runs and waits */
+    rt_thread_startup(&_test_a);
+    rt_thread_startup(&_test_b);
+    rt_hw_interrupt_raise(CPU_TEST_IRQ_VECTOR);
+
+    self_last = rt_cpu_usage_get(self);
+    irq_last  = rt_cpu_usage_get(RT_NULL);
+    a_last    = rt_cpu_usage_get(&_test_a);
+    b_last    = rt_cpu_usage_get(&_test_b);
+
+    rt_timestamp_set(_test_host_clock_get, 1000000000UL);
+    rt_hw_interrupt_mask(CPU_TEST_IRQ_VECTOR);
+
+    errors += _test_check(self->name, self_first, self_last, CPU_TEST_SELF);
+    errors += _test_check("tcpua", 0, a_last, CPU_TEST_A);
+    errors += _test_check("tcpub", 0, b_last, CPU_TEST_B);
+    errors += _test_check("irq", irq_first, irq_last, CPU_TEST_IRQ);
+
+    /* the thread object is detached when it exits */
+    rt_sem_release(&_test_sem);
+    rt_sem_release(&_test_sem);
+    while ((_test_a.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE ||
+           (_test_b.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+        rt_thread_delay(1);
+    rt_sem_detach(&_test_sem);
+
+    rt_kprintf("cputest: %s\n", (errors == 0) ? "passed" : "failed");
+
+    return (errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(cputest, test of CPU usage accounting);
+#endif
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of earliest deadline first scheduling.
+ *
+ * Two periodic threads, A runs 14 ms every 40 ms and B runs 34 ms every
+ * 60 ms, take 91.7% of CPU. Each job spins until it has run its time, as
+ * measured by the CPU usage accounting.
+ *
+ * The finsh command "edftest" runs them with fixed priorities of rate
+ * monotonic, where B misses its deadline as the utilization is beyond the
+ * bound of rate monotonic, and again in earliest deadline first class, where
+ * all deadlines are met. It prints the jobs and misses of each.
+ *
+ * Then a thread runs 5 ms every 40 ms with a budget of 2 ms, its jobs are
+ * throttled as the budget is exhausted long before the deadline, which
+ * shall be counted as overruns, not misses.
+ *
+ * At last a thread holding a mutex, taken with or without contention, is
+ * refused to enter the class, which would overwrite its inherited priority.
+ *
+ * It returns non-zero if any job misses in earliest deadline first class.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_EDF) && defined(RT_USING_CPU_USAGE) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define EDF_TEST_HYPERPERIODS   6
+#define EDF_TEST_HYPERPERIOD    120
+#define EDF_TEST_PRIORITY       14
+#define EDF_TEST_STACK_SIZE     4096
+
+struct _test_task
+{
+    const char *name;
+    rt_tick_t   period;
+    rt_tick_t   time;
+
+    struct rt_thread thread;
+    rt_uint32_t jobs;
+    rt_uint32_t misses;
+};
+
+static struct _test_task _test_tasks[2] =
+{
+    {"edf_a", 40, 14},
+    {"edf_b", 60, 34},
+};
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_stacks[2][EDF_TEST_STACK_SIZE];
+
+static struct rt_semaphore _test_done;
+static volatile int _test_edf;
+static rt_tick_t _test_start;
+
+/* spin until the thread has run the time of job */
+static void _test_job(struct _test_task *task)
+{
+    rt_uint64_t start, time;
+
+    time  = (rt_uint64_t)task->time * rt_timestamp_get_frequency() / RT_TICK_PER_SECOND;
+    start = rt_cpu_usage_get(rt_thread_self());
+    while (rt_cpu_usage_get(rt_thread_self()) - start < time);
+}
+
+static void _test_entry(void *parameter)
+{
+    struct _test_task *task;
+    struct rt_edf_param param;
+    rt_tick_t release, now;
+    rt_uint32_t jobs;
+
+    task = (struct _test_task *)parameter;
+    jobs = EDF_TEST_HYPERPERIODS * EDF_TEST_HYPERPERIOD / task->period;
+
+    if (_test_edf)
+    {
+        /* the budget is charged by tick, a job may see one more tick at each
+         * end of the runs it's split into */
+        param.period   = task->period;
+        param.budget   = task->time + 2;
+        param.deadline = 0;
+        if (rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_EDF, &param) != RT_EOK)
+        {
+            rt_kprintf("edftest: %s is not admitted\n", task->name);
+            rt_sem_release(&_test_done);
+            return;
+        }
+
+        for (task->jobs = 0; task->jobs < jobs; task->jobs ++)
+        {
+            _test_job(task);
+            rt_thread_edf_wait();
+        }
+        task->misses = task->thread.edf.misses;
+
+        param.period = 0;
+        rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_EDF, &param);
+    }
+    else
+    {
+        release = _test_start;
+        for (task->jobs = 0; task->jobs < jobs; task->jobs ++)
+        {
+            _test_job(task);
+
+            now = rt_tick_get();
+            release += task->period;
+            if ((rt_int32_t)(now - release) > 0)
+                task->misses ++;
+            else
+                rt_thread_delay(release - now);
+        }
+    }
+
+    rt_sem_release(&_test_done);
+}
+
+static void _test_run(int edf)
+{
+    int index;
+
+    _test_edf = edf;
+
+    /* start the threads together */
+    rt_enter_critical();
+    _test_start = rt_tick_get();
+    for (index = 0; index < 2; index ++)
+    {
+        _test_tasks[index].jobs   = 0;
+        _test_tasks[index].misses = 0;
+        /* rate monotonic, the shorter period the higher priority */
+        rt_thread_init(&_test_tasks[index].thread, _test_tasks[index].name, _test_entry,
+                       &_test_tasks[index], _test_stacks[index], EDF_TEST_STACK_SIZE,
+                       EDF_TEST_PRIORITY + index, 10);
+        rt_thread_startup(&_test_tasks[index].thread);
+    }
+    rt_exit_critical();
+
+    for (index = 0; index < 2; index ++)
+        rt_sem_take(&_test_done, RT_WAITING_FOREVER);
+
+    /* the thread object is detached when it exits, then it can be initialized again */
+    for (index = 0; index < 2; index ++)
+    {
+        while ((_test_tasks[index].thread.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+            rt_thread_delay(1);
+    }
+
+    rt_kprintf("edftest: %-15s %s %d jobs %d misses, %s %d jobs %d misses\n",
+               edf ? "edf" : "rate monotonic",
+               _test_tasks[0].name, _test_tasks[0].jobs, _test_tasks[0].misses,
+               _test_tasks[1].name, _test_tasks[1].jobs, _test_tasks[1].misses);
+}
+
+static void _test_overrun_entry(void *parameter)
+{
+    struct _test_task *task;
+    struct rt_edf_param param;
+
+    task = (struct _test_task *)parameter;
+
+    param.period   = task->period;
+    param.budget   = 2;
+    param.deadline = 0;
+    if (rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_EDF, &param) != RT_EOK)
+    {
+        rt_kprintf("edftest: %s is not admitted\n", task->name);
+        rt_sem_release(&_test_done);
+        return;
+    }
+
+    for (task->jobs = 0; task->jobs < 3; task->jobs ++)
+    {
+        _test_job(task);
+        rt_thread_edf_wait();
+    }
+    task->misses = task->thread.edf.misses;
+    if (task->thread.edf.overruns == 0)
+    {
+        rt_kprintf("edftest: %s is not throttled\n", task->name);
+        task->misses ++;
+    }
+
+    param.period = 0;
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_EDF, &param);
+
+    rt_sem_release(&_test_done);
+}
+
+/* the jobs overrun their budget, but none misses the deadline */
+static int _test_overrun(void)
+{
+    static struct _test_task task = {"edf_o", 40, 5};
+
+    task.jobs   = 0;
+    task.misses = 0;
+    rt_thread_init(&task.thread, task.name, _test_overrun_entry, &task,
+                   _test_stacks[0], EDF_TEST_STACK_SIZE, EDF_TEST_PRIORITY, 10);
+    rt_thread_startup(&task.thread);
+
+    rt_sem_take(&_test_done, RT_WAITING_FOREVER);
+    while ((task.thread.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+        rt_thread_delay(1);
+
+    rt_kprintf("edftest: %-15s %s %d jobs %d misses\n", "overrun",
+               task.name, task.jobs, task.misses);
+
+    return (task.misses == 0) ? 0 : -1;
+}
+
+#ifdef RT_USING_MUTEX
+/* the current thread holds a mutex, taken fast once then again in slow path */
+static int _test_mutex(void)
+{
+    int errors = 0;
+    int index;
+    struct rt_mutex mutex;
+    struct rt_edf_param param;
+    rt_uint8_t priority;
+
+    param.period   = 40;
+    param.budget   = 2;
+    param.deadline = 0;
+    priority = rt_thread_self()->current_priority;
+
+    rt_mutex_init(&mutex, "tedf", RT_IPC_FLAG_FIFO);
+    for (index = 0; index < 2; index ++)
+    {
+        rt_mutex_take(&mutex, RT_WAITING_FOREVER);
+        if (rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_EDF, &param) != -RT_EBUSY ||
+            rt_thread_self()->current_priority != priority)
+        {
+            rt_kprintf("edftest: a thread holding a mutex %d times is admitted\n", index + 1);
+            errors ++;
+        }
+    }
+    rt_mutex_release(&mutex);
+    rt_mutex_release(&mutex);
+    rt_mutex_detach(&mutex);
+
+    return (errors == 0) ? 0 : -1;
+}
+#endif
+
+static int edftest(void)
+{
+    int result;
+
+    rt_sem_init(&_test_done, "tdone", 0, RT_IPC_FLAG_FIFO);
+
+    _test_run(0);
+    _test_run(1);
+    result = (_test_tasks[0].misses == 0 && _test_tasks[1].misses == 0) ? 0 : -1;
+    if (_test_overrun() != 0)
+        result = -1;
+#ifdef RT_USING_MUTEX
+    if (_test_mutex() != 0)
+        result = -1;
+#endif
+
+    rt_sem_detach(&_test_done);
+
+    return result;
+}
+MSH_CMD_EXPORT(edftest, test of earliest deadline first scheduling);
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of parallel initialization.
+ *
+ * Four nodes of application level take INIT_TEST_DELAY ms each, such as the
+ * probe of a slow device:
+ *
+ *   init_test_a ---+---> init_test_c
+ *   init_test_b ---+
+ *   init_test_a -------> init_test_d
+ *
+ * A single node of environment level runs alone in its stage, which is done
+ * by the caller without the other workers.
+ *
+ * The finsh command "inittest" checks that each node started after the ones
+ * it depends on, that the single node has run, and that they took less time
+ * than running one by one. It prints the time of both, and returns non-zero
+ * if it fails.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_INIT_PARALLEL) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define INIT_TEST_DELAY         30
+#define INIT_TEST_NODES         4
+
+static const char *_test_names[INIT_TEST_NODES] =
+{
+    "init_test_a", "init_test_b", "init_test_c", "init_test_d"
+};
+/* the nodes each one depends on, as bits of index */
+static const rt_uint8_t _test_depends[INIT_TEST_NODES] = {0x0, 0x0, 0x3, 0x1};
+
+static volatile rt_uint8_t _test_done;
+static volatile rt_uint8_t _test_single_done;
+static volatile int _test_errors;
+
+static int init_test_single(void)
+{
+    _test_single_done = 1;
+
+    return 0;
+}
+INIT_ENV_NODE_EXPORT(init_test_single, RT_NULL);
+
+static int _test_node(int index)
+{
+    /* the nodes depended shall be done when it starts */
+    if ((_test_done & _test_depends[index]) != _test_depends[index])
+        _test_errors ++;
+
+    rt_thread_mdelay(INIT_TEST_DELAY);
+    _test_done |= 1 << index;
+
+    return 0;
+}
+
+static int init_test_a(void)
+{
+    return _test_node(0);
+}
+INIT_APP_NODE_EXPORT(init_test_a, "");
+
+static int init_test_b(void)
+{
+    return _test_node(1);
+}
+INIT_APP_NODE_EXPORT(init_test_b, RT_NULL);
+
+static int init_test_c(void)
+{
+    return _test_node(2);
+}
+INIT_APP_NODE_EXPORT(init_test_c, "init_test_a,init_test_b");
+
+static int init_test_d(void)
+{
+    return _test_node(3);
+}
+INIT_APP_NODE_EXPORT(init_test_d, "init_test_a");
+
+static int inittest(void)
+{
+    int index, depend, found;
+    const char *name;
+    rt_uint8_t stage;
+    rt_uint32_t record, start, time;
+    rt_uint32_t starts[INIT_TEST_NODES], ends[INIT_TEST_NODES];
+    rt_uint32_t first, last, sum;
+
+    /* find the time of test nodes */
+    found = 0;
+    for (record = 0; rt_init_record_get(record, &name, &stage, &start, &time) == RT_EOK; record ++)
+    {
+        for (index = 0; index < INIT_TEST_NODES; index ++)
+        {
+            if (name != RT_NULL && rt_strcmp(name, _test_names[index]) == 0)
+            {
+                starts[index] = start;
+                ends[index]   = start + time;
+                found ++;
+            }
+        }
+    }
+    if (found != INIT_TEST_NODES || _test_done != (1 << INIT_TEST_NODES) - 1)
+    {
+        rt_kprintf("inittest: %d of %d nodes run\n", found, INIT_TEST_NODES);
+        return -1;
+    }
+    if (!_test_single_done)
+    {
+        rt_kprintf("inittest: the single node didn't run\n");
+        return -1;
+    }
+
+    first = starts[0];
+    last  = ends[0];
+    sum   = 0;
+    for (index = 0; index < INIT_TEST_NODES; index ++)
+    {
+        for (depend = 0; depend < INIT_TEST_NODES; depend ++)
+        {
+            if ((_test_depends[index] & (1 << depend)) && starts[index] < ends[depend])
+            {
+                rt_kprintf("inittest: %s started before %s is done\n",
+                           _test_names[index], _test_names[depend]);
+                _test_errors ++;
+            }
+        }
+
+        if (starts[index] < first)
+            first = starts[index];
+        if (ends[index] > last)
+            last = ends[index];
+        sum += ends[index] - starts[index];
+    }
+
+    rt_kprintf("inittest: one by one %d us, parallel %d us, saved %d us\n",
+               sum, last - first, (sum > last - first) ? sum - (last - first) : 0);
+
+    /* two of them run at the same time in the best case */
+    if (RT_INIT_WORKERS > 1 && (last - first) > sum * 3 / 4)
+    {
+        rt_kprintf("inittest: the nodes didn't run concurrently\n");
+        _test_errors ++;
+    }
+
+    return (_test_errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(inittest, test of parallel initialization);
+#endif
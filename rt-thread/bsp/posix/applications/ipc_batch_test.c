@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of batched send and receive of mailbox and message queue.
+ *
+ * The finsh command "batchtest" checks that:
+ *
+ *   - a batch sent to a queue without enough free room returns the number
+ *     sent, with -RT_EFULL in errno when not waiting and -RT_ETIMEOUT in errno
+ *     when the waiting times out
+ *   - a batch received returns the number received, less than count when the
+ *     queue has less, and zero with -RT_ETIMEOUT in errno when it's empty
+ *   - a batch larger than the queue is sent completely while a receiver of
+ *     the same priority takes it in smaller batches, in order
+ *
+ * It returns non-zero if it fails.
+ */
+
+#include <rtthread.h>
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#define BATCH_TEST_SIZE         4
+#define BATCH_TEST_COUNT        10
+#define BATCH_TEST_WAIT         5
+#define BATCH_TEST_RECV         3
+
+static struct rt_thread _test_thread;
+ALIGN(RT_ALIGN_SIZE)
+static char _test_stack[1024];
+static rt_ubase_t _test_received[BATCH_TEST_COUNT];
+static volatile rt_size_t _test_received_count;
+
+/* check the number returned, and errno when it's less than requested */
+static int _test_result(const char *what, rt_size_t count, rt_size_t expected, rt_err_t error)
+{
+    rt_err_t errno_saved = rt_get_errno();
+
+    if (count != expected)
+    {
+        rt_kprintf("batchtest: %s returned %d, not %d\n", what, count, expected);
+        return 1;
+    }
+    if (error != RT_EOK && errno_saved != error)
+    {
+        rt_kprintf("batchtest: %s set errno %d, not %d\n", what, (int)errno_saved, (int)error);
+        return 1;
+    }
+
+    return 0;
+}
+
+static int _test_values(const char *what, const rt_ubase_t *values, rt_size_t count,
+                        rt_ubase_t first)
+{
+    rt_size_t index;
+
+    for (index = 0; index < count; index ++)
+    {
+        if (values[index] != first + index)
+        {
+            rt_kprintf("batchtest: %s got %d at %d, not %d\n", what,
+                       values[index], index, first + index);
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/* wait for the receiver thread, which takes BATCH_TEST_COUNT values */
+static int _test_wait_receiver(const char *what)
+{
+    while ((_test_thread.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+        rt_thread_delay(1);
+
+    return _test_result(what, _test_received_count, BATCH_TEST_COUNT, RT_EOK) +
+           _test_values(what, _test_received, _test_received_count, 0);
+}
+
+#ifdef RT_USING_MAILBOX
+static struct rt_mailbox _test_mb;
+static rt_ubase_t _test_mb_pool[BATCH_TEST_SIZE];
+
+static void _test_mb_receiver(void *parameter)
+{
+    rt_ubase_t values[BATCH_TEST_RECV];
+    rt_size_t count, index;
+
+    while (_test_received_count < BATCH_TEST_COUNT)
+    {
+        count = rt_mb_recv_n(&_test_mb, values, BATCH_TEST_RECV, RT_WAITING_FOREVER);
+        if (count == 0)
+            break;
+        for (index = 0; index < count && _test_received_count < BATCH_TEST_COUNT; index ++)
+            _test_received[_test_received_count ++] = values[index];
+    }
+}
+
+static int _test_mb_batch(void)
+{
+    int errors = 0;
+    rt_ubase_t values[BATCH_TEST_COUNT];
+    rt_size_t count, index;
+
+    for (index = 0; index < BATCH_TEST_COUNT; index ++)
+        values[index] = index;
+
+    rt_mb_init(&_test_mb, "tbatch", _test_mb_pool, BATCH_TEST_SIZE, RT_IPC_FLAG_FIFO);
+
+    count = rt_mb_send_n(&_test_mb, values, BATCH_TEST_SIZE + 2, RT_WAITING_NO);
+    errors += _test_result("mb_send_n no wait", count, BATCH_TEST_SIZE, -RT_EFULL);
+    count = rt_mb_send_n(&_test_mb, values, 2, BATCH_TEST_WAIT);
+    errors += _test_result("mb_send_n wait", count, 0, -RT_ETIMEOUT);
+
+    count = rt_mb_recv_n(&_test_mb, values, BATCH_TEST_RECV, RT_WAITING_NO);
+    errors += _test_result("mb_recv_n", count, BATCH_TEST_RECV, RT_EOK);
+    errors += _test_values("mb_recv_n", values, count, 0);
+
+    count = rt_mb_recv_n(&_test_mb, values, BATCH_TEST_COUNT, RT_WAITING_NO);
+    errors += _test_result("mb_recv_n partly", count, BATCH_TEST_SIZE - BATCH_TEST_RECV, RT_EOK);
+    errors += _test_values("mb_recv_n partly", values, count, BATCH_TEST_RECV);
+
+    count = rt_mb_recv_n(&_test_mb, values, 2, RT_WAITING_NO);
+    errors += _test_result("mb_recv_n empty no wait", count, 0, -RT_ETIMEOUT);
+    count = rt_mb_recv_n(&_test_mb, values, 2, BATCH_TEST_WAIT);
+    errors += _test_result("mb_recv_n empty wait", count, 0, -RT_ETIMEOUT);
+
+    /* a batch larger than the mailbox */
+    for (index = 0; index < BATCH_TEST_COUNT; index ++)
+        values[index] = index;
+    _test_received_count = 0;
+    rt_thread_init(&_test_thread, "tbatch", _test_mb_receiver, RT_NULL,
+                   _test_stack, sizeof(_test_stack),
+                   rt_thread_self()->current_priority, 5);
+    rt_thread_startup(&_test_thread);
+
+    count = rt_mb_send_n(&_test_mb, values, BATCH_TEST_COUNT, RT_WAITING_FOREVER);
+    errors += _test_result("mb_send_n forever", count, BATCH_TEST_COUNT, RT_EOK);
+    errors += _test_wait_receiver("mb receiver");
+
+    rt_mb_detach(&_test_mb);
+
+    return errors;
+}
+#endif
+
+#ifdef RT_USING_MESSAGEQUEUE
+static struct rt_messagequeue _test_mq;
+/* room for the header and the value of each message */
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_mq_pool[BATCH_TEST_SIZE * 4 * sizeof(void *)];
+
+static void _test_mq_receiver(void *parameter)
+{
+    rt_ubase_t values[BATCH_TEST_RECV];
+    rt_size_t count, index;
+
+    while (_test_received_count < BATCH_TEST_COUNT)
+    {
+        count = rt_mq_recv_n(&_test_mq, values, sizeof(values[0]), BATCH_TEST_RECV,
+                             RT_WAITING_FOREVER);
+        if (count == 0)
+            break;
+        for (index = 0; index < count && _test_received_count < BATCH_TEST_COUNT; index ++)
+            _test_received[_test_received_count ++] = values[index];
+    }
+}
+
+static int _test_mq_batch(void)
+{
+    int errors = 0;
+    rt_ubase_t values[BATCH_TEST_COUNT];
+    rt_size_t count, index, size;
+
+    for (index = 0; index < BATCH_TEST_COUNT; index ++)
+        values[index] = index;
+
+    rt_mq_init(&_test_mq, "tbatch", _test_mq_pool, sizeof(void *), sizeof(_test_mq_pool),
+               RT_IPC_FLAG_FIFO);
+    size = _test_mq.max_msgs;
+
+    count = rt_mq_send_n(&_test_mq, values, sizeof(values[0]), size + 2, RT_WAITING_NO);
+    errors += _test_result("mq_send_n no wait", count, size, -RT_EFULL);
+    count = rt_mq_send_n(&_test_mq, values, sizeof(values[0]), 2, BATCH_TEST_WAIT);
+    errors += _test_result("mq_send_n wait", count, 0, -RT_ETIMEOUT);
+
+    rt_memset(values, 0, sizeof(values));
+    count = rt_mq_recv_n(&_test_mq, values, sizeof(values[0]), BATCH_TEST_RECV, RT_WAITING_NO);
+    errors += _test_result("mq_recv_n", count, BATCH_TEST_RECV, RT_EOK);
+    errors += _test_values("mq_recv_n", values, count, 0);
+
+    count = rt_mq_recv_n(&_test_mq, values, sizeof(values[0]), BATCH_TEST_COUNT, RT_WAITING_NO);
+    errors += _test_result("mq_recv_n partly", count, size - BATCH_TEST_RECV, RT_EOK);
+    errors += _test_values("mq_recv_n partly", values, count, BATCH_TEST_RECV);
+
+    count = rt_mq_recv_n(&_test_mq, values, sizeof(values[0]), 2, RT_WAITING_NO);
+    errors += _test_result("mq_recv_n empty no wait", count, 0, -RT_ETIMEOUT);
+    count = rt_mq_recv_n(&_test_mq, values, sizeof(values[0]), 2, BATCH_TEST_WAIT);
+    errors += _test_result("mq_recv_n empty wait", count, 0, -RT_ETIMEOUT);
+
+    /* a batch larger than the message queue */
+    for (index = 0; index < BATCH_TEST_COUNT; index ++)
+        values[index] = index;
+    _test_received_count = 0;
+    rt_thread_init(&_test_thread, "tbatch", _test_mq_receiver, RT_NULL,
+                   _test_stack, sizeof(_test_stack),
+                   rt_thread_self()->current_priority, 5);
+    rt_thread_startup(&_test_thread);
+
+    count = rt_mq_send_n(&_test_mq, values, sizeof(values[0]), BATCH_TEST_COUNT,
+                         RT_WAITING_FOREVER);
+    errors += _test_result("mq_send_n forever", count, BATCH_TEST_COUNT, RT_EOK);
+    errors += _test_wait_receiver("mq receiver");
+
+    rt_mq_detach(&_test_mq);
+
+    return errors;
+}
+#endif
+
+static int batchtest(void)
+{
+    int errors = 0;
+
+#ifdef RT_USING_MAILBOX
+    errors += _test_mb_batch();
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+    errors += _test_mq_batch();
+#endif
+
+    rt_kprintf("batchtest: %s\n", (errors == 0) ? "passed" : "failed");
+
+    return (errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(batchtest, test of batched send and receive);
+#endif
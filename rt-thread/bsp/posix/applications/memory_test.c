@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ * 2026-10-17     weizx208     test rt_strlen and rt_strncmp
+ */
+
+/*
+ * Test of memory copy and compare in kservice.
+ *
+ * The finsh command "memtest" runs rt_memcpy, rt_memmove, rt_memcmp, rt_strlen
+ * and rt_strncmp and the ones of host libc on the same random bytes, over the
+ * offsets of source and destination in a word and the lengths of 0 ~ 4096
+ * bytes:
+ *
+ *   memcpy   the destination, and the bytes around it, are the same
+ *   memmove  the same, the source and destination overlap in both directions
+ *   memcmp   the sign of result is the same, a byte differs at random place
+ *   strlen   the length is the same, the bytes after terminator are random
+ *   strncmp  the sign of result is the same, a character differs or the
+ *            string ends at random place, the count stops before, on or
+ *            after it
+ *
+ * It returns non-zero if it fails.
+ */
+
+#include <string.h>
+
+#include <rtthread.h>
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#define MEM_TEST_MAX            4096
+/* the bytes around the destination, which shall not be touched */
+#define MEM_TEST_GUARD          16
+
+static const rt_uint16_t _test_lengths[] =
+{
+    100, 127, 128, 129, 255, 256, 257, 1000, 1023, 1024, 1025, 4095, 4096
+};
+
+static rt_uint8_t _test_src[MEM_TEST_MAX + MEM_TEST_GUARD * 2];
+static rt_uint8_t _test_dst[MEM_TEST_MAX + MEM_TEST_GUARD * 2];
+static rt_uint8_t _test_ref[MEM_TEST_MAX + MEM_TEST_GUARD * 2];
+
+static rt_uint32_t _test_seed;
+static int _test_errors;
+
+static rt_uint8_t _test_random(void)
+{
+    _test_seed = _test_seed * 1103515245 + 12345;
+
+    return (rt_uint8_t)(_test_seed >> 16);
+}
+
+static void _test_fill(rt_uint8_t *buffer, rt_size_t size)
+{
+    while (size --)
+        *buffer ++ = _test_random();
+}
+
+static void _test_fail(const char *name, int src, int dst, int length)
+{
+    /* only the first ones are printed */
+    if (_test_errors ++ < 8)
+        rt_kprintf("memtest: %s failed, src +%d, dst +%d, length %d\n", name, src, dst, length);
+}
+
+static void _test_copy(int src, int dst, int length)
+{
+    void *result;
+
+    _test_fill(_test_src, sizeof(_test_src));
+    _test_fill(_test_dst, sizeof(_test_dst));
+    rt_memcpy(_test_ref, _test_dst, sizeof(_test_ref));
+
+    result = rt_memcpy(_test_dst + MEM_TEST_GUARD + dst, _test_src + src, length);
+    memcpy(_test_ref + MEM_TEST_GUARD + dst, _test_src + src, length);
+    if (result != _test_dst + MEM_TEST_GUARD + dst ||
+        memcmp(_test_dst, _test_ref, sizeof(_test_dst)) != 0)
+    {
+        _test_fail("memcpy", src, dst, length);
+    }
+}
+
+static void _test_move(int src, int dst, int length)
+{
+    void *result;
+
+    /* the source and destination are in one buffer, they overlap */
+    _test_fill(_test_dst, sizeof(_test_dst));
+    rt_memcpy(_test_ref, _test_dst, sizeof(_test_ref));
+
+    result = rt_memmove(_test_dst + dst, _test_dst + src, length);
+    memmove(_test_ref + dst, _test_ref + src, length);
+    if (result != _test_dst + dst || memcmp(_test_dst, _test_ref, sizeof(_test_dst)) != 0)
+        _test_fail("memmove", src, dst, length);
+}
+
+static int _test_sign(int value)
+{
+    return (value > 0) - (value < 0);
+}
+
+static void _test_compare(int src, int dst, int length)
+{
+    int place;
+    rt_uint8_t *cs, *ct;
+
+    cs = _test_src + src;
+    ct = _test_dst + dst;
+    _test_fill(cs, length);
+    rt_memcpy(ct, cs, length);
+    if (rt_memcmp(cs, ct, length) != 0)
+        _test_fail("memcmp", src, dst, length);
+
+    if (length == 0)
+        return;
+
+    /* a byte differs, the bytes after it are random */
+    place = (_test_random() | (_test_random() << 8)) % length;
+    ct[place] = _test_random();
+    _test_fill(ct + place + 1, length - place - 1);
+    if (_test_sign(rt_memcmp(cs, ct, length)) != _test_sign(memcmp(cs, ct, length)) ||
+        _test_sign(rt_memcmp(ct, cs, length)) != _test_sign(memcmp(ct, cs, length)))
+    {
+        _test_fail("memcmp", src, dst, length);
+    }
+}
+
+/* a random character which is not the terminator */
+static char _test_char(int ascii)
+{
+    rt_uint8_t value;
+
+    /* rt_strncmp compares in char, which is signed in some compilers */
+    value = _test_random() & (ascii ? 0x7f : 0xff);
+
+    return (char)(value ? value : 'a');
+}
+
+static void _test_strlen(int src, int length)
+{
+    int index;
+    char *cs;
+
+    cs = (char *)_test_src + src;
+    for (index = 0; index < length; index ++)
+        cs[index] = _test_char(0);
+    cs[length] = '\0';
+    _test_fill((rt_uint8_t *)cs + length + 1, MEM_TEST_GUARD);
+
+    if (rt_strlen(cs) != strlen(cs))
+        _test_fail("strlen", src, 0, length);
+}
+
+/* the counts before, on and after the place a string differs */
+static void _test_strncmp_counts(char *cs, char *ct, int place, int src, int dst, int length)
+{
+    int index;
+    rt_ubase_t count;
+    const rt_ubase_t counts[] = {0, place / 2, place, place + 1, length, length + 1, length + 9};
+
+    for (index = 0; index < sizeof(counts) / sizeof(counts[0]); index ++)
+    {
+        count = counts[index];
+        if (_test_sign(rt_strncmp(cs, ct, count)) != _test_sign(strncmp(cs, ct, count)) ||
+            _test_sign(rt_strncmp(ct, cs, count)) != _test_sign(strncmp(ct, cs, count)))
+        {
+            _test_fail("strncmp", src, dst, length);
+            break;
+        }
+    }
+}
+
+static void _test_strncmp(int src, int dst, int length)
+{
+    int index, place;
+    char *cs, *ct;
+
+    cs = (char *)_test_src + src;
+    ct = (char *)_test_dst + dst;
+    for (index = 0; index < length; index ++)
+        cs[index] = _test_char(1);
+    cs[length] = '\0';
+    rt_memcpy(ct, cs, length + 1);
+    /* the bytes after terminator are different */
+    _test_fill((rt_uint8_t *)cs + length + 1, MEM_TEST_GUARD);
+    _test_fill((rt_uint8_t *)ct + length + 1, MEM_TEST_GUARD);
+    _test_strncmp_counts(cs, ct, length, src, dst, length);
+
+    if (length == 0)
+        return;
+
+    /* a character differs, or one string ends early */
+    place = (_test_random() | (_test_random() << 8)) % length;
+    if (_test_random() & 1)
+    {
+        ct[place] = '\0';
+    }
+    else
+    {
+        while (ct[place] == cs[place])
+            ct[place] = _test_char(1);
+    }
+    _test_strncmp_counts(cs, ct, place, src, dst, length);
+}
+
+static void _test_length(int length)
+{
+    int src, dst;
+
+    for (src = 0; src < 8; src ++)
+    {
+        _test_strlen(src, length);
+        for (dst = 0; dst < 8; dst ++)
+        {
+            _test_copy(src, dst, length);
+            _test_compare(src, dst, length);
+            _test_strncmp(src, dst, length);
+        }
+    }
+
+    /* overlap in both directions, by less and more than a word */
+    for (src = 0; src < MEM_TEST_GUARD * 2; src ++)
+    {
+        for (dst = 0; dst < MEM_TEST_GUARD * 2; dst ++)
+            _test_move(src, dst, length);
+    }
+}
+
+static int memtest(void)
+{
+    int index, length, count;
+
+    _test_seed   = 1;
+    _test_errors = 0;
+    count = 0;
+
+    for (length = 0; length <= 64; length ++, count ++)
+        _test_length(length);
+    for (index = 0; index < sizeof(_test_lengths) / sizeof(_test_lengths[0]); index ++, count ++)
+        _test_length(_test_lengths[index]);
+
+    rt_kprintf("memtest: %d lengths, %d errors\n", count, _test_errors);
+
+    return (_test_errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(memtest, test of memory and string copy and compare);
+#endif
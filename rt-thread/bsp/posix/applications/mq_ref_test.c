@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of zero-copy message queue.
+ *
+ * The finsh command "mqreftest" allocates blocks from the memory pool of a
+ * zero-copy message queue, sends some of them and receives one back. Then it
+ * resets, detaches or deletes the queue, and checks that the blocks still in
+ * the queue are returned to the memory pool, while the block allocated but
+ * not sent and the block received stay owned by the thread until it frees
+ * them by rt_mp_free.
+ *
+ * It returns non-zero if it fails.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_MESSAGEQUEUE) && defined(RT_USING_MEMPOOL) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define MQREF_TEST_BLOCKS       8
+#define MQREF_TEST_BLOCK_SIZE   32
+#define MQREF_TEST_MSGS         4
+#define MQREF_TEST_SENT         3
+
+enum
+{
+    MQREF_TEST_RESET,
+    MQREF_TEST_DETACH,
+    MQREF_TEST_DELETE,
+};
+
+static const char *_test_names[] = {"reset", "detach", "delete"};
+
+static struct rt_mempool _test_mp;
+static struct rt_messagequeue _test_mq;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_mp_pool[MQREF_TEST_BLOCKS * (MQREF_TEST_BLOCK_SIZE + sizeof(rt_uint8_t *))];
+/* room for the header and the block pointer of each message */
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_mq_pool[MQREF_TEST_MSGS * 4 * sizeof(void *)];
+
+static int _test_release(int how)
+{
+    int errors = 0;
+    rt_mq_t mq;
+    void *blocks[MQREF_TEST_SENT + 1];
+    void *block;
+    int index;
+
+    if (how == MQREF_TEST_DELETE)
+    {
+        mq = rt_mq_create_mp("tmqref", MQREF_TEST_MSGS, &_test_mp, RT_IPC_FLAG_FIFO);
+        if (mq == RT_NULL)
+        {
+            rt_kprintf("mqreftest: failed to create the queue\n");
+            return 1;
+        }
+    }
+    else
+    {
+        mq = &_test_mq;
+        rt_mq_init_mp(mq, "tmqref", _test_mq_pool, sizeof(_test_mq_pool),
+                      &_test_mp, RT_IPC_FLAG_FIFO);
+    }
+
+    /* the last one is allocated but not sent */
+    for (index = 0; index < MQREF_TEST_SENT + 1; index ++)
+    {
+        blocks[index] = rt_mq_alloc(mq, RT_WAITING_NO);
+        if (blocks[index] == RT_NULL)
+        {
+            rt_kprintf("mqreftest: %s: failed to allocate block %d\n",
+                       _test_names[how], index);
+            return errors + 1;
+        }
+    }
+    for (index = 0; index < MQREF_TEST_SENT; index ++)
+    {
+        if (rt_mq_send_ref(mq, blocks[index], RT_WAITING_NO) != RT_EOK)
+            errors ++;
+    }
+
+    /* the first one is received, the others are left in the queue */
+    block = RT_NULL;
+    if (rt_mq_recv_ref(mq, &block, RT_WAITING_NO) != RT_EOK || block != blocks[0])
+    {
+        rt_kprintf("mqreftest: %s: received %p, not %p\n", _test_names[how], block, blocks[0]);
+        errors ++;
+    }
+
+    switch (how)
+    {
+    case MQREF_TEST_RESET:
+        rt_mq_control(mq, RT_IPC_CMD_RESET, RT_NULL);
+        break;
+    case MQREF_TEST_DETACH:
+        rt_mq_detach(mq);
+        break;
+    case MQREF_TEST_DELETE:
+        rt_mq_delete(mq);
+        break;
+    }
+
+    /* the received one and the one not sent are still owned by the thread */
+    if (_test_mp.block_free_count != MQREF_TEST_BLOCKS - 2)
+    {
+        rt_kprintf("mqreftest: %s: %d blocks free, not %d\n", _test_names[how],
+                   _test_mp.block_free_count, MQREF_TEST_BLOCKS - 2);
+        errors ++;
+    }
+
+    rt_mp_free(blocks[0]);
+    rt_mp_free(blocks[MQREF_TEST_SENT]);
+    if (how == MQREF_TEST_RESET)
+        rt_mq_detach(mq);
+
+    if (_test_mp.block_free_count != MQREF_TEST_BLOCKS)
+    {
+        rt_kprintf("mqreftest: %s: %d blocks free after freed, not %d\n", _test_names[how],
+                   _test_mp.block_free_count, MQREF_TEST_BLOCKS);
+        errors ++;
+    }
+
+    return errors;
+}
+
+static int mqreftest(void)
+{
+    int errors = 0;
+
+    rt_mp_init(&_test_mp, "tmqref", _test_mp_pool, sizeof(_test_mp_pool), MQREF_TEST_BLOCK_SIZE);
+
+    errors += _test_release(MQREF_TEST_RESET);
+    errors += _test_release(MQREF_TEST_DETACH);
+#ifdef RT_USING_HEAP
+    errors += _test_release(MQREF_TEST_DELETE);
+#endif
+
+    rt_mp_detach(&_test_mp);
+
+    rt_kprintf("mqreftest: %s\n", (errors == 0) ? "passed" : "failed");
+
+    return (errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(mqreftest, test of zero-copy message queue);
+#endif
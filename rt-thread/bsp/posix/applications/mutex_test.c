@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of mutex fast path.
+ *
+ * The finsh command "mutextest" takes a mutex twice and releases it in the
+ * same thread, then a high priority thread blocks on the mutex held by a low
+ * one, which inherits the high priority and gets back its own when it
+ * releases the mutex. At last the low thread holds two mutexes, a high and a
+ * middle priority thread block on them in turn, and the low one is back to
+ * its own priority after both are released. It returns non-zero if it fails.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_MUTEX) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define MUTEX_TEST_LOW          6
+#define MUTEX_TEST_HIGH         5
+#define MUTEX_TEST_MIDDLE       7
+#define MUTEX_TEST_LOWEST       8
+#define MUTEX_TEST_STACK_SIZE   4096
+
+static struct rt_mutex _test_mutex, _test_mutex2;
+static struct rt_semaphore _test_go, _test_done;
+static struct rt_thread _test_low, _test_high, _test_middle;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_low_stack[MUTEX_TEST_STACK_SIZE];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_high_stack[MUTEX_TEST_STACK_SIZE];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_middle_stack[MUTEX_TEST_STACK_SIZE];
+
+static volatile rt_uint8_t _test_released_priority;
+static volatile rt_thread_t _test_high_owner;
+
+static void _test_low_entry(void *parameter)
+{
+    rt_mutex_take(&_test_mutex, RT_WAITING_FOREVER);
+    rt_sem_take(&_test_go, RT_WAITING_FOREVER);
+    rt_mutex_release(&_test_mutex);
+
+    /* the high one has run before it's back */
+    _test_released_priority = rt_thread_self()->current_priority;
+    rt_sem_release(&_test_done);
+}
+
+static void _test_high_entry(void *parameter)
+{
+    rt_mutex_take(&_test_mutex, RT_WAITING_FOREVER);
+    _test_high_owner = _test_mutex.owner;
+    rt_mutex_release(&_test_mutex);
+
+    rt_sem_release(&_test_done);
+}
+
+static void _test_nested_low_entry(void *parameter)
+{
+    rt_mutex_take(&_test_mutex, RT_WAITING_FOREVER);
+    rt_mutex_take(&_test_mutex2, RT_WAITING_FOREVER);
+    rt_sem_take(&_test_go, RT_WAITING_FOREVER);
+    rt_mutex_release(&_test_mutex2);
+    rt_mutex_release(&_test_mutex);
+
+    _test_released_priority = rt_thread_self()->current_priority;
+    rt_sem_release(&_test_done);
+}
+
+static void _test_nested_entry(void *parameter)
+{
+    rt_mutex_t mutex = (rt_mutex_t)parameter;
+
+    rt_mutex_take(mutex, RT_WAITING_FOREVER);
+    rt_mutex_release(mutex);
+
+    rt_sem_release(&_test_done);
+}
+
+static void _test_wait_close(void)
+{
+    /* the thread object is detached when it exits */
+    while ((_test_low.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE ||
+           (_test_high.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+        rt_thread_delay(1);
+}
+
+static int mutextest(void)
+{
+    int errors = 0;
+
+    rt_mutex_init(&_test_mutex, "tmutex", RT_IPC_FLAG_PRIO);
+    rt_mutex_init(&_test_mutex2, "tmutex2", RT_IPC_FLAG_PRIO);
+    rt_sem_init(&_test_go, "tgo", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&_test_done, "tdone", 0, RT_IPC_FLAG_FIFO);
+
+    /* recursive take */
+    if (rt_mutex_take(&_test_mutex, 0) != RT_EOK ||
+        rt_mutex_take(&_test_mutex, 0) != RT_EOK ||
+        _test_mutex.hold != 2)
+    {
+        rt_kprintf("mutextest: recursive take failed\n");
+        errors ++;
+    }
+    if (rt_mutex_release(&_test_mutex) != RT_EOK ||
+        rt_mutex_release(&_test_mutex) != RT_EOK ||
+        rt_mutex_release(&_test_mutex) == RT_EOK ||
+        _test_mutex.owner != RT_NULL)
+    {
+        rt_kprintf("mutextest: recursive release failed\n");
+        errors ++;
+    }
+
+    /* priority inheritance */
+    _test_released_priority = 0;
+    _test_high_owner = RT_NULL;
+    rt_thread_init(&_test_low, "tlow", _test_low_entry, RT_NULL, _test_low_stack,
+                   sizeof(_test_low_stack), MUTEX_TEST_LOW, 10);
+    rt_thread_init(&_test_high, "thigh", _test_high_entry, RT_NULL, _test_high_stack,
+                   sizeof(_test_high_stack), MUTEX_TEST_HIGH, 10);
+    rt_thread_startup(&_test_low);
+    rt_thread_startup(&_test_high);
+
+    if (_test_low.current_priority != MUTEX_TEST_HIGH)
+    {
+        rt_kprintf("mutextest: the owner didn't inherit priority\n");
+        errors ++;
+    }
+
+    rt_sem_release(&_test_go);
+    rt_sem_take(&_test_done, RT_WAITING_FOREVER);
+    rt_sem_take(&_test_done, RT_WAITING_FOREVER);
+
+    if (_test_released_priority != MUTEX_TEST_LOW || _test_high_owner != &_test_high)
+    {
+        rt_kprintf("mutextest: the mutex wasn't passed to the waiter\n");
+        errors ++;
+    }
+    _test_wait_close();
+
+    /* nested priority inheritance, the high one waits on the second mutex */
+    _test_released_priority = 0;
+    rt_thread_init(&_test_low, "tlow", _test_nested_low_entry, RT_NULL, _test_low_stack,
+                   sizeof(_test_low_stack), MUTEX_TEST_LOWEST, 10);
+    rt_thread_init(&_test_high, "thigh", _test_nested_entry, &_test_mutex2, _test_high_stack,
+                   sizeof(_test_high_stack), MUTEX_TEST_HIGH, 10);
+    rt_thread_init(&_test_middle, "tmiddle", _test_nested_entry, &_test_mutex, _test_middle_stack,
+                   sizeof(_test_middle_stack), MUTEX_TEST_MIDDLE, 10);
+    rt_thread_startup(&_test_low);
+    rt_thread_startup(&_test_high);
+    rt_thread_startup(&_test_middle);
+
+    if (_test_low.current_priority != MUTEX_TEST_HIGH)
+    {
+        rt_kprintf("mutextest: the owner didn't inherit priority of nested mutex\n");
+        errors ++;
+    }
+
+    rt_sem_release(&_test_go);
+    rt_sem_take(&_test_done, RT_WAITING_FOREVER);
+    rt_sem_take(&_test_done, RT_WAITING_FOREVER);
+    rt_sem_take(&_test_done, RT_WAITING_FOREVER);
+
+    if (_test_released_priority != MUTEX_TEST_LOWEST)
+    {
+        rt_kprintf("mutextest: the owner is left at priority %d\n", _test_released_priority);
+        errors ++;
+    }
+    rt_kprintf("mutextest: %s\n", (errors == 0) ? "passed" : "failed");
+
+    _test_wait_close();
+    while ((_test_middle.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+        rt_thread_delay(1);
+
+    rt_sem_detach(&_test_done);
+    rt_sem_detach(&_test_go);
+    rt_mutex_detach(&_test_mutex2);
+    rt_mutex_detach(&_test_mutex);
+
+    return (errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(mutextest, test of mutex fast path);
+#endif
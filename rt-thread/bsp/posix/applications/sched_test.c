@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of preemption threshold in an interrupt heavy workload.
+ *
+ * The low thread runs SCHED_TEST_LOOPS short critical sections, and raises a
+ * simulated interrupt in each loop, inside the critical section every other
+ * loop. The interrupt wakes the mid thread up, which is one priority higher.
+ *
+ * The finsh command "schedtest" runs it without threshold, where the mid
+ * thread preempts on each interrupt, and again with the threshold of low
+ * thread set to the priority of mid thread, where the mid thread runs after
+ * the low one finishes. It prints the preemptions and the time of the low
+ * thread, and returns non-zero if the threshold doesn't hold off the mid
+ * thread.
+ */
+
+#include <time.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "cpuport.h"
+
+#if defined(RT_USING_PREEMPT_THRESHOLD) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define SCHED_TEST_LOOPS        10000
+#define SCHED_TEST_IRQ          1
+#define SCHED_TEST_PRIORITY     12
+#define SCHED_TEST_STACK_SIZE   4096
+
+static struct rt_thread _test_low, _test_mid;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_low_stack[SCHED_TEST_STACK_SIZE];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_mid_stack[SCHED_TEST_STACK_SIZE];
+
+static struct rt_semaphore _test_irq_sem, _test_done;
+static volatile rt_uint8_t _test_threshold;
+static volatile int _test_low_busy;
+static volatile rt_uint32_t _test_preempts;
+static volatile rt_uint32_t _test_time_us;
+
+static rt_uint32_t _test_clock_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (rt_uint32_t)(now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+static void _test_isr(int vector, void *param)
+{
+    rt_sem_release(&_test_irq_sem);
+}
+
+static void _test_low_entry(void *parameter)
+{
+    int loop;
+    rt_uint8_t threshold;
+    rt_uint32_t start;
+    volatile int work;
+
+    threshold = _test_threshold;
+    rt_thread_control(rt_thread_self(), RT_THREAD_CTRL_PREEMPT_THRESHOLD, &threshold);
+
+    start = _test_clock_us();
+    _test_low_busy = 1;
+    for (loop = 0; loop < SCHED_TEST_LOOPS; loop ++)
+    {
+        rt_enter_critical();
+        for (work = 0; work < 16; work ++);
+        if (loop & 1)
+            rt_hw_interrupt_raise(SCHED_TEST_IRQ);
+        rt_exit_critical();
+
+        if ((loop & 1) == 0)
+            rt_hw_interrupt_raise(SCHED_TEST_IRQ);
+    }
+    _test_low_busy = 0;
+    _test_time_us = _test_clock_us() - start;
+
+    rt_sem_release(&_test_done);
+}
+
+static void _test_mid_entry(void *parameter)
+{
+    int loop;
+
+    for (loop = 0; loop < SCHED_TEST_LOOPS; loop ++)
+    {
+        rt_sem_take(&_test_irq_sem, RT_WAITING_FOREVER);
+        if (_test_low_busy)
+            _test_preempts ++;
+    }
+
+    rt_sem_release(&_test_done);
+}
+
+static void _test_run(rt_uint8_t threshold)
+{
+    _test_threshold = threshold;
+    _test_preempts  = 0;
+
+    rt_thread_init(&_test_low, "tlow", _test_low_entry, RT_NULL,
+                   _test_low_stack, sizeof(_test_low_stack), SCHED_TEST_PRIORITY, 10);
+    rt_thread_init(&_test_mid, "tmid", _test_mid_entry, RT_NULL,
+                   _test_mid_stack, sizeof(_test_mid_stack), SCHED_TEST_PRIORITY - 1, 10);
+    rt_thread_startup(&_test_mid);
+    rt_thread_startup(&_test_low);
+
+    rt_sem_take(&_test_done, RT_WAITING_FOREVER);
+    rt_sem_take(&_test_done, RT_WAITING_FOREVER);
+
+    /* the thread object is detached when it exits, then it can be initialized again */
+    while ((_test_low.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE ||
+           (_test_mid.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+        rt_thread_delay(1);
+}
+
+static int schedtest(void)
+{
+    int errors = 0;
+
+    rt_sem_init(&_test_irq_sem, "tirq", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&_test_done, "tdone", 0, RT_IPC_FLAG_FIFO);
+    rt_hw_interrupt_install(SCHED_TEST_IRQ, _test_isr, RT_NULL, "schedtest");
+    rt_hw_interrupt_umask(SCHED_TEST_IRQ);
+
+    _test_run(RT_THREAD_PRIORITY_MAX - 1);
+    rt_kprintf("schedtest: no threshold, %d interrupts, %d preemptions, %d us\n",
+               SCHED_TEST_LOOPS, _test_preempts, _test_time_us);
+    if (_test_preempts != SCHED_TEST_LOOPS)
+        errors ++;
+
+    _test_run(SCHED_TEST_PRIORITY - 1);
+    rt_kprintf("schedtest: threshold %d, %d interrupts, %d preemptions, %d us\n",
+               SCHED_TEST_PRIORITY - 1, SCHED_TEST_LOOPS, _test_preempts, _test_time_us);
+    if (_test_preempts != 0)
+        errors ++;
+
+    rt_hw_interrupt_mask(SCHED_TEST_IRQ);
+    rt_hw_interrupt_install(SCHED_TEST_IRQ, RT_NULL, RT_NULL, "schedtest");
+    rt_sem_detach(&_test_done);
+    rt_sem_detach(&_test_irq_sem);
+
+    return (errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(schedtest, test of preemption threshold);
+#endif
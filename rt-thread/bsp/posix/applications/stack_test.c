@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of stack watermark.
+ *
+ * The threads run on host stacks in simulator, so the stack of thread object
+ * is never touched by them. The test thread is initialized but not started,
+ * and a known depth of its stack is written as the frames of a thread would
+ * be, the same on any target.
+ *
+ * The finsh command "stacktest" checks that rt_thread_stack_usage() finds the
+ * depth, and that the idle thread finds a deeper one with the scan in
+ * background. It returns non-zero if it fails.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_STACK_WATERMARK) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define STACK_TEST_SIZE         1024
+#define STACK_TEST_DEPTH        200
+#define STACK_TEST_DEEPER       600
+/* the idle thread scans RT_STACK_SCAN_WORDS words of one thread in a loop */
+#define STACK_TEST_TIMEOUT      (RT_TICK_PER_SECOND * 2)
+
+static struct rt_thread _test_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_stack[STACK_TEST_SIZE];
+
+static void _test_entry(void *parameter)
+{
+}
+
+/* write the depth of stack from the end it starts */
+static void _test_use(rt_uint32_t depth)
+{
+#ifdef ARCH_CPU_STACK_GROWS_UPWARD
+    rt_memset(_test_stack, 0, depth);
+#else
+    rt_memset(_test_stack + STACK_TEST_SIZE - depth, 0, depth);
+#endif
+}
+
+static int stacktest(void)
+{
+    int errors = 0;
+    rt_uint32_t peak;
+    rt_tick_t start;
+
+    rt_thread_init(&_test_thread, "tstack", _test_entry, RT_NULL, _test_stack,
+                   sizeof(_test_stack), RT_THREAD_PRIORITY_MAX - 2, 10);
+
+    /* the frame put by rt_hw_stack_init() is within the depth */
+    _test_use(STACK_TEST_DEPTH);
+    peak = rt_thread_stack_usage(&_test_thread);
+    if (peak != STACK_TEST_DEPTH)
+    {
+        rt_kprintf("stacktest: the usage is %d, not %d\n", peak, STACK_TEST_DEPTH);
+        errors ++;
+    }
+
+    /* the idle thread finds it deeper */
+    _test_use(STACK_TEST_DEEPER);
+    start = rt_tick_get();
+    while (_test_thread.stack_peak != STACK_TEST_DEEPER &&
+           rt_tick_get() - start < STACK_TEST_TIMEOUT)
+    {
+        rt_thread_delay(1);
+    }
+    if (_test_thread.stack_peak != STACK_TEST_DEEPER)
+    {
+        rt_kprintf("stacktest: the idle thread found %d, not %d\n",
+                   _test_thread.stack_peak, STACK_TEST_DEEPER);
+        errors ++;
+    }
+    rt_kprintf("stacktest: %s, peak %d of %d bytes\n", (errors == 0) ? "passed" : "failed",
+               _test_thread.stack_peak, STACK_TEST_SIZE);
+
+    rt_thread_detach(&_test_thread);
+
+    return (errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(stacktest, test of stack watermark);
+#endif
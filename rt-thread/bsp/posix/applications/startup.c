@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ * 2026-10-17     weizx208     initialize system workqueue
+ * 2026-10-17     weizx208     initialize deferred console log
+ */
+
+/*
+ * The entry of host simulator.
+ *
+ * usage: rtthread-posix [command ...]
+ *
+ * Without argument, the finsh shell reads the commands from stdin. Otherwise
+ * each argument is run as a finsh command after the components are
+ * initialized, and the process exits with 1 if any command returns non-zero.
+ */
+
+#include <stdlib.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_FINSH
+#include <msh.h>
+#include <shell.h>
+#endif
+
+#define INIT_THREAD_STACK_SIZE  2048
+#define INIT_THREAD_PRIORITY    10
+
+void rt_hw_board_init(void);
+
+static int _argc;
+static char **_argv;
+
+static void _init_thread_entry(void *parameter)
+{
+    int index, result;
+
+#ifdef RT_USING_COMPONENTS_INIT
+    /* RT-Thread components initialization */
+    rt_components_init();
+#endif
+
+    if (_argc == 0)
+        return;
+
+    result = 0;
+#ifdef RT_USING_FINSH
+    /* the shell is started, but it's quiet */
+    finsh_set_prompt_mode(0);
+    for (index = 0; index < _argc; index ++)
+    {
+        rt_kprintf("%s\n", _argv[index]);
+        if (msh_exec(_argv[index], rt_strlen(_argv[index])) != 0)
+            result = 1;
+    }
+#else
+    rt_kprintf("no finsh to run the commands\n");
+    result = 1;
+#endif
+
+#if defined(RT_USING_KLOG) && defined(RT_USING_CONSOLE)
+    /* the log thread will not run again */
+    rt_klog_flush();
+#endif
+
+    exit(result);
+}
+
+static void rt_application_init(void)
+{
+    rt_thread_t tid;
+
+    tid = rt_thread_create("init", _init_thread_entry, RT_NULL,
+                           INIT_THREAD_STACK_SIZE, INIT_THREAD_PRIORITY, 20);
+    RT_ASSERT(tid != RT_NULL);
+
+    rt_thread_startup(tid);
+}
+
+static void rtthread_startup(void)
+{
+    rt_hw_interrupt_disable();
+
+    /* board level initialization */
+    rt_hw_board_init();
+
+    /* show RT-Thread version */
+    rt_show_version();
+
+    /* timer system initialization */
+    rt_system_timer_init();
+
+    /* scheduler system initialization */
+    rt_system_scheduler_init();
+
+    /* create init_thread */
+    rt_application_init();
+
+    /* timer thread initialization */
+    rt_system_timer_thread_init();
+
+#ifdef RT_USING_WORKQUEUE
+    /* system workqueue initialization */
+    rt_system_workqueue_init();
+#endif
+
+#if defined(RT_USING_KLOG) && defined(RT_USING_CONSOLE)
+    /* deferred console log thread initialization */
+    rt_klog_init();
+#endif
+
+    /* idle thread initialization */
+    rt_thread_idle_init();
+
+    /* start scheduler */
+    rt_system_scheduler_start();
+}
+
+int main(int argc, char **argv)
+{
+    _argc = argc - 1;
+    _argv = argv + 1;
+
+    rtthread_startup();
+
+    /* never reach here */
+    return 0;
+}
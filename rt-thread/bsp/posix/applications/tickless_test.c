@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ * 2026-10-17     weizx208     test a thread ready at idle priority
+ */
+
+/*
+ * Test of tickless idle.
+ *
+ * The BSP stops the interval timer of host in idle until the next timer
+ * expires, and re-arms it on wake up. The finsh command "ticklesstest" delays
+ * TICKLESS_TEST_TICKS, where the other threads wait for their timers, and
+ * checks that:
+ *
+ *   - the idle thread entered tickless sleep, and skipped most of the ticks
+ *   - the system tick still follows the clock of host, the skipped ticks are
+ *     added to it
+ *   - the idle thread never sleeps while another thread of idle priority is
+ *     ready
+ *
+ * It returns non-zero if it fails.
+ */
+
+#include <time.h>
+
+#include <rtthread.h>
+
+#if defined(RT_USING_TICKLESS) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define TICKLESS_TEST_TICKS     200
+#define TICKLESS_TEST_BUSY      50
+#define TICKLESS_TEST_STACK     4096
+
+static struct rt_thread _test_busy;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _test_busy_stack[TICKLESS_TEST_STACK];
+static volatile int _test_busy_stop;
+
+static rt_uint32_t _test_clock_ms(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (rt_uint32_t)(now.tv_sec * 1000 + now.tv_nsec / 1000000);
+}
+
+/* it's always ready, and shares the time slices with the idle thread */
+static void _test_busy_entry(void *parameter)
+{
+    while (!_test_busy_stop);
+}
+
+static int _test_busy_idle(void)
+{
+    rt_uint32_t count_first, count_last;
+
+    _test_busy_stop = 0;
+    rt_thread_init(&_test_busy, "tbusy", _test_busy_entry, RT_NULL, _test_busy_stack,
+                   sizeof(_test_busy_stack), RT_THREAD_PRIORITY_MAX - 1, 5);
+    rt_thread_startup(&_test_busy);
+
+    rt_tickless_info(&count_first, RT_NULL);
+    rt_thread_delay(TICKLESS_TEST_BUSY);
+    rt_tickless_info(&count_last, RT_NULL);
+
+    /* the thread object is detached when it exits */
+    _test_busy_stop = 1;
+    while ((_test_busy.stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+        rt_thread_delay(1);
+
+    if (count_last != count_first)
+    {
+        rt_kprintf("ticklesstest: %d sleeps with a thread of idle priority ready\n",
+                   count_last - count_first);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+static int ticklesstest(void)
+{
+    int errors = 0;
+    rt_uint32_t count_first, count_last;
+    rt_tick_t skipped_first, skipped_last;
+    rt_tick_t tick_first, tick_last;
+    rt_uint32_t ms_first, ms_last;
+    rt_int32_t drift;
+
+    rt_tickless_info(&count_first, &skipped_first);
+    tick_first = rt_tick_get();
+    ms_first   = _test_clock_ms();
+
+    rt_thread_delay(TICKLESS_TEST_TICKS);
+
+    rt_tickless_info(&count_last, &skipped_last);
+    tick_last = rt_tick_get();
+    ms_last   = _test_clock_ms();
+
+    rt_kprintf("ticklesstest: %d sleeps, %d of %d ticks skipped\n", count_last - count_first,
+               skipped_last - skipped_first, tick_last - tick_first);
+    if (count_last == count_first || skipped_last - skipped_first < TICKLESS_TEST_TICKS / 2)
+    {
+        rt_kprintf("ticklesstest: the ticks are not skipped\n");
+        errors ++;
+    }
+
+    /* in ticks, a few ticks late as the host schedules the simulator */
+    drift = (rt_int32_t)((ms_last - ms_first) * RT_TICK_PER_SECOND / 1000) -
+            (rt_int32_t)(tick_last - tick_first);
+    if (drift < -1 || drift > TICKLESS_TEST_TICKS / 20)
+    {
+        rt_kprintf("ticklesstest: the tick drifts %d from host clock\n", drift);
+        errors ++;
+    }
+
+    errors += _test_busy_idle();
+
+    rt_kprintf("ticklesstest: %s\n", (errors == 0) ? "passed" : "failed");
+
+    return (errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(ticklesstest, test of tickless idle);
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of timer expiration, with the timer list or the timing wheel.
+ *
+ * The finsh command "timertest" checks that:
+ *
+ *   - the timers of timeouts on both sides of the levels of timing wheel
+ *     expire on their timeout tick, a late wake up of the host is allowed
+ *   - a timer started after the tick is set backward by rt_tick_set() expires
+ *     on the check of its timeout tick
+ *
+ * It returns non-zero if it fails.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+/* the ticks late allowed, as the host schedules the simulator */
+#define TIMER_TEST_LATE         2
+
+static const rt_tick_t _test_timeouts[] = {1, 5, 63, 64, 65, 300, 4095, 4097};
+#define TIMER_TEST_COUNT        (sizeof(_test_timeouts) / sizeof(_test_timeouts[0]))
+
+static struct rt_timer _test_timers[TIMER_TEST_COUNT];
+static volatile rt_tick_t _test_fired[TIMER_TEST_COUNT];
+static volatile int _test_count;
+
+static void _test_timeout(void *parameter)
+{
+    _test_fired[(rt_ubase_t)parameter] = rt_tick_get();
+    _test_count ++;
+}
+
+static int _test_expire(void)
+{
+    int errors = 0;
+    rt_ubase_t index;
+    rt_tick_t start, expected;
+
+    _test_count = 0;
+    rt_enter_critical();
+    start = rt_tick_get();
+    for (index = 0; index < TIMER_TEST_COUNT; index ++)
+    {
+        rt_timer_init(&_test_timers[index], "ttimer", _test_timeout, (void *)index,
+                      _test_timeouts[index], RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+        rt_timer_start(&_test_timers[index]);
+    }
+    rt_exit_critical();
+
+    rt_thread_delay(_test_timeouts[TIMER_TEST_COUNT - 1] + TIMER_TEST_LATE * 2);
+
+    for (index = 0; index < TIMER_TEST_COUNT; index ++)
+    {
+        rt_timer_detach(&_test_timers[index]);
+
+        expected = start + _test_timeouts[index];
+        if (_test_fired[index] - expected > TIMER_TEST_LATE)
+        {
+            rt_kprintf("timertest: the timeout %d expired at %d, not %d\n",
+                       _test_timeouts[index], _test_fired[index] - start, _test_timeouts[index]);
+            errors ++;
+        }
+    }
+    if (_test_count != TIMER_TEST_COUNT)
+    {
+        rt_kprintf("timertest: %d of %d timers expired\n", _test_count, TIMER_TEST_COUNT);
+        errors ++;
+    }
+
+    return errors;
+}
+
+static int _test_tick_backward(void)
+{
+    int errors = 0;
+    rt_base_t level;
+    rt_tick_t tick;
+
+    _test_count = 0;
+    rt_timer_init(&_test_timers[0], "ttimer", _test_timeout, (void *)0, 1,
+                  RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+
+    /* no tick interrupt between, the scheduler is locked as it's not in interrupt */
+    rt_enter_critical();
+    level = rt_hw_interrupt_disable();
+    tick = rt_tick_get();
+    rt_tick_set(tick + 1);
+    rt_timer_check();
+    rt_tick_set(tick);
+
+    rt_timer_start(&_test_timers[0]);
+    rt_tick_set(tick + 1);
+    rt_timer_check();
+    rt_hw_interrupt_enable(level);
+    rt_exit_critical();
+
+    if (_test_count != 1)
+    {
+        rt_kprintf("timertest: the timer did not expire after the tick set backward\n");
+        errors ++;
+    }
+    rt_timer_detach(&_test_timers[0]);
+
+    return errors;
+}
+
+static int timertest(void)
+{
+    int errors = 0;
+
+    errors += _test_expire();
+    errors += _test_tick_backward();
+
+    rt_kprintf("timertest: %s\n", (errors == 0) ? "passed" : "failed");
+
+    return (errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(timertest, test of timer expiration);
+#endif
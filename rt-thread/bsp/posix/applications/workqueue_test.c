@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Test of system workqueue.
+ *
+ * The finsh command "wqtest" submits a work from a timer, which runs in the
+ * context of tick interrupt, a delayed work and a delayed work cancelled
+ * before it's due. It checks that each work runs in the workqueue thread the
+ * expected times, and detaches the works at last. It returns non-zero if it
+ * fails.
+ */
+
+#include <rtthread.h>
+
+#if defined(RT_USING_WORKQUEUE) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+#define WQ_TEST_DELAY           20
+
+static struct rt_work _test_isr_work;
+static struct rt_work _test_delayed_work;
+static struct rt_work _test_cancelled_work;
+static struct rt_timer _test_timer;
+
+static volatile int _test_runs[3];
+static volatile rt_tick_t _test_delayed_tick;
+static volatile int _test_errors;
+
+static void _test_work(struct rt_work *work, void *work_data)
+{
+    int index = (int)(rt_ubase_t)work_data;
+
+    if (rt_interrupt_get_nest() != 0)
+        _test_errors ++;
+    if (work == &_test_delayed_work)
+        _test_delayed_tick = rt_tick_get();
+
+    _test_runs[index] ++;
+}
+
+static void _test_timeout(void *parameter)
+{
+    /* the second one fails as it's pending already */
+    if (rt_work_submit(&_test_isr_work, 0) != RT_EOK)
+        _test_errors ++;
+    if (rt_work_submit(&_test_isr_work, 0) != -RT_EBUSY)
+        _test_errors ++;
+}
+
+static int wqtest(void)
+{
+    int index;
+    rt_tick_t start;
+
+    _test_errors = 0;
+    for (index = 0; index < 3; index ++)
+        _test_runs[index] = 0;
+
+    rt_work_init(&_test_isr_work, _test_work, (void *)0);
+    rt_work_init(&_test_delayed_work, _test_work, (void *)1);
+    rt_work_init(&_test_cancelled_work, _test_work, (void *)2);
+    rt_timer_init(&_test_timer, "wqtest", _test_timeout, RT_NULL, 1,
+                  RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+
+    start = rt_tick_get();
+    rt_work_submit(&_test_delayed_work, WQ_TEST_DELAY);
+    rt_work_submit(&_test_cancelled_work, WQ_TEST_DELAY);
+    rt_timer_start(&_test_timer);
+
+    rt_thread_delay(WQ_TEST_DELAY / 2);
+    if (rt_work_cancel(&_test_cancelled_work) != RT_EOK)
+        _test_errors ++;
+
+    rt_thread_delay(WQ_TEST_DELAY * 2);
+    rt_timer_detach(&_test_timer);
+
+    /* the works can be initialized again in the next test */
+    if (rt_work_detach(&_test_isr_work) != RT_EOK ||
+        rt_work_detach(&_test_delayed_work) != RT_EOK ||
+        rt_work_detach(&_test_cancelled_work) != RT_EOK)
+        _test_errors ++;
+
+    rt_kprintf("wqtest: runs %d %d %d, delayed %d ticks\n", _test_runs[0],
+               _test_runs[1], _test_runs[2], _test_delayed_tick - start);
+
+    if (_test_runs[0] != 1 || _test_runs[1] != 1 || _test_runs[2] != 0)
+        _test_errors ++;
+    if (_test_delayed_tick - start < WQ_TEST_DELAY)
+    {
+        rt_kprintf("wqtest: the delayed work ran early\n");
+        _test_errors ++;
+    }
+
+    return (_test_errors == 0) ? 0 : -1;
+}
+MSH_CMD_EXPORT(wqtest, test of system workqueue);
+#endif
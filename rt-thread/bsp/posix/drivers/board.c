@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ * 2026-10-17     weizx208     add tickless idle
+ */
+
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "cpuport.h"
+
+/* the simulated interrupt vectors */
+#define IRQ_TICK        0
+
+#define TICK_PERIOD_US  (1000000 / RT_TICK_PER_SECOND)
+
+static rt_uint8_t rt_heap[RT_HEAP_SIZE_KB * 1024];
+
+static struct termios _console_termios;
+static int _console_raw = 0;
+
+static void _tick_isr(int vector, void *param)
+{
+    rt_tick_increase();
+}
+
+static void _tick_signal(int signo)
+{
+    int error = errno;
+
+    rt_hw_interrupt_raise(IRQ_TICK);
+
+    errno = error;
+}
+
+/* the interval timer expires after value_us, and then each tick */
+static void _tick_timer_set(rt_uint32_t value_us)
+{
+    struct itimerval timer;
+
+    /* zero disarms the timer */
+    if (value_us == 0)
+        value_us = 1;
+
+    timer.it_interval.tv_sec  = 0;
+    timer.it_interval.tv_usec = TICK_PERIOD_US;
+    timer.it_value.tv_sec     = value_us / 1000000;
+    timer.it_value.tv_usec    = value_us % 1000000;
+    setitimer(ITIMER_REAL, &timer, RT_NULL);
+}
+
+static void _tick_init(void)
+{
+    struct sigaction action;
+
+    rt_hw_interrupt_install(IRQ_TICK, _tick_isr, RT_NULL, "tick");
+    rt_hw_interrupt_umask(IRQ_TICK);
+
+    rt_memset(&action, 0, sizeof(action));
+    action.sa_handler = _tick_signal;
+    action.sa_flags   = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGALRM, &action, RT_NULL);
+
+    _tick_timer_set(TICK_PERIOD_US);
+}
+
+/* the monotonic clock of host in nanoseconds */
+static rt_uint32_t _clock_get(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (rt_uint32_t)(now.tv_sec * 1000000000UL + now.tv_nsec);
+}
+
+#ifdef RT_USING_TICKLESS
+/* the longest tickless sleep, the timer is checked at least once a minute */
+#define TICKLESS_MAX_TICK   (RT_TICK_PER_SECOND * 60)
+
+static rt_uint64_t _tickless_deadline;  /* the host time in us the sleep ends */
+static rt_tick_t   _tickless_timeout;   /* the ticks of tickless sleep */
+
+/* the monotonic clock of host in microseconds */
+static rt_uint64_t _clock_get_us(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (rt_uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+static void _tickless_timer_start(rt_tick_t timeout)
+{
+    struct itimerval timer;
+    rt_uint32_t rest;
+
+    if (timeout > TICKLESS_MAX_TICK)
+        timeout = TICKLESS_MAX_TICK;
+
+    /* the rest of current tick is counted in the sleep */
+    getitimer(ITIMER_REAL, &timer);
+    rest = timer.it_value.tv_sec * 1000000 + timer.it_value.tv_usec;
+
+    _tickless_timeout  = timeout;
+    _tickless_deadline = _clock_get_us() + rest + (rt_uint64_t)(timeout - 1) * TICK_PERIOD_US;
+    _tick_timer_set(rest + (timeout - 1) * TICK_PERIOD_US);
+}
+
+static rt_tick_t _tickless_timer_stop(void)
+{
+    rt_uint64_t now;
+    rt_uint32_t left;
+
+    now = _clock_get_us();
+    if (now >= _tickless_deadline)
+    {
+        /* the timer has expired and goes on each tick, the pending interrupt
+         * counts the tick at the deadline */
+        return _tickless_timeout - 1 + (rt_tick_t)((now - _tickless_deadline) / TICK_PERIOD_US);
+    }
+
+    /* woken up by other signal, count the whole ticks passed, and then
+     * restore the periodic tick at the next tick boundary */
+    left = (rt_uint32_t)((_tickless_deadline - now + TICK_PERIOD_US - 1) / TICK_PERIOD_US);
+    _tick_timer_set((rt_uint32_t)(_tickless_deadline - now) - (left - 1) * TICK_PERIOD_US);
+
+    return _tickless_timeout - left;
+}
+
+/* sleep in host until a signal, the interrupt raised is pending */
+static void _tickless_sleep(void)
+{
+    pause();
+}
+
+static const struct rt_tickless_ops _tickless_ops =
+{
+    _tickless_timer_start,
+    _tickless_timer_stop,
+    _tickless_sleep,
+};
+#elif defined(RT_USING_IDLE_HOOK)
+/* sleep in host until the next interrupt */
+static void _idle_sleep(void)
+{
+    pause();
+}
+#endif
+
+static void _console_restore(void)
+{
+    if (_console_raw)
+        tcsetattr(STDIN_FILENO, TCSANOW, &_console_termios);
+}
+
+static void _console_init(void)
+{
+    struct termios termios;
+
+    /* the shell echoes the input, read it without line buffer and echo */
+    if (isatty(STDIN_FILENO) && tcgetattr(STDIN_FILENO, &_console_termios) == 0)
+    {
+        termios = _console_termios;
+        termios.c_lflag &= ~(ICANON | ECHO);
+        termios.c_cc[VMIN]  = 1;
+        termios.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &termios);
+
+        _console_raw = 1;
+        atexit(_console_restore);
+    }
+}
+
+/**
+ * This function will initial the host simulator.
+ */
+void rt_hw_board_init(void)
+{
+    rt_hw_interrupt_init();
+
+    _console_init();
+    _tick_init();
+
+    rt_timestamp_set(_clock_get, 1000000000UL);
+
+#ifdef RT_USING_TICKLESS
+    rt_tickless_register(&_tickless_ops);
+#elif defined(RT_USING_IDLE_HOOK)
+    rt_thread_idle_sethook(_idle_sleep);
+#endif
+
+    /* Call components board initial (use INIT_BOARD_EXPORT()) */
+#ifdef RT_USING_COMPONENTS_INIT
+    rt_components_board_init();
+#endif
+
+#ifdef RT_USING_HEAP
+    rt_system_heap_init(rt_heap, rt_heap + sizeof(rt_heap));
+#endif
+}
+
+#ifdef RT_USING_CONSOLE
+void rt_hw_console_output(const char *str)
+{
+    /* write(2) is safe to be interrupted, stdio is not */
+    if (write(STDOUT_FILENO, str, rt_strlen(str)) < 0)
+        return;
+}
+#endif
+
+#ifdef RT_USING_FINSH
+char rt_hw_console_getchar(void)
+{
+    /* Note: the initial value of ch must < 0 */
+    int ch = -1;
+    char c;
+    struct pollfd fds;
+
+    fds.fd      = STDIN_FILENO;
+    fds.events  = POLLIN;
+    fds.revents = 0;
+    if (poll(&fds, 1, 0) > 0 && read(STDIN_FILENO, &c, 1) == 1)
+    {
+        ch = c;
+    }
+    else
+    {
+        rt_thread_mdelay(10);
+    }
+    return ch;
+}
+#endif
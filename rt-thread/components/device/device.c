@@ -12,9 +12,11 @@
  * 2012-12-25     Bernard      return RT_EOK if the device interface not exist.
  * 2013-07-09     Grissiom     add ref_count support
  * 2016-04-02     Bernard      fix the open_flag initialization issue.
+ * 2026-10-17     weizx208     add scatter-gather and asynchronous request.
  */
 
 #include <rtthread.h>
+#include <rthw.h>
 #if defined(RT_USING_POSIX)
 #include <rtdevice.h> /* for wqueue_init */
 #endif
@@ -28,6 +30,9 @@
 #define device_read     (dev->ops->read)
 #define device_write    (dev->ops->write)
 #define device_control  (dev->ops->control)
+#define device_read_v   (dev->ops->read_v)
+#define device_write_v  (dev->ops->write_v)
+#define device_submit   (dev->ops->submit)
 #else
 #define device_init     (dev->init)
 #define device_open     (dev->open)
@@ -35,6 +40,13 @@
 #define device_read     (dev->read)
 #define device_write    (dev->write)
 #define device_control  (dev->control)
+#define device_read_v   (dev->read_v)
+#define device_write_v  (dev->write_v)
+#define device_submit   (dev->submit)
+#endif
+
+#if defined(RT_USING_DEVICE_ASYNC) && !defined(RT_DEVICE_QUEUE_DEPTH)
+#define RT_DEVICE_QUEUE_DEPTH   4
 #endif
 
 /**
@@ -61,6 +73,12 @@ rt_err_t rt_device_register(rt_device_t dev,
     dev->ref_count = 0;
     dev->open_flag = 0;
 
+#ifdef RT_USING_DEVICE_ASYNC
+    rt_list_init(&(dev->request_list));
+    dev->request_count = 0;
+    dev->request_depth = RT_DEVICE_QUEUE_DEPTH;
+#endif
+
 #if defined(RT_USING_POSIX)
     dev->fops = RT_NULL;
     rt_wqueue_init(&(dev->wait_queue));
@@ -264,10 +282,20 @@ rt_err_t rt_device_open(rt_device_t dev, rt_uint16_t oflag)
  * @param dev the pointer of device driver structure
  *
  * @return the result
+ *
+ * @note when the device is closed at last, the asynchronous requests which
+ *       are not passed to the driver yet are finished with -RT_EINTR, and the
+ *       driver shall finish the one in transfer in its close interface.
  */
 rt_err_t rt_device_close(rt_device_t dev)
 {
     rt_err_t result = RT_EOK;
+#ifdef RT_USING_DEVICE_ASYNC
+    rt_base_t level;
+    rt_list_t *node;
+    rt_list_t cancelled;
+    struct rt_device_request *req;
+#endif
 
     RT_ASSERT(dev != RT_NULL);
     RT_ASSERT(rt_object_get_type(&dev->parent) == RT_Object_Class_Device);
@@ -280,12 +308,46 @@ rt_err_t rt_device_close(rt_device_t dev)
     if (dev->ref_count != 0)
         return RT_EOK;
 
+#ifdef RT_USING_DEVICE_ASYNC
+    /* take the queued requests behind the one in transfer, then no one is
+     * started when the driver finishes it */
+    rt_list_init(&cancelled);
+    level = rt_hw_interrupt_disable();
+    if (!rt_list_isempty(&(dev->request_list)))
+    {
+        while ((node = dev->request_list.next->next) != &(dev->request_list))
+        {
+            rt_list_remove(node);
+            rt_list_insert_before(&cancelled, node);
+            dev->request_count --;
+        }
+    }
+    rt_hw_interrupt_enable(level);
+#endif
+
     /* call device_close interface */
     if (device_close != RT_NULL)
     {
         result = device_close(dev);
     }
 
+#ifdef RT_USING_DEVICE_ASYNC
+    /* the driver shall finish the request in transfer when it's closed */
+    RT_ASSERT(rt_list_isempty(&(dev->request_list)));
+
+    /* finish the requests taken out of queue in order */
+    while (!rt_list_isempty(&cancelled))
+    {
+        req = rt_list_entry(cancelled.next, struct rt_device_request, list);
+        rt_list_remove(&(req->list));
+
+        req->result = 0;
+        req->error  = -RT_EINTR;
+        if (req->done != RT_NULL)
+            req->done(dev, req);
+    }
+#endif
+
     /* set open flag */
     if (result == RT_EOK || result == -RT_ENOSYS)
         dev->open_flag = RT_DEVICE_OFLAG_CLOSE;
@@ -392,6 +454,250 @@ rt_err_t rt_device_control(rt_device_t dev, int cmd, void *arg)
     return -RT_ENOSYS;
 }
 
+#ifdef RT_USING_DEVICE_ASYNC
+/* transfer the I/O vectors, the drivers without scatter-gather interface
+ * transfer one vector each time */
+static rt_size_t _device_transfer_v(rt_device_t dev,
+                                    int         cmd,
+                                    rt_off_t    pos,
+                                    const struct rt_iovec *iov,
+                                    int         iovcnt)
+{
+    int index;
+    rt_size_t size, total;
+
+    if (cmd == RT_DEVICE_REQ_READ && device_read_v != RT_NULL)
+        return device_read_v(dev, pos, iov, iovcnt);
+    if (cmd == RT_DEVICE_REQ_WRITE && device_write_v != RT_NULL)
+        return device_write_v(dev, pos, iov, iovcnt);
+
+    if ((cmd == RT_DEVICE_REQ_READ && device_read == RT_NULL) ||
+        (cmd == RT_DEVICE_REQ_WRITE && device_write == RT_NULL))
+    {
+        rt_set_errno(-RT_ENOSYS);
+        return 0;
+    }
+
+    total = 0;
+    for (index = 0; index < iovcnt; index ++)
+    {
+        if (cmd == RT_DEVICE_REQ_READ)
+            size = device_read(dev, pos, iov[index].base, iov[index].size);
+        else
+            size = device_write(dev, pos, iov[index].base, iov[index].size);
+
+        total += size;
+        pos   += size;
+
+        /* stop at the short transfer */
+        if (size < iov[index].size)
+            break;
+    }
+
+    return total;
+}
+
+/* remove the finished request from queue and invoke its callback, it returns
+ * the next request to be started */
+static struct rt_device_request *_device_request_finish(rt_device_t dev,
+                                                        struct rt_device_request *req)
+{
+    rt_base_t level;
+    struct rt_device_request *next = RT_NULL;
+
+    level = rt_hw_interrupt_disable();
+
+    /* the driver handles the requests in order */
+    RT_ASSERT(dev->request_list.next == &(req->list));
+
+    rt_list_remove(&(req->list));
+    dev->request_count --;
+    if (!rt_list_isempty(&(dev->request_list)))
+        next = rt_list_entry(dev->request_list.next, struct rt_device_request, list);
+
+    rt_hw_interrupt_enable(level);
+
+    if (req->done != RT_NULL)
+        req->done(dev, req);
+
+    return next;
+}
+
+/* pass the request at the head of queue to driver */
+static void _device_request_start(rt_device_t dev, struct rt_device_request *req)
+{
+    rt_err_t result;
+
+    while (req != RT_NULL)
+    {
+        result = device_submit(dev, req);
+        if (result == RT_EOK)
+            break;
+
+        /* the driver refuses it, finish it with the error */
+        req->error = result;
+        req = _device_request_finish(dev, req);
+    }
+}
+
+/**
+ * This function will read data from a device into several buffers.
+ *
+ * @param dev the pointer of device driver structure
+ * @param pos the position of reading
+ * @param iov the I/O vectors, which are filled in order
+ * @param iovcnt the number of I/O vectors
+ *
+ * @return the actually read size in total.
+ *
+ * @note the driver without read_v interface is invoked once for each vector,
+ *       and it stops at the first short read.
+ */
+rt_size_t rt_device_read_v(rt_device_t dev,
+                           rt_off_t    pos,
+                           const struct rt_iovec *iov,
+                           int         iovcnt)
+{
+    RT_ASSERT(dev != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&dev->parent) == RT_Object_Class_Device);
+    RT_ASSERT(iov != RT_NULL || iovcnt == 0);
+
+    if (dev->ref_count == 0)
+    {
+        rt_set_errno(-RT_ERROR);
+        return 0;
+    }
+
+    return _device_transfer_v(dev, RT_DEVICE_REQ_READ, pos, iov, iovcnt);
+}
+
+/**
+ * This function will write data in several buffers to a device.
+ *
+ * @param dev the pointer of device driver structure
+ * @param pos the position of written
+ * @param iov the I/O vectors, which are written in order
+ * @param iovcnt the number of I/O vectors
+ *
+ * @return the actually written size in total.
+ *
+ * @note the driver without write_v interface is invoked once for each vector,
+ *       and it stops at the first short write.
+ */
+rt_size_t rt_device_write_v(rt_device_t dev,
+                            rt_off_t    pos,
+                            const struct rt_iovec *iov,
+                            int         iovcnt)
+{
+    RT_ASSERT(dev != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&dev->parent) == RT_Object_Class_Device);
+    RT_ASSERT(iov != RT_NULL || iovcnt == 0);
+
+    if (dev->ref_count == 0)
+    {
+        rt_set_errno(-RT_ERROR);
+        return 0;
+    }
+
+    return _device_transfer_v(dev, RT_DEVICE_REQ_WRITE, pos, iov, iovcnt);
+}
+
+/**
+ * This function will submit an asynchronous request to a device. The request
+ * is queued and passed to the driver in order, the done callback is invoked
+ * when it's finished.
+ *
+ * @param dev the pointer of device driver structure
+ * @param req the request, which shall not be changed until it's done
+ *
+ * @return RT_EOK if the request is queued, -RT_EFULL if the queue is full.
+ *
+ * @note the request to the driver without submit interface is done in
+ *       the caller by read and write interfaces before this function returns.
+ */
+rt_err_t rt_device_submit(rt_device_t dev, struct rt_device_request *req)
+{
+    rt_base_t level;
+    rt_bool_t start;
+
+    RT_ASSERT(dev != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&dev->parent) == RT_Object_Class_Device);
+    RT_ASSERT(req != RT_NULL);
+    RT_ASSERT(req->cmd == RT_DEVICE_REQ_READ || req->cmd == RT_DEVICE_REQ_WRITE);
+
+    if (dev->ref_count == 0)
+        return -RT_ERROR;
+
+    req->result = 0;
+    req->error  = RT_EOK;
+
+    if (device_submit == RT_NULL)
+    {
+        /* synchronous driver */
+        req->result = _device_transfer_v(dev, req->cmd, req->pos, req->iov, req->iovcnt);
+        if (req->done != RT_NULL)
+            req->done(dev, req);
+
+        return RT_EOK;
+    }
+
+    level = rt_hw_interrupt_disable();
+    if (dev->request_count >= dev->request_depth)
+    {
+        rt_hw_interrupt_enable(level);
+
+        return -RT_EFULL;
+    }
+    dev->request_count ++;
+    /* the driver is idle if there is no request in queue */
+    start = rt_list_isempty(&(dev->request_list));
+    rt_list_insert_before(&(dev->request_list), &(req->list));
+    rt_hw_interrupt_enable(level);
+
+    if (start)
+        _device_request_start(dev, req);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will be invoked by the driver when the request passed to its
+ * submit interface is finished, it could be invoked in interrupt context.
+ * The done callback of request is invoked, and the next request is passed to
+ * the driver.
+ *
+ * @param dev the pointer of device driver structure
+ * @param req the finished request, whose result and error are set by driver
+ */
+void rt_device_request_done(rt_device_t dev, struct rt_device_request *req)
+{
+    RT_ASSERT(dev != RT_NULL);
+    RT_ASSERT(req != RT_NULL);
+
+    _device_request_start(dev, _device_request_finish(dev, req));
+}
+
+/**
+ * This function will set the maximum number of queued asynchronous requests
+ * of a device, it's RT_DEVICE_QUEUE_DEPTH by default.
+ *
+ * @param dev the pointer of device driver structure
+ * @param depth the maximum number of queued requests
+ *
+ * @return RT_EOK
+ */
+rt_err_t rt_device_set_queue_depth(rt_device_t dev, rt_uint8_t depth)
+{
+    RT_ASSERT(dev != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&dev->parent) == RT_Object_Class_Device);
+    RT_ASSERT(depth > 0);
+
+    dev->request_depth = depth;
+
+    return RT_EOK;
+}
+#endif /* RT_USING_DEVICE_ASYNC */
+
 /**
  * This function will set the reception indication callback function. This callback function
  * is invoked when this device receives data.
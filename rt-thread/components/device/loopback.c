@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Loopback device.
+ *
+ * The data written to device "loop" is read back in order. The asynchronous
+ * requests are finished in the callback of a timer, as a driver finishes them
+ * in the interrupt of DMA, and the one in transfer is aborted when the device
+ * is closed. The finsh command "loopback" exercises the scatter-gather and
+ * asynchronous interfaces of device framework.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined(RT_USING_DEVICE_ASYNC) && defined(RT_USING_DEVICE_LOOPBACK)
+
+#ifndef RT_LOOPBACK_BUF_SIZE
+#define RT_LOOPBACK_BUF_SIZE    256
+#endif
+
+#if (RT_LOOPBACK_BUF_SIZE & (RT_LOOPBACK_BUF_SIZE - 1)) != 0
+#error "RT_LOOPBACK_BUF_SIZE shall be power of 2"
+#endif
+
+struct loopback_device
+{
+    struct rt_device parent;
+
+    rt_uint8_t buffer[RT_LOOPBACK_BUF_SIZE];
+    rt_uint32_t in, out;
+
+    /* the request in transfer and the timer to finish it */
+    struct rt_device_request *request;
+    struct rt_timer timer;
+};
+
+static struct loopback_device _loopback;
+
+/* copy the data in or out of fifo with interrupt disabled */
+static rt_size_t _loopback_copy(struct loopback_device *loop, int cmd,
+                                const struct rt_iovec *iov, int iovcnt)
+{
+    int index;
+    rt_base_t level;
+    rt_size_t total, size, offset;
+    rt_uint8_t *ptr;
+
+    total = 0;
+    level = rt_hw_interrupt_disable();
+    for (index = 0; index < iovcnt; index ++)
+    {
+        ptr = (rt_uint8_t *)iov[index].base;
+        for (size = 0; size < iov[index].size; size ++)
+        {
+            if (cmd == RT_DEVICE_REQ_READ)
+            {
+                if (loop->in == loop->out)
+                    break;
+                offset = loop->out ++ & (RT_LOOPBACK_BUF_SIZE - 1);
+                ptr[size] = loop->buffer[offset];
+            }
+            else
+            {
+                if (loop->in - loop->out == RT_LOOPBACK_BUF_SIZE)
+                    break;
+                offset = loop->in ++ & (RT_LOOPBACK_BUF_SIZE - 1);
+                loop->buffer[offset] = ptr[size];
+            }
+        }
+
+        total += size;
+        if (size < iov[index].size)
+            break;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return total;
+}
+
+static rt_size_t _loopback_read(rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size)
+{
+    struct rt_iovec iov;
+
+    iov.base = buffer;
+    iov.size = size;
+
+    return _loopback_copy((struct loopback_device *)dev, RT_DEVICE_REQ_READ, &iov, 1);
+}
+
+static rt_size_t _loopback_write(rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size)
+{
+    struct rt_iovec iov;
+
+    iov.base = (void *)buffer;
+    iov.size = size;
+
+    return _loopback_copy((struct loopback_device *)dev, RT_DEVICE_REQ_WRITE, &iov, 1);
+}
+
+static rt_size_t _loopback_read_v(rt_device_t dev, rt_off_t pos,
+                                  const struct rt_iovec *iov, int iovcnt)
+{
+    return _loopback_copy((struct loopback_device *)dev, RT_DEVICE_REQ_READ, iov, iovcnt);
+}
+
+static rt_size_t _loopback_write_v(rt_device_t dev, rt_off_t pos,
+                                   const struct rt_iovec *iov, int iovcnt)
+{
+    return _loopback_copy((struct loopback_device *)dev, RT_DEVICE_REQ_WRITE, iov, iovcnt);
+}
+
+static rt_err_t _loopback_close(rt_device_t dev)
+{
+    struct loopback_device *loop = (struct loopback_device *)dev;
+    struct rt_device_request *req;
+    rt_base_t level;
+
+    /* abort the request in transfer */
+    level = rt_hw_interrupt_disable();
+    rt_timer_stop(&(loop->timer));
+    req = loop->request;
+    loop->request = RT_NULL;
+    rt_hw_interrupt_enable(level);
+
+    if (req != RT_NULL)
+    {
+        req->result = 0;
+        req->error  = -RT_EINTR;
+        rt_device_request_done(dev, req);
+    }
+
+    return RT_EOK;
+}
+
+static rt_err_t _loopback_submit(rt_device_t dev, struct rt_device_request *req)
+{
+    struct loopback_device *loop = (struct loopback_device *)dev;
+
+    /* the request is finished in the next tick */
+    loop->request = req;
+    rt_timer_start(&(loop->timer));
+
+    return RT_EOK;
+}
+
+static void _loopback_timeout(void *parameter)
+{
+    struct loopback_device *loop = (struct loopback_device *)parameter;
+    struct rt_device_request *req;
+
+    req = loop->request;
+    loop->request = RT_NULL;
+
+    req->result = _loopback_copy(loop, req->cmd, req->iov, req->iovcnt);
+    rt_device_request_done(&(loop->parent), req);
+}
+
+#ifdef RT_USING_DEVICE_OPS
+const static struct rt_device_ops _loopback_ops =
+{
+    RT_NULL,
+    RT_NULL,
+    _loopback_close,
+    _loopback_read,
+    _loopback_write,
+    RT_NULL,
+    _loopback_read_v,
+    _loopback_write_v,
+    _loopback_submit
+};
+#endif
+
+int rt_loopback_init(void)
+{
+    struct loopback_device *loop = &_loopback;
+
+    loop->parent.type = RT_Device_Class_Miscellaneous;
+#ifdef RT_USING_DEVICE_OPS
+    loop->parent.ops     = &_loopback_ops;
+#else
+    loop->parent.close   = _loopback_close;
+    loop->parent.read    = _loopback_read;
+    loop->parent.write   = _loopback_write;
+    loop->parent.read_v  = _loopback_read_v;
+    loop->parent.write_v = _loopback_write_v;
+    loop->parent.submit  = _loopback_submit;
+#endif
+
+    rt_timer_init(&(loop->timer), "loop", _loopback_timeout, loop, 1,
+                  RT_TIMER_FLAG_ONE_SHOT | RT_TIMER_FLAG_HARD_TIMER);
+
+    return rt_device_register(&(loop->parent), "loop", RT_DEVICE_FLAG_RDWR);
+}
+INIT_DEVICE_EXPORT(rt_loopback_init);
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#define LOOPBACK_REQUESTS       8
+
+static void _loopback_done(rt_device_t dev, struct rt_device_request *req)
+{
+    rt_sem_release((rt_sem_t)req->user_data);
+}
+
+static int loopback(void)
+{
+    int index, count, error;
+    char data[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    char read[sizeof(data)];
+    struct rt_iovec iov[3];
+    struct rt_iovec wiov[LOOPBACK_REQUESTS], riov[LOOPBACK_REQUESTS];
+    struct rt_device_request req[LOOPBACK_REQUESTS * 2];
+    struct rt_semaphore sem;
+    rt_device_t dev;
+
+    dev = rt_device_find("loop");
+    if (dev == RT_NULL || rt_device_open(dev, RT_DEVICE_OFLAG_RDWR) != RT_EOK)
+    {
+        rt_kprintf("no loopback device\n");
+        return -RT_ERROR;
+    }
+    error = 0;
+
+    /* scatter-gather: 3 vectors written, read back in 2 vectors */
+    iov[0].base = &data[0];
+    iov[0].size = 10;
+    iov[1].base = &data[10];
+    iov[1].size = 1;
+    iov[2].base = &data[11];
+    iov[2].size = sizeof(data) - 11;
+    if (rt_device_write_v(dev, 0, iov, 3) != sizeof(data))
+        error ++;
+
+    rt_memset(read, 0, sizeof(read));
+    iov[0].base = &read[0];
+    iov[0].size = 7;
+    iov[1].base = &read[7];
+    iov[1].size = sizeof(read) - 7;
+    if (rt_device_read_v(dev, 0, iov, 2) != sizeof(read) ||
+        rt_memcmp(read, data, sizeof(data)) != 0)
+        error ++;
+    rt_kprintf("scatter-gather: %s\n", error ? "failed" : "passed");
+
+    /* asynchronous: queue the writes and then the reads, 4 bytes each */
+    rt_sem_init(&sem, "loop", 0, RT_IPC_FLAG_FIFO);
+    rt_device_set_queue_depth(dev, LOOPBACK_REQUESTS * 2);
+    rt_memset(read, 0, sizeof(read));
+    for (index = 0; index < LOOPBACK_REQUESTS; index ++)
+    {
+        wiov[index].base = &data[index * 4];
+        wiov[index].size = 4;
+        riov[index].base = &read[index * 4];
+        riov[index].size = 4;
+    }
+    for (index = 0; index < LOOPBACK_REQUESTS * 2; index ++)
+    {
+        count = index % LOOPBACK_REQUESTS;
+
+        req[index].cmd       = (index < LOOPBACK_REQUESTS) ? RT_DEVICE_REQ_WRITE : RT_DEVICE_REQ_READ;
+        req[index].pos       = 0;
+        req[index].iov       = (index < LOOPBACK_REQUESTS) ? &wiov[count] : &riov[count];
+        req[index].iovcnt    = 1;
+        req[index].done      = _loopback_done;
+        req[index].user_data = &sem;
+
+        if (rt_device_submit(dev, &req[index]) != RT_EOK)
+            error ++;
+    }
+    for (count = 0; count < LOOPBACK_REQUESTS * 2; count ++)
+        rt_sem_take(&sem, RT_WAITING_FOREVER);
+
+    for (index = 0; index < LOOPBACK_REQUESTS * 2; index ++)
+    {
+        if (req[index].error != RT_EOK || req[index].result != 4)
+            error ++;
+    }
+    if (rt_memcmp(read, data, LOOPBACK_REQUESTS * 4) != 0)
+        error ++;
+    rt_kprintf("asynchronous: %s\n", error ? "failed" : "passed");
+
+    /* closed with the requests queued, which are finished in close */
+    for (index = 0; index < LOOPBACK_REQUESTS; index ++)
+    {
+        if (rt_device_submit(dev, &req[index]) != RT_EOK)
+            error ++;
+    }
+    rt_device_close(dev);
+    for (index = 0; index < LOOPBACK_REQUESTS; index ++)
+    {
+        if (rt_sem_take(&sem, RT_WAITING_NO) != RT_EOK ||
+            req[index].error != -RT_EINTR || req[index].result != 0)
+            error ++;
+    }
+    /* no callback after close */
+    rt_thread_delay(2);
+    if (sem.value != 0)
+        error ++;
+    rt_kprintf("cancelled on close: %s\n", error ? "failed" : "passed");
+
+    rt_sem_detach(&sem);
+
+    return error ? -RT_ERROR : RT_EOK;
+}
+MSH_CMD_EXPORT(loopback, exercise the loopback device);
+#endif /* RT_USING_FINSH */
+
+#endif /* defined(RT_USING_DEVICE_ASYNC) && defined(RT_USING_DEVICE_LOOPBACK) */
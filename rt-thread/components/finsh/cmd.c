@@ -28,6 +28,8 @@
  * 2018-11-22     Jesven       list_thread add smp support
  * 2018-12-27     Jesven       Fix the problem that disable interrupt too long in list_thread
  *                             Provide protection for the "first layer of objects" when list_*
+ * 2026-10-17     weizx208     add list_ringbuf
+ * 2026-10-17     weizx208     show the owner of mutex taken in fast path
  */
 
 #include <rthw.h>
@@ -423,6 +425,8 @@ long list_mutex(void)
             {
                 struct rt_object *obj;
                 struct rt_mutex *m;
+                struct rt_thread *owner;
+                int hold;
 
                 obj = rt_list_entry(obj_list[i], struct rt_object, list);
                 level = rt_hw_interrupt_disable();
@@ -435,12 +439,22 @@ long list_mutex(void)
                 rt_hw_interrupt_enable(level);
 
                 m = (struct rt_mutex *)obj;
+                owner = m->owner;
+                hold  = m->hold;
+#ifdef RT_USING_MUTEX_FAST
+                /* taken without contention */
+                if (m->lock != 0 && m->lock != RT_MUTEX_LOCK_SLOW)
+                {
+                    owner = (struct rt_thread *)m->lock;
+                    hold  = 1;
+                }
+#endif
                 rt_kprintf("%-*.*s %-8.*s %04d %d\n",
                         maxlen, RT_NAME_MAX,
                         m->parent.parent.name,
                         RT_NAME_MAX,
-                        m->owner->name,
-                        m->hold,
+                        (owner != RT_NULL) ? owner->name : "",
+                        hold,
                         rt_list_len(&m->parent.suspend_thread));
 
             }
@@ -592,6 +606,80 @@ FINSH_FUNCTION_EXPORT(list_msgqueue, list message queue in system);
 MSH_CMD_EXPORT(list_msgqueue, list message queue in system);
 #endif
 
+#ifdef RT_USING_RINGBUF
+long list_ringbuf(void)
+{
+    rt_ubase_t level;
+    list_get_next_t find_arg;
+    rt_list_t *obj_list[LIST_FIND_OBJ_NR];
+    rt_list_t *next = (rt_list_t*)RT_NULL;
+
+    int maxlen;
+    const char *item_title = "ringbuf";
+
+    list_find_init(&find_arg, RT_Object_Class_RingBuf, obj_list, sizeof(obj_list)/sizeof(obj_list[0]));
+
+    maxlen = RT_NAME_MAX;
+
+    rt_kprintf("%-*.s   data     size suspend thread\n", maxlen, item_title); object_split(maxlen);
+    rt_kprintf(     " -------- -------- --------------\n");
+    do
+    {
+        next = list_get_next(next, &find_arg);
+        {
+            int i;
+            for (i = 0; i < find_arg.nr_out; i++)
+            {
+                struct rt_object *obj;
+                struct rt_ringbuf *rb;
+
+                obj = rt_list_entry(obj_list[i], struct rt_object, list);
+                level = rt_hw_interrupt_disable();
+                if ((obj->type & ~RT_Object_Class_Static) != find_arg.type)
+                {
+                    rt_hw_interrupt_enable(level);
+                    continue;
+                }
+
+                rt_hw_interrupt_enable(level);
+
+                rb = (struct rt_ringbuf *)obj;
+                if (!rt_list_isempty(&rb->parent.suspend_thread) ||
+                    !rt_list_isempty(&rb->suspend_sender_thread))
+                {
+                    rt_kprintf("%-*.*s %8d %8d %d:",
+                            maxlen, RT_NAME_MAX,
+                            rb->parent.parent.name,
+                            rt_ringbuf_data_len(rb),
+                            rb->size,
+                            rt_list_len(&rb->parent.suspend_thread) +
+                            rt_list_len(&rb->suspend_sender_thread));
+                    show_wait_queue(&(rb->parent.suspend_thread));
+                    if (!rt_list_isempty(&rb->parent.suspend_thread) &&
+                        !rt_list_isempty(&rb->suspend_sender_thread))
+                        rt_kprintf("/");
+                    show_wait_queue(&(rb->suspend_sender_thread));
+                    rt_kprintf("\n");
+                }
+                else
+                {
+                    rt_kprintf("%-*.*s %8d %8d 0\n",
+                            maxlen, RT_NAME_MAX,
+                            rb->parent.parent.name,
+                            rt_ringbuf_data_len(rb),
+                            rb->size);
+                }
+            }
+        }
+    }
+    while (next != (rt_list_t*)RT_NULL);
+
+    return 0;
+}
+FINSH_FUNCTION_EXPORT(list_ringbuf, list ring buffer in system);
+MSH_CMD_EXPORT(list_ringbuf, list ring buffer in system);
+#endif
+
 #ifdef RT_USING_MEMHEAP
 long list_memheap(void)
 {
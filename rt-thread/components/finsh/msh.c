@@ -110,11 +110,15 @@ int cmd_free(int argc, char **argv)
 {
     extern void list_mem(void);
     extern void list_memheap(void);
+    extern void list_mem_cache(void);
 
 #ifdef RT_USING_MEMHEAP_AS_HEAP
     list_memheap();
 #else
     list_mem();
+#endif
+#ifdef RT_USING_MEM_CACHE
+    list_mem_cache();
 #endif
     return 0;
 }
@@ -60,6 +60,16 @@
 #define RT_DEBUG_CONTEXT_CHECK         1
 #endif
 
+#if defined(RT_USING_BLOG) && defined(RT_DEBUG_USING_BLOG)
+/* the debug log is recorded in binary log, see tools/blog_decode.py */
+#define RT_DEBUG_LOG(type, message)                                           \
+do                                                                            \
+{                                                                             \
+    if (type)                                                                 \
+        RT_BLOG message;                                                      \
+}                                                                             \
+while (0)
+#else
 #define RT_DEBUG_LOG(type, message)                                           \
 do                                                                            \
 {                                                                             \
@@ -67,6 +77,7 @@ do                                                                            \
         rt_kprintf message;                                                   \
 }                                                                             \
 while (0)
+#endif
 
 #define RT_ASSERT(EX)                                                         \
 if (!(EX))                                                                    \
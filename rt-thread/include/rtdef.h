@@ -118,6 +118,11 @@ typedef rt_base_t                       rt_off_t;       /**< Type for offset */
 
     #define RT_WEAK                     __attribute__((weak))
     #define rt_inline                   static __inline
+    #ifdef __CLANG_ARM
+    #define RT_RETURN_ADDRESS()         __builtin_return_address(0)
+    #else
+    #define RT_RETURN_ADDRESS()         ((void *)__return_address())
+    #endif
 
 #elif defined (__IAR_SYSTEMS_ICC__)     /* for IAR Compiler */
     #include <stdarg.h>
@@ -147,6 +152,7 @@ typedef rt_base_t                       rt_off_t;       /**< Type for offset */
     #define ALIGN(n)                    __attribute__((aligned(n)))
     #define RT_WEAK                     __attribute__((weak))
     #define rt_inline                   static __inline
+    #define RT_RETURN_ADDRESS()         __builtin_return_address(0)
 #elif defined (__ADSPBLACKFIN__)        /* for VisualDSP++ Compiler */
     #include <stdarg.h>
     #define SECTION(x)                  __attribute__((section(x)))
@@ -179,6 +185,11 @@ typedef rt_base_t                       rt_off_t;       /**< Type for offset */
     #error not supported tool chain
 #endif
 
+/* the return address of current function, 0 if the compiler can't tell */
+#ifndef RT_RETURN_ADDRESS
+    #define RT_RETURN_ADDRESS()         ((void *)0)
+#endif
+
 /* initialization export */
 #ifdef RT_USING_COMPONENTS_INIT
 typedef int (*init_fn_t)(void);
@@ -219,6 +230,42 @@ typedef int (*init_fn_t)(void);
 /* appliation initialization (rtgui application etc ...) */
 #define INIT_APP_EXPORT(fn)             INIT_EXPORT(fn, "6")
 
+#if defined(RT_USING_COMPONENTS_INIT) && defined(RT_USING_INIT_PARALLEL) && !defined(_MSC_VER)
+/**
+ * initialization node, which runs with the other nodes of the same level
+ * concurrently, after the nodes it depends on
+ */
+struct rt_init_node
+{
+    const char *name;                                   /**< name of node, the function name */
+    init_fn_t   fn;                                     /**< initialization function */
+    const char *depends;                                /**< names of nodes depended, separated by ',' */
+
+    struct rt_init_node *next;                          /**< next node registered */
+    rt_uint8_t  state;                                  /**< pending, running or done */
+    rt_uint8_t  level;                                  /**< level of initialization */
+};
+
+#define INIT_NODE_EXPORT(fn, level, depends)                                            \
+    static struct rt_init_node __rt_init_node_##fn = {#fn, fn, depends};                \
+    static int __rt_init_node_##fn##_register(void)                                     \
+    {                                                                                   \
+        rt_init_node_register(&__rt_init_node_##fn);                                    \
+        return 0;                                                                       \
+    }                                                                                   \
+    INIT_EXPORT(__rt_init_node_##fn##_register, level)
+#else
+#define INIT_NODE_EXPORT(fn, level, depends)    INIT_EXPORT(fn, level)
+#endif
+
+/* the nodes of each level, depends is a string such as "spi_init,fal_init" */
+#define INIT_BOARD_NODE_EXPORT(fn, depends)     INIT_NODE_EXPORT(fn, "1", depends)
+#define INIT_PREV_NODE_EXPORT(fn, depends)      INIT_NODE_EXPORT(fn, "2", depends)
+#define INIT_DEVICE_NODE_EXPORT(fn, depends)    INIT_NODE_EXPORT(fn, "3", depends)
+#define INIT_COMPONENT_NODE_EXPORT(fn, depends) INIT_NODE_EXPORT(fn, "4", depends)
+#define INIT_ENV_NODE_EXPORT(fn, depends)       INIT_NODE_EXPORT(fn, "5", depends)
+#define INIT_APP_NODE_EXPORT(fn, depends)       INIT_NODE_EXPORT(fn, "6", depends)
+
 #if !defined(RT_USING_FINSH)
 /* define these to empty, even if not include finsh.h file */
 #define FINSH_FUNCTION_EXPORT(name, desc)
@@ -338,6 +385,9 @@ struct rt_object
     rt_uint8_t flag;                                    /**< flag of kernel object */
 
     rt_list_t  list;                                    /**< list node of kernel object */
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object *hash_next;                        /**< next object in the same name hash bucket */
+#endif
 };
 typedef struct rt_object *rt_object_t;                  /**< Type for kernel objects. */
 
@@ -370,6 +420,7 @@ enum rt_object_class_type
     RT_Object_Class_MemPool       = 0x08,      /**< The object is a memory pool. */
     RT_Object_Class_Device        = 0x09,      /**< The object is a device. */
     RT_Object_Class_Timer         = 0x0a,      /**< The object is a timer. */
+    RT_Object_Class_RingBuf       = 0x0b,      /**< The object is a ring buffer. */
     RT_Object_Class_Unknown       = 0x0c,      /**< The object is unknown. */
     RT_Object_Class_Static        = 0x80       /**< The object is a static object. */
 };
@@ -394,6 +445,112 @@ struct rt_object_information
 #define RT_OBJECT_HOOK_CALL(func, argv)
 #endif
 
+/**
+ * kernel trace events
+ */
+#define RT_TRACE_THREAD_SWITCH          0x01            /**< switch to thread, arg: priority */
+#define RT_TRACE_IRQ_ENTER              0x02            /**< enter interrupt, arg: interrupt nest */
+#define RT_TRACE_IRQ_LEAVE              0x03            /**< leave interrupt, arg: interrupt nest */
+#define RT_TRACE_IPC_BLOCK              0x04            /**< thread blocks on IPC, arg: priority */
+#define RT_TRACE_IPC_WAKE               0x05            /**< thread is woken by IPC, arg: priority */
+#define RT_TRACE_TIMER_EXPIRE           0x06            /**< timer timeout, arg: timer flag */
+
+#ifdef RT_USING_TRACE
+/**
+ * kernel trace record
+ */
+struct rt_trace_record
+{
+    rt_uint32_t timestamp;                              /**< timestamp of event */
+    rt_uint8_t  event;                                  /**< trace event */
+    rt_uint8_t  reserved;
+    rt_uint16_t arg;                                    /**< argument of event */
+    rt_ubase_t  object;                                 /**< address of thread, timer */
+};
+
+/**
+ * The trace record macro
+ */
+#define RT_TRACE_RECORD(event, arg, object) \
+    rt_trace_record((event), (rt_uint16_t)(arg), (void *)(object))
+#else
+#define RT_TRACE_RECORD(event, arg, object)
+#endif
+
+/**
+ * interrupt latency spans
+ */
+#define RT_IRQ_LATENCY_IRQ_OFF          0               /**< interrupt disabled */
+#define RT_IRQ_LATENCY_SCHED_LOCK       1               /**< scheduler locked */
+#define RT_IRQ_LATENCY_ISR              2               /**< interrupt service routine */
+#define RT_IRQ_LATENCY_SPANS            3
+
+#ifdef RT_USING_IRQ_LATENCY
+/**
+ * The latency span macros, invoked with interrupt disabled
+ */
+#define RT_IRQ_LATENCY_BEGIN(span, caller) \
+    rt_irq_latency_begin((span), (void *)(caller))
+#define RT_IRQ_LATENCY_END(span)        rt_irq_latency_end(span)
+#else
+#define RT_IRQ_LATENCY_BEGIN(span, caller)
+#define RT_IRQ_LATENCY_END(span)
+#endif
+
+#ifdef RT_USING_BLOG
+#define RT_BLOG_ARG_MAX                 8               /**< maximum arguments of binary log */
+
+/* the number of arguments after the format, the last one is a placeholder */
+#define _RT_BLOG_NARGS(f, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+#define _RT_BLOG_CAT(a, b)              a##b
+#define _RT_BLOG_SELECT(n)              _RT_BLOG_CAT(_RT_BLOG_, n)
+#define _RT_BLOG_ARG(a)                 ((rt_ubase_t)(a))
+
+#define _RT_BLOG_0(f)                                                         \
+    rt_blog_write(f, 0)
+#define _RT_BLOG_1(f, a1)                                                     \
+    rt_blog_write(f, 1, _RT_BLOG_ARG(a1))
+#define _RT_BLOG_2(f, a1, a2)                                                 \
+    rt_blog_write(f, 2, _RT_BLOG_ARG(a1), _RT_BLOG_ARG(a2))
+#define _RT_BLOG_3(f, a1, a2, a3)                                             \
+    rt_blog_write(f, 3, _RT_BLOG_ARG(a1), _RT_BLOG_ARG(a2), _RT_BLOG_ARG(a3))
+#define _RT_BLOG_4(f, a1, a2, a3, a4)                                         \
+    rt_blog_write(f, 4, _RT_BLOG_ARG(a1), _RT_BLOG_ARG(a2), _RT_BLOG_ARG(a3), \
+                  _RT_BLOG_ARG(a4))
+#define _RT_BLOG_5(f, a1, a2, a3, a4, a5)                                     \
+    rt_blog_write(f, 5, _RT_BLOG_ARG(a1), _RT_BLOG_ARG(a2), _RT_BLOG_ARG(a3), \
+                  _RT_BLOG_ARG(a4), _RT_BLOG_ARG(a5))
+#define _RT_BLOG_6(f, a1, a2, a3, a4, a5, a6)                                 \
+    rt_blog_write(f, 6, _RT_BLOG_ARG(a1), _RT_BLOG_ARG(a2), _RT_BLOG_ARG(a3), \
+                  _RT_BLOG_ARG(a4), _RT_BLOG_ARG(a5), _RT_BLOG_ARG(a6))
+#define _RT_BLOG_7(f, a1, a2, a3, a4, a5, a6, a7)                             \
+    rt_blog_write(f, 7, _RT_BLOG_ARG(a1), _RT_BLOG_ARG(a2), _RT_BLOG_ARG(a3), \
+                  _RT_BLOG_ARG(a4), _RT_BLOG_ARG(a5), _RT_BLOG_ARG(a6),       \
+                  _RT_BLOG_ARG(a7))
+#define _RT_BLOG_8(f, a1, a2, a3, a4, a5, a6, a7, a8)                         \
+    rt_blog_write(f, 8, _RT_BLOG_ARG(a1), _RT_BLOG_ARG(a2), _RT_BLOG_ARG(a3), \
+                  _RT_BLOG_ARG(a4), _RT_BLOG_ARG(a5), _RT_BLOG_ARG(a6),       \
+                  _RT_BLOG_ARG(a7), _RT_BLOG_ARG(a8))
+
+/**
+ * The binary log macro, RT_BLOG(format, ...). The format shall be a string
+ * literal, and it takes RT_BLOG_ARG_MAX integer or pointer arguments at most,
+ * which are recorded as rt_ubase_t.
+ */
+#define RT_BLOG(...)                                                          \
+    _RT_BLOG_SELECT(_RT_BLOG_NARGS(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, _))(__VA_ARGS__)
+#else
+#define RT_BLOG(...)
+#endif
+
+/**
+ * severity levels of kernel log
+ */
+#define RT_KLOG_ERROR                   3               /**< error */
+#define RT_KLOG_WARNING                 4               /**< warning */
+#define RT_KLOG_INFO                    6               /**< information */
+#define RT_KLOG_DEBUG                   7               /**< debug */
+
 /**@}*/
 
 /**
@@ -445,6 +602,21 @@ struct rt_timer
 };
 typedef struct rt_timer *rt_timer_t;
 
+#ifdef RT_USING_TICKLESS
+/**
+ * tick source operations for tickless idle
+ */
+struct rt_tickless_ops
+{
+    /* program the tick source to interrupt after timeout ticks at most */
+    void (*timer_start)(rt_tick_t timeout);
+    /* restore the periodic tick, return the whole ticks passed except the pending tick interrupt */
+    rt_tick_t (*timer_stop)(void);
+    /* wait for interrupt, it's invoked with interrupt disabled */
+    void (*sleep)(void);
+};
+#endif
+
 /**@}*/
 
 /**
@@ -475,6 +647,54 @@ typedef struct rt_timer *rt_timer_t;
 #define RT_THREAD_CTRL_CLOSE            0x01                /**< Close thread. */
 #define RT_THREAD_CTRL_CHANGE_PRIORITY  0x02                /**< Change thread priority. */
 #define RT_THREAD_CTRL_INFO             0x03                /**< Get thread information. */
+#define RT_THREAD_CTRL_PREEMPT_THRESHOLD 0x04               /**< Set preemption threshold. */
+#define RT_THREAD_CTRL_EDF              0x05                /**< Set earliest deadline first parameters. */
+
+#ifdef RT_USING_MEM_CACHE
+#ifndef RT_MEM_CACHE_CLASS
+#define RT_MEM_CACHE_CLASS              4                   /**< size classes: 16, 32, 64 and 128 bytes */
+#endif
+
+/**
+ * small memory cache of thread in front of the heap
+ */
+struct rt_mem_cache
+{
+    void       *free[RT_MEM_CACHE_CLASS];               /**< free blocks of each size class */
+    rt_uint8_t  count[RT_MEM_CACHE_CLASS];              /**< the number of free blocks */
+
+    rt_uint32_t hit;                                    /**< allocations from cache */
+    rt_uint32_t miss;                                   /**< allocations from heap */
+};
+#endif
+
+#ifdef RT_USING_EDF
+/**
+ * the parameters of earliest deadline first scheduling, in ticks
+ */
+struct rt_edf_param
+{
+    rt_tick_t   period;                                 /**< the period of jobs, 0 to leave the class */
+    rt_tick_t   budget;                                 /**< the execution time of a job */
+    rt_tick_t   deadline;                               /**< relative to the release, 0 for the period */
+};
+
+/**
+ * the job of a thread in earliest deadline first scheduling class
+ */
+struct rt_edf
+{
+    struct rt_edf_param param;
+
+    rt_tick_t   release;                                /**< the release tick of current job */
+    rt_tick_t   deadline;                               /**< the absolute deadline of current job */
+    rt_tick_t   used;                                   /**< the ticks used by current job */
+
+    rt_uint32_t jobs;                                   /**< the jobs done */
+    rt_uint32_t misses;                                 /**< the jobs missed the deadline */
+    rt_uint32_t overruns;                               /**< the jobs throttled as budget exhausted */
+};
+#endif
 
 /**
  * Thread structure
@@ -487,6 +707,9 @@ struct rt_thread
     rt_uint8_t  flags;                                  /**< thread's flags */
 
     rt_list_t   list;                                   /**< the object list */
+#ifdef RT_USING_OBJECT_HASH
+    struct rt_object *hash_next;                        /**< next object in the same name hash bucket */
+#endif
     rt_list_t   tlist;                                  /**< the thread list */
 
     /* stack point and entry */
@@ -495,6 +718,13 @@ struct rt_thread
     void       *parameter;                              /**< parameter */
     void       *stack_addr;                             /**< stack address */
     rt_uint32_t stack_size;                             /**< stack size */
+#ifdef RT_USING_STACK_WATERMARK
+    rt_uint32_t stack_peak;                             /**< the maximum used size of stack found */
+    rt_uint32_t stack_scan;                             /**< the offset of stack to be scanned */
+#endif
+#ifdef RT_USING_CPU_USAGE
+    rt_uint64_t run_time;                               /**< the run time in unit of timestamp */
+#endif
 
     /* error code */
     rt_err_t    error;                                  /**< error code */
@@ -504,6 +734,16 @@ struct rt_thread
     /* priority */
     rt_uint8_t  current_priority;                       /**< current priority */
     rt_uint8_t  init_priority;                          /**< initialized priority */
+#ifdef RT_USING_PREEMPT_THRESHOLD
+    rt_uint8_t  preempt_threshold;                      /**< only the threads higher than it preempt */
+#endif
+#ifdef RT_USING_EDF
+    struct rt_edf edf;                                  /**< earliest deadline first scheduling */
+#endif
+#ifdef RT_USING_MUTEX_FAST
+    void       *mutex_taking;                           /**< the mutex taken without contention */
+    rt_uint8_t  mutex_taking_priority;                  /**< the priority when it's taken */
+#endif
 #if RT_THREAD_PRIORITY_MAX > 32
     rt_uint8_t  number;
     rt_uint8_t  high_mask;
@@ -523,6 +763,15 @@ struct rt_thread
 
     void (*cleanup)(struct rt_thread *tid);             /**< cleanup function when thread exit */
 
+#ifdef RT_USING_MEM_CACHE
+    struct rt_mem_cache mem_cache;                      /**< small memory cache */
+#endif
+
+#ifdef RT_USING_IPC_PRIO_INDEX
+    struct rt_ipc_prio_index *wait_index;               /**< priority index of the suspended list */
+    rt_uint8_t  wait_priority;                          /**< priority in the suspended list */
+#endif
+
     rt_uint32_t user_data;                              /**< private user data beyond this thread */
 };
 typedef struct rt_thread *rt_thread_t;
@@ -550,11 +799,29 @@ typedef struct rt_thread *rt_thread_t;
 /**
  * Base structure of IPC object
  */
+#ifdef RT_USING_IPC_PRIO_INDEX
+/**
+ * priority index of a suspended thread list, the last thread of each priority
+ * is recorded so that a thread is inserted in constant time. It takes
+ * (2 + RT_THREAD_PRIORITY_MAX) words in each IPC object, and another index in
+ * mailbox and message queue for the senders.
+ */
+struct rt_ipc_prio_index
+{
+    rt_list_t           *list;                          /**< the indexed list of suspended threads */
+    rt_uint32_t          group;                         /**< priorities of the suspended threads */
+    struct rt_thread    *tail[RT_THREAD_PRIORITY_MAX];  /**< the last suspended thread of each priority */
+};
+#endif
+
 struct rt_ipc_object
 {
     struct rt_object parent;                            /**< inherit from rt_object */
 
     rt_list_t        suspend_thread;                    /**< threads pended on this resource */
+#ifdef RT_USING_IPC_PRIO_INDEX
+    struct rt_ipc_prio_index suspend_index;             /**< priority index of suspend_thread */
+#endif
 };
 
 #ifdef RT_USING_SEMAPHORE
@@ -572,6 +839,11 @@ typedef struct rt_semaphore *rt_sem_t;
 #endif
 
 #ifdef RT_USING_MUTEX
+#ifdef RT_USING_MUTEX_FAST
+/* the lock word of mutex when it's managed with interrupt disabled */
+#define RT_MUTEX_LOCK_SLOW              ((rt_ubase_t)1)
+#endif
+
 /**
  * Mutual exclusion (mutex) structure
  */
@@ -585,6 +857,9 @@ struct rt_mutex
     rt_uint8_t           hold;                          /**< numbers of thread hold the mutex */
 
     struct rt_thread    *owner;                         /**< current owner of mutex */
+#ifdef RT_USING_MUTEX_FAST
+    volatile rt_ubase_t  lock;                          /**< the owner taken without contention */
+#endif
 };
 typedef struct rt_mutex *rt_mutex_t;
 #endif
@@ -626,6 +901,9 @@ struct rt_mailbox
     rt_uint16_t          out_offset;                    /**< output offset of the message buffer */
 
     rt_list_t            suspend_sender_thread;         /**< sender thread suspended on this mailbox */
+#ifdef RT_USING_IPC_PRIO_INDEX
+    struct rt_ipc_prio_index suspend_sender_index;      /**< priority index of suspend_sender_thread */
+#endif
 };
 typedef struct rt_mailbox *rt_mailbox_t;
 #endif
@@ -650,10 +928,82 @@ struct rt_messagequeue
     void                *msg_queue_free;                /**< pointer indicated the free node of queue */
 
     rt_list_t            suspend_sender_thread;         /**< sender thread suspended on this message queue */
+#ifdef RT_USING_IPC_PRIO_INDEX
+    struct rt_ipc_prio_index suspend_sender_index;      /**< priority index of suspend_sender_thread */
+#endif
+
+#ifdef RT_USING_MEMPOOL
+    struct rt_mempool   *msg_mp;                        /**< memory pool of zero-copy message, RT_NULL for copying queue */
+#endif
 };
 typedef struct rt_messagequeue *rt_mq_t;
 #endif
 
+#ifdef RT_USING_RINGBUF
+/**
+ * single-producer/single-consumer ring buffer structure
+ */
+struct rt_ringbuf
+{
+    struct rt_ipc_object parent;                        /**< inherit from ipc_object */
+
+    rt_uint8_t          *buffer;                        /**< start address of ring buffer */
+    rt_uint32_t          size;                          /**< size of ring buffer, power of 2 */
+
+    volatile rt_uint32_t in;                            /**< write index, only changed by producer */
+    volatile rt_uint32_t out;                           /**< read index, only changed by consumer */
+
+    rt_list_t            suspend_sender_thread;         /**< sender thread suspended on this ring buffer */
+};
+typedef struct rt_ringbuf *rt_ringbuf_t;
+#endif
+
+#ifdef RT_USING_WORKQUEUE
+/*
+ * work flags
+ */
+#define RT_WORK_STATE_PENDING           0x01            /**< in the pending list of workqueue */
+#define RT_WORK_STATE_SUBMITTING        0x02            /**< the timer of delayed work is started */
+
+struct rt_workqueue;
+
+/**
+ * work structure, run by the thread of workqueue
+ */
+struct rt_work
+{
+    rt_list_t            list;                          /**< node of pending or delayed list */
+
+    void (*work_func)(struct rt_work *work, void *work_data);  /**< work function */
+    void                *work_data;                     /**< parameter of work function */
+    rt_uint16_t          flags;                         /**< state of work */
+
+    struct rt_timer      timer;                         /**< timer of delayed work */
+    struct rt_workqueue *workqueue;                     /**< workqueue submitted to */
+    rt_uint32_t          stamp;                         /**< timestamp when it's pending */
+};
+
+/**
+ * workqueue structure
+ */
+struct rt_workqueue
+{
+    rt_list_t            work_list;                     /**< pending work */
+    rt_list_t            delayed_list;                  /**< delayed work, whose timer is started */
+    struct rt_work      *work_current;                  /**< work running */
+
+    struct rt_semaphore  sem;                           /**< wake up the thread */
+    struct rt_thread    *work_thread;                   /**< thread of workqueue */
+    struct rt_workqueue *next;                          /**< next workqueue */
+
+    rt_uint32_t          done;                          /**< number of work done */
+    rt_uint32_t          latency_max;                   /**< maximal time from pending to run */
+    rt_uint64_t          latency_sum;                   /**< total time from pending to run */
+    rt_uint32_t          run_max;                       /**< maximal time of work function */
+};
+typedef struct rt_workqueue *rt_workqueue_t;
+#endif
+
 /**@}*/
 
 /**
@@ -805,6 +1155,43 @@ enum rt_device_class_type
 #define RT_DEVICE_CTRL_GET_INT          0x12            /**< get interrupt status */
 
 typedef struct rt_device *rt_device_t;
+
+#ifdef RT_USING_DEVICE_ASYNC
+/**
+ * I/O vector of scatter-gather read and write
+ */
+struct rt_iovec
+{
+    void                     *base;                     /**< base address of buffer */
+    rt_size_t                 size;                     /**< size of buffer */
+};
+
+/**
+ * asynchronous request commands
+ */
+#define RT_DEVICE_REQ_READ              0x01            /**< read from device */
+#define RT_DEVICE_REQ_WRITE             0x02            /**< write to device */
+
+/**
+ * asynchronous request of device
+ */
+struct rt_device_request
+{
+    rt_list_t                 list;                     /**< node of device request queue */
+    int                       cmd;                      /**< RT_DEVICE_REQ_READ or RT_DEVICE_REQ_WRITE */
+    rt_off_t                  pos;                      /**< position of transfer */
+    const struct rt_iovec    *iov;                      /**< I/O vectors */
+    int                       iovcnt;                   /**< number of I/O vectors */
+
+    rt_size_t                 result;                   /**< transferred size */
+    rt_err_t                  error;                    /**< error code of request */
+
+    /* completion callback, it may be invoked in interrupt context */
+    void (*done)(rt_device_t dev, struct rt_device_request *req);
+    void                     *user_data;                /**< user data of request */
+};
+#endif
+
 /**
  * operations set for device object
  */
@@ -817,6 +1204,12 @@ struct rt_device_ops
     rt_size_t (*read)   (rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size);
     rt_size_t (*write)  (rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size);
     rt_err_t  (*control)(rt_device_t dev, int cmd, void *args);
+#ifdef RT_USING_DEVICE_ASYNC
+    /* optional scatter-gather and asynchronous interface */
+    rt_size_t (*read_v) (rt_device_t dev, rt_off_t pos, const struct rt_iovec *iov, int iovcnt);
+    rt_size_t (*write_v)(rt_device_t dev, rt_off_t pos, const struct rt_iovec *iov, int iovcnt);
+    rt_err_t  (*submit) (rt_device_t dev, struct rt_device_request *req);
+#endif
 };
 
 /**
@@ -847,6 +1240,18 @@ struct rt_device
     rt_size_t (*read)   (rt_device_t dev, rt_off_t pos, void *buffer, rt_size_t size);
     rt_size_t (*write)  (rt_device_t dev, rt_off_t pos, const void *buffer, rt_size_t size);
     rt_err_t  (*control)(rt_device_t dev, int cmd, void *args);
+#ifdef RT_USING_DEVICE_ASYNC
+    /* optional scatter-gather and asynchronous interface */
+    rt_size_t (*read_v) (rt_device_t dev, rt_off_t pos, const struct rt_iovec *iov, int iovcnt);
+    rt_size_t (*write_v)(rt_device_t dev, rt_off_t pos, const struct rt_iovec *iov, int iovcnt);
+    rt_err_t  (*submit) (rt_device_t dev, struct rt_device_request *req);
+#endif
+#endif
+
+#ifdef RT_USING_DEVICE_ASYNC
+    rt_list_t                 request_list;             /**< queued asynchronous requests */
+    rt_uint8_t                request_count;            /**< number of queued requests */
+    rt_uint8_t                request_depth;            /**< maximum number of queued requests */
 #endif
 
     void                     *user_data;                /**< device private data */
@@ -10,6 +10,7 @@
  * 2006-09-24     Bernard      add rt_hw_context_switch_to declaration
  * 2012-12-29     Bernard      add rt_hw_exception_install declaration
  * 2017-10-17     Hichard      add some micros
+ * 2026-10-17     weizx208     measure the interrupt disabled spans
  */
 
 #ifndef __RT_HW_H__
@@ -64,6 +65,7 @@ rt_uint8_t *rt_hw_stack_init(void       *entry,
                              void       *parameter,
                              rt_uint8_t *stack_addr,
                              void       *exit);
+void rt_hw_stack_free(void *sp);
 
 /*
  * Interrupt handler definition
@@ -95,6 +97,15 @@ rt_isr_handler_t rt_hw_interrupt_install(int              vector,
 rt_base_t rt_hw_interrupt_disable(void);
 void rt_hw_interrupt_enable(rt_base_t level);
 
+#if defined(RT_USING_IRQ_LATENCY) && !defined(RT_IRQ_LATENCY_RAW)
+/*
+ * measure the interrupt disabled spans, except in the port which defines
+ * RT_IRQ_LATENCY_RAW to implement the functions above
+ */
+#define rt_hw_interrupt_disable()       rt_irq_latency_disable()
+#define rt_hw_interrupt_enable(level)   rt_irq_latency_enable(level)
+#endif
+
 /*
  * Context interfaces
  */
@@ -120,6 +131,11 @@ void rt_hw_us_delay(rt_uint32_t us);
 #define RT_DEFINE_SPINLOCK(x)
 #define RT_DECLARE_SPINLOCK(x)    rt_ubase_t x
 
+/*
+ * Atomic interfaces
+ */
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t value);
+
 #define rt_hw_spin_lock(lock)     *(lock) = rt_hw_interrupt_disable()
 #define rt_hw_spin_unlock(lock)   rt_hw_interrupt_enable(*(lock))
 
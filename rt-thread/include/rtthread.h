@@ -78,6 +78,10 @@ void rt_tick_set(rt_tick_t tick);
 void rt_tick_increase(void);
 rt_tick_t  rt_tick_from_millisecond(rt_int32_t ms);
 
+void rt_timestamp_set(rt_uint32_t (*timestamp)(void), rt_uint32_t frequency);
+rt_uint32_t rt_timestamp_get(void);
+rt_uint32_t rt_timestamp_get_frequency(void);
+
 void rt_system_timer_init(void);
 void rt_system_timer_thread_init(void);
 
@@ -106,6 +110,12 @@ void rt_timer_enter_sethook(void (*hook)(struct rt_timer *timer));
 void rt_timer_exit_sethook(void (*hook)(struct rt_timer *timer));
 #endif
 
+#ifdef RT_USING_TICKLESS
+void rt_tickless_register(const struct rt_tickless_ops *ops);
+void rt_tickless_enter(void);
+void rt_tickless_info(rt_uint32_t *sleep_count, rt_tick_t *skipped_tick);
+#endif
+
 /**@}*/
 
 /**
@@ -142,9 +152,16 @@ rt_err_t rt_thread_delay(rt_tick_t tick);
 rt_err_t rt_thread_delay_until(rt_tick_t *tick, rt_tick_t inc_tick);
 rt_err_t rt_thread_mdelay(rt_int32_t ms);
 rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg);
+#ifdef RT_USING_EDF
+rt_err_t rt_thread_edf_wait(void);
+#endif
 rt_err_t rt_thread_suspend(rt_thread_t thread);
 rt_err_t rt_thread_resume(rt_thread_t thread);
 void rt_thread_timeout(void *parameter);
+#ifdef RT_USING_STACK_WATERMARK
+rt_uint32_t rt_thread_stack_usage(rt_thread_t thread);
+void rt_thread_stack_scan(void);
+#endif
 
 #ifdef RT_USING_HOOK
 void rt_thread_suspend_sethook(void (*hook)(rt_thread_t thread));
@@ -172,6 +189,10 @@ void rt_system_scheduler_start(void);
 void rt_schedule(void);
 void rt_schedule_insert_thread(struct rt_thread *thread);
 void rt_schedule_remove_thread(struct rt_thread *thread);
+#ifdef RT_USING_EDF
+rt_err_t rt_schedule_edf_set(struct rt_thread *thread, const struct rt_edf_param *param);
+void rt_schedule_edf_tick(void);
+#endif
 
 void rt_enter_critical(void);
 void rt_exit_critical(void);
@@ -239,6 +260,14 @@ void *rt_page_alloc(rt_size_t npages);
 void rt_page_free(void *addr, rt_size_t npages);
 #endif
 
+#ifdef RT_USING_MEM_CACHE
+void *rt_mem_cache_alloc(rt_size_t *size);
+rt_bool_t rt_mem_cache_free(void *ptr, rt_size_t size);
+void rt_free_list(void *list);
+void rt_mem_cache_detach(rt_thread_t thread);
+void rt_mem_cache_reclaim(void);
+#endif
+
 #ifdef RT_USING_HOOK
 void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size));
 void rt_free_sethook(void (*hook)(void *ptr));
@@ -268,6 +297,10 @@ void rt_memheap_free(void *ptr);
 
 /**@{*/
 
+#ifdef RT_USING_IPC_PRIO_INDEX
+void rt_ipc_prio_remove(struct rt_thread *thread);
+#endif
+
 #ifdef RT_USING_SEMAPHORE
 /*
  * semaphore interface
@@ -336,6 +369,14 @@ rt_err_t rt_mb_send_wait(rt_mailbox_t mb,
                          rt_ubase_t  value,
                          rt_int32_t   timeout);
 rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout);
+rt_size_t rt_mb_send_n(rt_mailbox_t      mb,
+                       const rt_ubase_t *values,
+                       rt_size_t         count,
+                       rt_int32_t        timeout);
+rt_size_t rt_mb_recv_n(rt_mailbox_t mb,
+                       rt_ubase_t  *values,
+                       rt_size_t    count,
+                       rt_int32_t   timeout);
 rt_err_t rt_mb_control(rt_mailbox_t mb, int cmd, void *arg);
 #endif
 
@@ -366,7 +407,98 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
                     void      *buffer,
                     rt_size_t  size,
                     rt_int32_t timeout);
+rt_size_t rt_mq_send_n(rt_mq_t     mq,
+                       const void *buffer,
+                       rt_size_t   size,
+                       rt_size_t   count,
+                       rt_int32_t  timeout);
+rt_size_t rt_mq_recv_n(rt_mq_t    mq,
+                       void      *buffer,
+                       rt_size_t  size,
+                       rt_size_t  count,
+                       rt_int32_t timeout);
 rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg);
+
+#ifdef RT_USING_MEMPOOL
+/*
+ * zero-copy message queue interface
+ */
+rt_err_t rt_mq_init_mp(rt_mq_t     mq,
+                       const char *name,
+                       void       *msgpool,
+                       rt_size_t   pool_size,
+                       rt_mp_t     mp,
+                       rt_uint8_t  flag);
+rt_mq_t rt_mq_create_mp(const char *name,
+                        rt_size_t   max_msgs,
+                        rt_mp_t     mp,
+                        rt_uint8_t  flag);
+
+void *rt_mq_alloc(rt_mq_t mq, rt_int32_t timeout);
+rt_err_t rt_mq_send_ref(rt_mq_t mq, void *block, rt_int32_t timeout);
+rt_err_t rt_mq_recv_ref(rt_mq_t mq, void **block, rt_int32_t timeout);
+#endif
+#endif
+
+#ifdef RT_USING_RINGBUF
+/*
+ * single-producer/single-consumer ring buffer interface
+ */
+rt_err_t rt_ringbuf_init(rt_ringbuf_t rb,
+                         const char  *name,
+                         void        *pool,
+                         rt_size_t    size,
+                         rt_uint8_t   flag);
+rt_err_t rt_ringbuf_detach(rt_ringbuf_t rb);
+rt_ringbuf_t rt_ringbuf_create(const char *name, rt_size_t size, rt_uint8_t flag);
+rt_err_t rt_ringbuf_delete(rt_ringbuf_t rb);
+
+rt_size_t rt_ringbuf_data_len(rt_ringbuf_t rb);
+rt_size_t rt_ringbuf_put(rt_ringbuf_t rb, const void *buffer, rt_size_t size);
+rt_size_t rt_ringbuf_put_wait(rt_ringbuf_t rb,
+                              const void  *buffer,
+                              rt_size_t    size,
+                              rt_int32_t   timeout);
+rt_size_t rt_ringbuf_get(rt_ringbuf_t rb, void *buffer, rt_size_t size);
+rt_size_t rt_ringbuf_get_wait(rt_ringbuf_t rb,
+                              void        *buffer,
+                              rt_size_t    size,
+                              rt_int32_t   timeout);
+
+rt_size_t rt_ringbuf_write_region(rt_ringbuf_t rb, void **ptr);
+void rt_ringbuf_write_commit(rt_ringbuf_t rb, rt_size_t size);
+rt_size_t rt_ringbuf_read_region(rt_ringbuf_t rb, void **ptr);
+void rt_ringbuf_read_commit(rt_ringbuf_t rb, rt_size_t size);
+
+rt_err_t rt_ringbuf_control(rt_ringbuf_t rb, int cmd, void *arg);
+#endif
+
+#ifdef RT_USING_WORKQUEUE
+/*
+ * workqueue interface
+ */
+rt_err_t rt_workqueue_init(rt_workqueue_t queue,
+                           struct rt_thread *thread,
+                           const char *name,
+                           void       *stack,
+                           rt_uint32_t stack_size,
+                           rt_uint8_t  priority);
+#ifdef RT_USING_HEAP
+rt_workqueue_t rt_workqueue_create(const char *name,
+                                   rt_uint32_t stack_size,
+                                   rt_uint8_t  priority);
+#endif
+
+void rt_work_init(struct rt_work *work,
+                  void (*work_func)(struct rt_work *work, void *work_data),
+                  void *work_data);
+rt_err_t rt_work_detach(struct rt_work *work);
+rt_err_t rt_workqueue_submit_work(rt_workqueue_t queue, struct rt_work *work, rt_tick_t time);
+rt_err_t rt_workqueue_cancel_work(rt_workqueue_t queue, struct rt_work *work);
+
+void rt_system_workqueue_init(void);
+rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t time);
+rt_err_t rt_work_cancel(struct rt_work *work);
 #endif
 
 /**@}*/
@@ -413,6 +545,20 @@ rt_size_t rt_device_write(rt_device_t dev,
                           rt_size_t   size);
 rt_err_t  rt_device_control(rt_device_t dev, int cmd, void *arg);
 
+#ifdef RT_USING_DEVICE_ASYNC
+rt_size_t rt_device_read_v (rt_device_t dev,
+                            rt_off_t    pos,
+                            const struct rt_iovec *iov,
+                            int         iovcnt);
+rt_size_t rt_device_write_v(rt_device_t dev,
+                            rt_off_t    pos,
+                            const struct rt_iovec *iov,
+                            int         iovcnt);
+rt_err_t  rt_device_submit(rt_device_t dev, struct rt_device_request *req);
+void      rt_device_request_done(rt_device_t dev, struct rt_device_request *req);
+rt_err_t  rt_device_set_queue_depth(rt_device_t dev, rt_uint8_t depth);
+#endif
+
 /**@}*/
 #endif
 
@@ -436,9 +582,55 @@ void rt_interrupt_enter_sethook(void (*hook)(void));
 void rt_interrupt_leave_sethook(void (*hook)(void));
 #endif
 
+#ifdef RT_USING_TRACE
+/*
+ * kernel trace
+ */
+void rt_trace_record(rt_uint8_t event, rt_uint16_t arg, void *object);
+void rt_trace_start(void);
+void rt_trace_stop(void);
+void rt_trace_clear(void);
+#endif
+
+#ifdef RT_USING_CPU_USAGE
+/*
+ * CPU usage accounting
+ */
+void rt_cpu_usage_account(struct rt_thread *thread);
+void rt_cpu_usage_start(void);
+rt_uint64_t rt_cpu_usage_get(rt_thread_t thread);
+#endif
+
+#ifdef RT_USING_IRQ_LATENCY
+/*
+ * interrupt latency measurement
+ */
+rt_base_t rt_irq_latency_disable(void);
+void rt_irq_latency_enable(rt_base_t level);
+void rt_irq_latency_begin(int span, void *caller);
+void rt_irq_latency_end(int span);
+void rt_irq_latency_reset(void);
+#endif
+
+#ifdef RT_USING_BLOG
+/*
+ * binary log
+ */
+void rt_blog_write(const char *format, rt_uint32_t count, ...);
+void rt_blog_start(void);
+void rt_blog_stop(void);
+void rt_blog_clear(void);
+#endif
+
 #ifdef RT_USING_COMPONENTS_INIT
 void rt_components_init(void);
 void rt_components_board_init(void);
+#ifdef RT_USING_INIT_PARALLEL
+void rt_init_node_register(struct rt_init_node *node);
+rt_err_t rt_init_record_get(rt_uint32_t index, const char **name, rt_uint8_t *stage,
+                            rt_uint32_t *start, rt_uint32_t *time);
+void rt_init_report(void);
+#endif
 #endif
 
 /**
@@ -456,6 +648,16 @@ void rt_components_board_init(void);
 #else
 void rt_kprintf(const char *fmt, ...);
 void rt_kputs(const char *str);
+void rt_console_output(const char *str, rt_size_t length);
+#endif
+
+#if defined(RT_USING_KLOG) && defined(RT_USING_CONSOLE)
+void rt_klog_init(void);
+rt_size_t rt_klog_write(const char *str, rt_size_t length);
+void rt_klog_vprintf(const char *fmt, va_list args);
+void rt_klog(rt_uint8_t level, const char *fmt, ...);
+void rt_klog_set_level(rt_uint8_t level);
+void rt_klog_flush(void);
 #endif
 rt_int32_t rt_vsprintf(char *dest, const char *format, va_list arg_ptr);
 rt_int32_t rt_vsnprintf(char *buf, rt_size_t size, const char *fmt, va_list args);
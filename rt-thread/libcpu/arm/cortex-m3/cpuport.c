@@ -12,6 +12,8 @@
  * 2012-12-29   Bernard     Add exception hook.
  * 2013-07-09   aozima      enhancement hard fault exception handler.
  * 2019-07-03   yangjie     add __rt_ffs() for armclang.
+ * 2026-10-17   weizx208    flush the deferred console log on hard fault.
+ * 2026-10-17   weizx208    add rt_hw_atomic_cas() by LDREX and STREX.
  */
 
 #include <rtthread.h>
@@ -303,6 +305,11 @@ void rt_hw_hard_fault_exception(struct exception_info * exception_info)
             return;
     }
 
+#if defined(RT_USING_KLOG) && defined(RT_USING_CONSOLE)
+    /* the log thread will not run again */
+    rt_klog_flush();
+#endif
+
     rt_kprintf("psr: 0x%08x\n", context->exception_stack_frame.psr);
 
     rt_kprintf("r00: 0x%08x\n", context->exception_stack_frame.r0);
@@ -359,6 +366,54 @@ RT_WEAK void rt_hw_cpu_reset(void)
     SCB_AIRCR = SCB_RESET_VALUE;
 }
 
+/**
+ * This function will compare and swap a word atomically by LDREX and STREX.
+ * The exclusive monitor is cleared on exception entry and return, so the
+ * store fails and it's tried again if it's preempted after the load.
+ *
+ * @param ptr the address of word
+ * @param old the value expected
+ * @param value the value to be stored
+ *
+ * @return RT_TRUE if the word was old and is stored with value
+ */
+#if defined(__CC_ARM)
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t value)
+{
+    do
+    {
+        if (__ldrex(ptr) != old)
+        {
+            __clrex();
+            return RT_FALSE;
+        }
+    } while (__strex(value, ptr) != 0);
+
+    return RT_TRUE;
+}
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t value)
+{
+    do
+    {
+        if (__LDREX((unsigned long *)ptr) != old)
+        {
+            __CLREX();
+            return RT_FALSE;
+        }
+    } while (__STREX(value, (unsigned long *)ptr) != 0);
+
+    return RT_TRUE;
+}
+#elif defined(__GNUC__) || defined(__CLANG_ARM)
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t value)
+{
+    /* it's the loop of LDREX and STREX on ARMv7-M */
+    return __atomic_compare_exchange_n(ptr, &old, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#endif
+
 #ifdef RT_USING_CPU_FFS
 /**
  * This function finds the first bit set (beginning with the least significant bit)
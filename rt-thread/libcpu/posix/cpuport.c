@@ -0,0 +1,358 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ * 2026-10-17     weizx208     unmap the host stack of thread finished
+ */
+
+/*
+ * POSIX host port.
+ *
+ * The kernel runs in one host thread. Each thread has a ucontext and a host
+ * stack, the context is switched by swapcontext(). The interrupts are
+ * simulated: rt_hw_interrupt_raise() marks a vector pending, it's handled at
+ * once if the interrupt is enabled, or when rt_hw_interrupt_enable() enables
+ * it. rt_hw_interrupt_raise() is async-signal-safe, so the BSP raises the
+ * interrupts in signal handlers, such as the tick of setitimer().
+ *
+ * The host C library is not reentrant between threads, because a thread may
+ * be switched out in the middle of a library call. Disable the interrupt
+ * around the library calls which take a lock, such as malloc() and stdio.
+ */
+
+#include <signal.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+
+/* rt_hw_interrupt_disable and rt_hw_interrupt_enable are implemented here */
+#define RT_IRQ_LATENCY_RAW
+
+#include <rthw.h>
+#include <rtthread.h>
+#include "cpuport.h"
+
+#define POSIX_BARRIER()         __asm__ volatile ("" ::: "memory")
+
+struct posix_context
+{
+    ucontext_t context;
+
+    void (*entry)(void *parameter);
+    void *parameter;
+    void (*exit)(void);
+};
+
+/* the thread running, or the thread to be started */
+static struct posix_context *_context_current = RT_NULL;
+/* the thread exited, it's unmapped after it's switched out */
+static struct posix_context *_context_dead = RT_NULL;
+
+/* the interrupt is disabled until the first thread is started */
+static volatile rt_base_t _irq_disabled = 1;
+static volatile rt_uint32_t _irq_pending = 0;
+static volatile rt_uint32_t _irq_unmasked = 0;
+static struct rt_irq_desc _irq_desc[POSIX_IRQ_MAX];
+
+/* the switch requested in interrupt */
+static volatile rt_uint32_t _switch_flag = 0;
+static rt_ubase_t _switch_from, _switch_to;
+
+#define POSIX_CONTEXT_SIZE      (sizeof(struct posix_context) + POSIX_STACK_SIZE)
+
+/* unmap the thread exited, it's invoked with interrupt disabled */
+static void _context_reclaim(void)
+{
+    if (_context_dead != RT_NULL && _context_dead != _context_current)
+    {
+        munmap(_context_dead, POSIX_CONTEXT_SIZE);
+        _context_dead = RT_NULL;
+    }
+}
+
+static void _context_switch(struct posix_context *from, struct posix_context *to)
+{
+    _context_current = to;
+    swapcontext(&(from->context), &(to->context));
+}
+
+/* handle the pending interrupts, it's invoked with the interrupt enabled */
+static void _irq_dispatch(void)
+{
+    int vector;
+    rt_uint32_t pending;
+
+    _irq_disabled = 1;
+    POSIX_BARRIER();
+
+    while ((pending = _irq_pending & _irq_unmasked) != 0)
+    {
+        vector = __builtin_ctz(pending);
+        __atomic_fetch_and(&_irq_pending, ~(1U << vector), __ATOMIC_SEQ_CST);
+
+        rt_interrupt_enter();
+#ifdef RT_USING_INTERRUPT_INFO
+        _irq_desc[vector].counter ++;
+#endif
+        if (_irq_desc[vector].handler != RT_NULL)
+            _irq_desc[vector].handler(vector, _irq_desc[vector].param);
+        rt_interrupt_leave();
+    }
+
+    if (_switch_flag)
+    {
+        _switch_flag = 0;
+        if (_switch_from != _switch_to)
+        {
+            /* the thread interrupted continues from here when it's switched in */
+            _context_switch(*(struct posix_context **)_switch_from,
+                            *(struct posix_context **)_switch_to);
+        }
+    }
+
+#ifdef RT_USING_IRQ_LATENCY
+    /* the thread switched out in rt_schedule() disabled the interrupt */
+    rt_irq_latency_end(RT_IRQ_LATENCY_IRQ_OFF);
+#endif
+    POSIX_BARRIER();
+    _irq_disabled = 0;
+}
+
+static void _irq_check(void)
+{
+    while (!_irq_disabled && (_irq_pending & _irq_unmasked))
+        _irq_dispatch();
+}
+
+static void _thread_start(void)
+{
+    struct posix_context *context = _context_current;
+
+    /* the thread starts with interrupt enabled */
+#ifdef RT_USING_IRQ_LATENCY
+    rt_irq_latency_end(RT_IRQ_LATENCY_IRQ_OFF);
+#endif
+    _irq_disabled = 0;
+    _irq_check();
+
+    context->entry(context->parameter);
+    context->exit();
+}
+
+/**
+ * This function will initialize thread stack. The context and host stack are
+ * mapped in host memory, the stack of thread object is not used. They are
+ * unmapped by rt_hw_stack_free() when the thread is finished.
+ *
+ * @param tentry the entry of thread
+ * @param parameter the parameter of entry
+ * @param stack_addr the beginning stack address
+ * @param texit the function will be called when thread exit
+ *
+ * @return the context of thread, it's saved in the sp of thread
+ */
+rt_uint8_t *rt_hw_stack_init(void       *tentry,
+                             void       *parameter,
+                             rt_uint8_t *stack_addr,
+                             void       *texit)
+{
+    rt_base_t level;
+    void *stack;
+    struct posix_context *context;
+
+    level = rt_hw_interrupt_disable();
+    _context_reclaim();
+    stack = mmap(RT_NULL, POSIX_CONTEXT_SIZE, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    rt_hw_interrupt_enable(level);
+    RT_ASSERT(stack != MAP_FAILED);
+
+    context = (struct posix_context *)stack;
+
+    context->entry     = (void (*)(void *))tentry;
+    context->parameter = parameter;
+    context->exit      = (void (*)(void))texit;
+
+    getcontext(&(context->context));
+    context->context.uc_stack.ss_sp   = (char *)context + sizeof(struct posix_context);
+    context->context.uc_stack.ss_size = POSIX_STACK_SIZE;
+    context->context.uc_link          = RT_NULL;
+    sigemptyset(&(context->context.uc_sigmask));
+    makecontext(&(context->context), _thread_start, 0);
+
+    return (rt_uint8_t *)context;
+}
+
+/**
+ * This function will unmap the context and host stack of the thread exited,
+ * detached or deleted. The thread exiting still runs on them, they are
+ * unmapped after it's switched out.
+ *
+ * @param sp the context returned by rt_hw_stack_init
+ */
+void rt_hw_stack_free(void *sp)
+{
+    rt_base_t level;
+    struct posix_context *context = (struct posix_context *)sp;
+
+    level = rt_hw_interrupt_disable();
+    _context_reclaim();
+    if (context == _context_current)
+        _context_dead = context;
+    else
+        munmap(context, POSIX_CONTEXT_SIZE);
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will disable the simulated interrupt.
+ *
+ * @return the interrupt status before
+ */
+rt_base_t rt_hw_interrupt_disable(void)
+{
+    rt_base_t level;
+
+    level = _irq_disabled;
+    _irq_disabled = 1;
+    POSIX_BARRIER();
+
+    return level;
+}
+
+/**
+ * This function will restore the simulated interrupt, the pending interrupts
+ * are handled when it's enabled.
+ *
+ * @param level the interrupt status returned by rt_hw_interrupt_disable
+ */
+void rt_hw_interrupt_enable(rt_base_t level)
+{
+    POSIX_BARRIER();
+    _irq_disabled = level;
+
+    _irq_check();
+}
+
+void rt_hw_context_switch(rt_ubase_t from, rt_ubase_t to)
+{
+    _context_switch(*(struct posix_context **)from, *(struct posix_context **)to);
+}
+
+void rt_hw_context_switch_interrupt(rt_ubase_t from, rt_ubase_t to)
+{
+    /* the thread interrupted is switched out when the interrupt returns */
+    if (_switch_flag == 0)
+    {
+        _switch_flag = 1;
+        _switch_from = from;
+    }
+    _switch_to = to;
+}
+
+void rt_hw_context_switch_to(rt_ubase_t to)
+{
+    _context_current = *(struct posix_context **)to;
+    setcontext(&(_context_current->context));
+}
+
+/**
+ * This function will initialize the simulated interrupt controller.
+ */
+void rt_hw_interrupt_init(void)
+{
+    rt_memset(_irq_desc, 0, sizeof(_irq_desc));
+    _irq_pending  = 0;
+    _irq_unmasked = 0;
+}
+
+void rt_hw_interrupt_mask(int vector)
+{
+    RT_ASSERT(vector >= 0 && vector < POSIX_IRQ_MAX);
+
+    __atomic_fetch_and(&_irq_unmasked, ~(1U << vector), __ATOMIC_SEQ_CST);
+}
+
+void rt_hw_interrupt_umask(int vector)
+{
+    RT_ASSERT(vector >= 0 && vector < POSIX_IRQ_MAX);
+
+    __atomic_fetch_or(&_irq_unmasked, 1U << vector, __ATOMIC_SEQ_CST);
+    _irq_check();
+}
+
+rt_isr_handler_t rt_hw_interrupt_install(int              vector,
+                                         rt_isr_handler_t handler,
+                                         void            *param,
+                                         const char      *name)
+{
+    rt_base_t level;
+    rt_isr_handler_t old_handler;
+
+    RT_ASSERT(vector >= 0 && vector < POSIX_IRQ_MAX);
+
+    level = rt_hw_interrupt_disable();
+    old_handler = _irq_desc[vector].handler;
+    _irq_desc[vector].handler = handler;
+    _irq_desc[vector].param   = param;
+#ifdef RT_USING_INTERRUPT_INFO
+    rt_strncpy(_irq_desc[vector].name, name, RT_NAME_MAX);
+    _irq_desc[vector].counter = 0;
+#endif
+    rt_hw_interrupt_enable(level);
+
+    return old_handler;
+}
+
+/**
+ * This function will make an interrupt pending. It may be invoked in a signal
+ * handler.
+ *
+ * @param vector the interrupt vector
+ */
+void rt_hw_interrupt_raise(int vector)
+{
+    RT_ASSERT(vector >= 0 && vector < POSIX_IRQ_MAX);
+
+    __atomic_fetch_or(&_irq_pending, 1U << vector, __ATOMIC_SEQ_CST);
+    _irq_check();
+}
+
+/**
+ * This function will compare and swap a word atomically. All the threads run
+ * in one host thread, so it only needs to be atomic to the signals as the
+ * exclusive access on a single core, the bus lock is not needed on x86.
+ *
+ * @param ptr the address of word
+ * @param old the value expected
+ * @param value the value to be stored
+ *
+ * @return RT_TRUE if the word was old and is stored with value
+ */
+rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t value)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    rt_uint8_t result;
+
+    __asm__ __volatile__("cmpxchg %3, %1\n\t"
+                         "sete %0"
+                         : "=q"(result), "+m"(*ptr), "+a"(old)
+                         : "r"(value)
+                         : "memory", "cc");
+
+    return result;
+#else
+    return __atomic_compare_exchange_n(ptr, &old, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+#endif
+}
+
+void rt_hw_cpu_shutdown(void)
+{
+    rt_kprintf("shutdown...\n");
+
+    exit(0);
+}
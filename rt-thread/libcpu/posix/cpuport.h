@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+#ifndef CPUPORT_H__
+#define CPUPORT_H__
+
+#include <rtthread.h>
+
+/* the number of simulated interrupt vectors */
+#define POSIX_IRQ_MAX           32
+
+/* the host stack of each thread, the stack of thread object is not used */
+#ifndef POSIX_STACK_SIZE
+#define POSIX_STACK_SIZE        (256 * 1024)
+#endif
+
+void rt_hw_interrupt_raise(int vector);
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ * 2026-10-17     weizx208     record the words in pointer width
+ */
+
+/*
+ * Binary log.
+ *
+ * RT_BLOG records the address of format string and the raw arguments into a
+ * ring buffer, the string is never formatted in the target. The finsh command
+ * "blog dump" prints the records in hex, and tools/blog_decode.py formats them
+ * with the strings read from the firmware image (the ELF file).
+ *
+ * Each record is (2 + n) words of rt_ubase_t, as wide as a pointer:
+ *     word 0: the address of format string
+ *     word 1: the number of arguments in bits 31 ~ 28, timestamp in bits 27 ~ 0
+ *     word 2 ~: the arguments, cast to rt_ubase_t by RT_BLOG
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_BLOG
+
+#ifndef RT_BLOG_BUF_SIZE
+#define RT_BLOG_BUF_SIZE        1024
+#endif
+
+#if (RT_BLOG_BUF_SIZE & (RT_BLOG_BUF_SIZE - 1)) != 0
+#error "RT_BLOG_BUF_SIZE shall be power of 2"
+#endif
+
+#define BLOG_TIMESTAMP_MASK     0x0fffffff
+
+/* the ring buffer in words, the new record is dropped when it's full */
+static rt_ubase_t _blog_buf[RT_BLOG_BUF_SIZE];
+static volatile rt_uint32_t _blog_in = 0;
+static volatile rt_uint32_t _blog_out = 0;
+static rt_uint32_t _blog_dropped = 0;
+static volatile rt_uint8_t _blog_enable = 1;
+
+/**
+ * @addtogroup Kernel
+ */
+
+/**@{*/
+
+/**
+ * This function will put one record into the binary log. It's invoked by
+ * RT_BLOG, which counts the arguments.
+ *
+ * @param format the format string, it shall be a string literal
+ * @param count the number of arguments, 0 ~ RT_BLOG_ARG_MAX
+ *
+ * @note the arguments shall be rt_ubase_t, as RT_BLOG casts them, so only the
+ *       integer, character and pointer arguments are supported.
+ */
+void rt_blog_write(const char *format, rt_uint32_t count, ...)
+{
+    va_list args;
+    rt_base_t level;
+    rt_uint32_t in, timestamp;
+
+    if (!_blog_enable)
+        return;
+
+    timestamp = rt_timestamp_get();
+
+    level = rt_hw_interrupt_disable();
+
+    in = _blog_in;
+    if (in + 2 + count - _blog_out > RT_BLOG_BUF_SIZE)
+    {
+        _blog_dropped ++;
+        rt_hw_interrupt_enable(level);
+
+        return;
+    }
+
+    _blog_buf[in ++ & (RT_BLOG_BUF_SIZE - 1)] = (rt_ubase_t)format;
+    _blog_buf[in ++ & (RT_BLOG_BUF_SIZE - 1)] = (count << 28) |
+                                                 (timestamp & BLOG_TIMESTAMP_MASK);
+    va_start(args, count);
+    while (count --)
+    {
+        _blog_buf[in ++ & (RT_BLOG_BUF_SIZE - 1)] = va_arg(args, rt_ubase_t);
+    }
+    va_end(args);
+    _blog_in = in;
+
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will start recording binary log.
+ */
+void rt_blog_start(void)
+{
+    _blog_enable = 1;
+}
+
+/**
+ * This function will stop recording binary log.
+ */
+void rt_blog_stop(void)
+{
+    _blog_enable = 0;
+}
+
+/**
+ * This function will drop all the records in binary log.
+ */
+void rt_blog_clear(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    _blog_out = _blog_in;
+    _blog_dropped = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void _blog_dump(void)
+{
+    rt_uint8_t enable;
+    rt_uint8_t type;
+    rt_uint32_t index, count, in;
+    rt_list_t *node;
+    struct rt_object *object;
+    struct rt_object_information *info;
+
+    /* stop recording while the buffer is printed */
+    enable = _blog_enable;
+    _blog_enable = 0;
+
+    in = _blog_in;
+
+    /* the header: version, timestamp frequency, words, dropped records, word size */
+    rt_kprintf("# rt-blog 2 %u %u %u %u\n", rt_timestamp_get_frequency(), in - _blog_out,
+               _blog_dropped, (rt_uint32_t)sizeof(rt_ubase_t));
+
+    /* the name of objects, which are the arguments of "%s" usually */
+    for (type = RT_Object_Class_Thread; type < RT_Object_Class_Unknown; type ++)
+    {
+        info = rt_object_get_information((enum rt_object_class_type)type);
+        if (info == RT_NULL)
+            continue;
+
+        rt_enter_critical();
+        for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+        {
+            object = rt_list_entry(node, struct rt_object, list);
+            rt_kprintf("O %p %.*s\n", object->name, RT_NAME_MAX, object->name);
+        }
+        rt_exit_critical();
+    }
+
+    /* the records are removed after they are printed */
+    while (_blog_out != in)
+    {
+        index = _blog_out;
+        count = (_blog_buf[(index + 1) & (RT_BLOG_BUF_SIZE - 1)] >> 28) & 0x0f;
+
+        /* the words are printed in pointer width */
+        rt_kprintf("L %p %08x", (void *)_blog_buf[index & (RT_BLOG_BUF_SIZE - 1)],
+                   (rt_uint32_t)(_blog_buf[(index + 1) & (RT_BLOG_BUF_SIZE - 1)] & BLOG_TIMESTAMP_MASK));
+        for (index += 2; count > 0; count --, index ++)
+        {
+            rt_kprintf(" %p", (void *)_blog_buf[index & (RT_BLOG_BUF_SIZE - 1)]);
+        }
+        rt_kprintf("\n");
+
+        _blog_out = index;
+    }
+    _blog_dropped = 0;
+
+    _blog_enable = enable;
+}
+
+static int blog(int argc, char **argv)
+{
+    if (argc == 2 && !rt_strcmp(argv[1], "start"))
+    {
+        rt_blog_start();
+    }
+    else if (argc == 2 && !rt_strcmp(argv[1], "stop"))
+    {
+        rt_blog_stop();
+    }
+    else if (argc == 2 && !rt_strcmp(argv[1], "clear"))
+    {
+        rt_blog_clear();
+    }
+    else if (argc == 2 && !rt_strcmp(argv[1], "dump"))
+    {
+        _blog_dump();
+    }
+    else
+    {
+        rt_kprintf("Usage: blog start|stop|clear|dump\n");
+        rt_kprintf("buffer: %d/%d words, dropped: %d, recording: %s\n",
+                   _blog_in - _blog_out, RT_BLOG_BUF_SIZE, _blog_dropped,
+                   _blog_enable ? "yes" : "no");
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(blog, binary log);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_BLOG */
@@ -13,6 +13,11 @@
  * 2010-07-13     Bernard      fix rt_tick_from_millisecond issue found by kuronca
  * 2011-06-26     Bernard      add rt_tick_set function.
  * 2018-11-22     Jesven       add per cpu tick
+ * 2026-10-17     weizx208     add tickless idle
+ * 2026-10-17     weizx208     charge the budget of earliest deadline first job
+ * 2026-10-17     weizx208     add timestamp source of kernel
+ * 2026-10-17     weizx208     sleep only if the idle thread is the only one ready
+ * 2026-10-17     weizx208     exclude tickless sleep from interrupt latency
  */
 
 #include <rthw.h>
@@ -20,6 +25,33 @@
 
 static rt_tick_t rt_tick = 0;
 
+static rt_uint32_t _timestamp_tick_get(void);
+
+/* the timestamp of trace, CPU usage, benchmark and the other statistics */
+static rt_uint32_t (*_timestamp)(void) = _timestamp_tick_get;
+static rt_uint32_t _timestamp_frequency = RT_TICK_PER_SECOND;
+
+#ifdef RT_USING_TICKLESS
+#ifndef RT_TICKLESS_THRESHOLD
+#define RT_TICKLESS_THRESHOLD   2
+#endif
+
+extern rt_list_t rt_thread_priority_table[RT_THREAD_PRIORITY_MAX];
+extern rt_uint32_t rt_thread_ready_priority_group;
+#if RT_THREAD_PRIORITY_MAX > 32
+extern rt_uint8_t rt_thread_ready_table[32];
+#endif
+
+static const struct rt_tickless_ops *_tickless_ops = RT_NULL;
+static rt_uint32_t _tickless_sleep_count = 0;
+static rt_tick_t _tickless_skipped_tick = 0;
+#endif
+
+static rt_uint32_t _timestamp_tick_get(void)
+{
+    return rt_tick;
+}
+
 /**
  * This function will initialize system tick and set it to zero.
  * @ingroup SystemInit
@@ -84,10 +116,131 @@ void rt_tick_increase(void)
         rt_thread_yield();
     }
 
+#ifdef RT_USING_EDF
+    /* charge the budget of job */
+    rt_schedule_edf_tick();
+#endif
+
     /* check timer */
     rt_timer_check();
 }
 
+#ifdef RT_USING_TICKLESS
+/* check that no thread is ready except the idle thread, the current one */
+static rt_bool_t _tickless_idle_only(void)
+{
+    rt_thread_t idle;
+    rt_list_t *list;
+    rt_ubase_t highest;
+#if RT_THREAD_PRIORITY_MAX > 32
+    rt_ubase_t number;
+
+    number  = __rt_ffs(rt_thread_ready_priority_group) - 1;
+    highest = (number << 3) + __rt_ffs(rt_thread_ready_table[number]) - 1;
+#else
+    highest = __rt_ffs(rt_thread_ready_priority_group) - 1;
+#endif
+
+    idle = rt_thread_self();
+    if (highest != idle->current_priority)
+        return RT_FALSE;
+
+    /* the other threads of idle priority */
+    list = &rt_thread_priority_table[highest];
+
+    return (list->next == &(idle->tlist) && list->prev == &(idle->tlist)) ? RT_TRUE : RT_FALSE;
+}
+
+/**
+ * This function will register the tick source operations for tickless idle.
+ *
+ * @param ops the tick source operations, RT_NULL to disable tickless idle
+ */
+void rt_tickless_register(const struct rt_tickless_ops *ops)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    _tickless_ops = ops;
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will stop the periodic tick until the next timer expires,
+ * and then add the ticks passed in sleep to system tick at once. Normally,
+ * this function is invoked by idle thread.
+ */
+void rt_tickless_enter(void)
+{
+    rt_base_t level;
+    rt_tick_t timeout, passed;
+
+    level = rt_hw_interrupt_disable();
+
+    /* tickless is not supported, or there are other threads ready */
+    if (_tickless_ops == RT_NULL || !_tickless_idle_only())
+    {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    timeout = rt_timer_next_timeout_tick();
+    if (timeout != RT_TICK_MAX)
+    {
+        timeout = timeout - rt_tick;
+        if (timeout >= RT_TICK_MAX / 2)
+        {
+            /* the timer has been timeout */
+            timeout = 0;
+        }
+    }
+
+    if (timeout < RT_TICKLESS_THRESHOLD)
+    {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    _tickless_ops->timer_start(timeout);
+    /*
+     * the sleep waits for the interrupt, it's not a latency of interrupt. The
+     * interrupt disabled span ends before it and restarts after it, it's the
+     * outermost span as idle thread invokes this function with interrupt
+     * enabled.
+     */
+    RT_IRQ_LATENCY_END(RT_IRQ_LATENCY_IRQ_OFF);
+    if (_tickless_ops->sleep != RT_NULL)
+        _tickless_ops->sleep();
+    RT_IRQ_LATENCY_BEGIN(RT_IRQ_LATENCY_IRQ_OFF, rt_tickless_enter);
+    passed = _tickless_ops->timer_stop();
+
+    /* add the ticks passed in sleep at once */
+    rt_tick += passed;
+    _tickless_sleep_count ++;
+    _tickless_skipped_tick += passed;
+
+    rt_hw_interrupt_enable(level);
+
+    /* handle the timers which are timeout in sleep */
+    if (passed > 0)
+        rt_timer_check();
+}
+
+/**
+ * This function will return the statistics of tickless idle.
+ *
+ * @param sleep_count the times of entering tickless sleep
+ * @param skipped_tick the tick interrupts avoided in tickless sleep
+ */
+void rt_tickless_info(rt_uint32_t *sleep_count, rt_tick_t *skipped_tick)
+{
+    if (sleep_count != RT_NULL)
+        *sleep_count = _tickless_sleep_count;
+    if (skipped_tick != RT_NULL)
+        *skipped_tick = _tickless_skipped_tick;
+}
+#endif
+
 /**
  * This function will calculate the tick from millisecond.
  *
@@ -116,5 +269,56 @@ rt_tick_t rt_tick_from_millisecond(rt_int32_t ms)
     return tick;
 }
 
+/**
+ * This function will set the timestamp source of kernel, which is used by the
+ * trace, CPU usage, benchmark and the other statistics. The system tick is
+ * used by default, the BSP shall set a cycle counter before
+ * rt_components_board_init().
+ *
+ * @param timestamp the function to get a free running 32 bits counter, it
+ *        shall not wrap around between two interrupts of system tick
+ * @param frequency the frequency of counter
+ */
+void rt_timestamp_set(rt_uint32_t (*timestamp)(void), rt_uint32_t frequency)
+{
+    rt_base_t level;
+
+    RT_ASSERT(timestamp != RT_NULL);
+    RT_ASSERT(frequency != 0);
+
+    level = rt_hw_interrupt_disable();
+    _timestamp           = timestamp;
+    _timestamp_frequency = frequency;
+#ifdef RT_USING_CPU_USAGE
+    /* the time before is in the unit of old source */
+    rt_cpu_usage_start();
+#endif
+    rt_hw_interrupt_enable(level);
+
+#ifdef RT_USING_IRQ_LATENCY
+    rt_irq_latency_reset();
+#endif
+}
+
+/**
+ * This function will return the timestamp of kernel.
+ *
+ * @return the free running counter set by rt_timestamp_set()
+ */
+rt_uint32_t rt_timestamp_get(void)
+{
+    return _timestamp();
+}
+
+/**
+ * This function will return the frequency of kernel timestamp.
+ *
+ * @return the frequency in Hz
+ */
+rt_uint32_t rt_timestamp_get_frequency(void)
+{
+    return _timestamp_frequency;
+}
+
 /**@}*/
 
@@ -15,6 +15,8 @@
  *                             in some IDEs.
  * 2015-07-29     Arda.Fu      Add support to use RT_USING_USER_MAIN with IAR
  * 2018-11-22     Jesven       Add secondary cpu boot up
+ * 2026-10-17     weizx208     Add staged and parallel initialization with timing
+ * 2026-10-17     weizx208     Initialize system workqueue
  */
 
 #include <rthw.h>
@@ -77,12 +79,420 @@ static int rti_end(void)
 }
 INIT_EXPORT(rti_end, "6.end");
 
+#ifdef RT_USING_INIT_PARALLEL
+/*
+ * Staged and parallel initialization.
+ *
+ * Each level is a stage, the stage runs the functions exported by INIT_EXPORT
+ * one by one, and then the nodes exported by INIT_NODE_EXPORT concurrently in
+ * RT_INIT_WORKERS threads, a node starts after the nodes it depends on. The
+ * next stage starts after all nodes of this stage are done. The nodes of
+ * board level run in the caller one by one, because the scheduler is not
+ * started yet.
+ *
+ * Each function and node is timed, see rt_init_report() and finsh command
+ * "initstat".
+ */
+static int rti_prev_end(void)
+{
+    return 0;
+}
+INIT_EXPORT(rti_prev_end, "2.end");
+
+static int rti_device_end(void)
+{
+    return 0;
+}
+INIT_EXPORT(rti_device_end, "3.end");
+
+static int rti_component_end(void)
+{
+    return 0;
+}
+INIT_EXPORT(rti_component_end, "4.end");
+
+static int rti_env_end(void)
+{
+    return 0;
+}
+INIT_EXPORT(rti_env_end, "5.end");
+
+#ifndef RT_INIT_WORKERS
+#define RT_INIT_WORKERS             2
+#endif
+#ifndef RT_INIT_WORKER_STACK_SIZE
+#define RT_INIT_WORKER_STACK_SIZE   1024
+#endif
+#ifndef RT_INIT_RECORD_MAX
+#define RT_INIT_RECORD_MAX          32
+#endif
+
+#if RT_DEBUG_INIT
+typedef const struct rt_init_desc rti_entry_t;
+#define RTI_ENTRY(fn)               (&__rt_init_desc_##fn)
+#define RTI_FN(entry)               ((entry)->fn)
+#define RTI_NAME(entry)             ((entry)->fn_name)
+#else
+typedef volatile const init_fn_t rti_entry_t;
+#define RTI_ENTRY(fn)               (&__rt_init_##fn)
+#define RTI_FN(entry)               (*(entry))
+#define RTI_NAME(entry)             RT_NULL
+#endif
+
+#define RTI_NODE_PENDING            0
+#define RTI_NODE_RUNNING            1
+#define RTI_NODE_DONE               2
+
+/* the time of a function or node, worker 0 is the caller */
+struct rti_record
+{
+    const char *name;
+    init_fn_t   fn;
+    rt_uint8_t  stage;
+    rt_uint8_t  worker;
+    int         result;
+    rt_uint32_t start;
+    rt_uint32_t time;
+};
+
+static rt_uint32_t rti_boot_stamp;
+
+static struct rti_record rti_records[RT_INIT_RECORD_MAX];
+static rt_uint32_t rti_record_count;
+/* the wall time of each stage, and the time of all functions and nodes */
+static rt_uint32_t rti_stage_wall[7], rti_stage_sum[7];
+
+static struct rt_init_node *rti_node_list;
+static rt_uint8_t rti_stage;
+static rt_uint8_t rti_registered;
+
+/* the nodes of the stage in progress */
+static rt_uint32_t rti_remaining, rti_running, rti_waiting;
+static struct rt_semaphore rti_wake;
+
+#if RT_INIT_WORKERS > 1
+static struct rt_semaphore rti_exit;
+static struct rt_thread rti_workers[RT_INIT_WORKERS - 1];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t rti_worker_stacks[RT_INIT_WORKERS - 1][RT_INIT_WORKER_STACK_SIZE];
+#endif
+
+static void rti_record(const char *name, init_fn_t fn, int worker,
+                       int result, rt_uint32_t start, rt_uint32_t end)
+{
+    struct rti_record *record;
+
+    rt_enter_critical();
+    rti_stage_sum[rti_stage] += end - start;
+    if (rti_record_count < RT_INIT_RECORD_MAX)
+    {
+        record = &rti_records[rti_record_count ++];
+        record->name   = name;
+        record->fn     = fn;
+        record->stage  = rti_stage;
+        record->worker = worker;
+        record->result = result;
+        record->start  = start - rti_boot_stamp;
+        record->time   = end - start;
+    }
+    rt_exit_critical();
+}
+
+/* whether the nodes depended are done, the unknown one is ignored */
+static rt_bool_t rti_node_ready(struct rt_init_node *node)
+{
+    const char *name, *end;
+    struct rt_init_node *depend;
+
+    for (name = node->depends; name != RT_NULL && *name != '\0'; name = end)
+    {
+        for (end = name; *end != '\0' && *end != ','; end ++);
+
+        for (depend = rti_node_list; depend != RT_NULL; depend = depend->next)
+        {
+            if (rt_strncmp(depend->name, name, end - name) == 0 &&
+                depend->name[end - name] == '\0')
+            {
+                if (depend->state != RTI_NODE_DONE)
+                    return RT_FALSE;
+                break;
+            }
+        }
+
+        if (*end == ',')
+            end ++;
+    }
+
+    return RT_TRUE;
+}
+
+static struct rt_init_node *rti_node_pick(void)
+{
+    struct rt_init_node *node;
+
+    for (node = rti_node_list; node != RT_NULL; node = node->next)
+    {
+        if (node->level == rti_stage && node->state == RTI_NODE_PENDING &&
+            rti_node_ready(node))
+        {
+            return node;
+        }
+    }
+
+    return RT_NULL;
+}
+
+static void rti_node_work(int worker)
+{
+    int result;
+    rt_uint32_t start;
+    struct rt_init_node *node;
+
+    while (1)
+    {
+        rt_enter_critical();
+        node = rti_node_pick();
+        if (node == RT_NULL)
+        {
+            if (rti_remaining == 0)
+            {
+                rt_exit_critical();
+                break;
+            }
+
+            if (rti_running != 0)
+            {
+                /* wait until a node is done */
+                rti_waiting ++;
+                rt_exit_critical();
+                rt_sem_take(&rti_wake, RT_WAITING_FOREVER);
+                continue;
+            }
+
+            /* the nodes depend on each other, run one to break it */
+            for (node = rti_node_list; node != RT_NULL; node = node->next)
+            {
+                if (node->level == rti_stage && node->state == RTI_NODE_PENDING)
+                    break;
+            }
+            rt_kprintf("init node %s: dependency can't be satisfied\n", node->name);
+        }
+        node->state = RTI_NODE_RUNNING;
+        rti_running ++;
+        rt_exit_critical();
+
+        start  = rt_timestamp_get();
+        result = node->fn();
+        rti_record(node->name, node->fn, worker, result, start, rt_timestamp_get());
+
+        rt_enter_critical();
+        node->state = RTI_NODE_DONE;
+        rti_running --;
+        rti_remaining --;
+        for (; rti_waiting > 0; rti_waiting --)
+            rt_sem_release(&rti_wake);
+        rt_exit_critical();
+    }
+}
+
+#if RT_INIT_WORKERS > 1
+static void rti_worker_entry(void *parameter)
+{
+    rti_node_work((int)(rt_ubase_t)parameter);
+    rt_sem_release(&rti_exit);
+}
+#endif
+
+/* run the nodes registered in this stage */
+static void rti_node_run(void)
+{
+    struct rt_init_node *node;
+#if RT_INIT_WORKERS > 1
+    int index, workers;
+#endif
+
+    rti_remaining = rti_running = rti_waiting = 0;
+    for (node = rti_node_list; node != RT_NULL; node = node->next)
+    {
+        if (node->level == rti_stage)
+            rti_remaining ++;
+    }
+    if (rti_remaining == 0)
+        return;
+
+    /* the caller is one of workers, the others work after the scheduler starts */
+#if RT_INIT_WORKERS > 1
+    workers = 1;
+    if (rt_thread_self() != RT_NULL)
+        workers = (rti_remaining < RT_INIT_WORKERS) ? rti_remaining : RT_INIT_WORKERS;
+
+    /* the semaphores are only used among workers, a single one never waits */
+    if (workers > 1)
+    {
+        rt_sem_init(&rti_wake, "rtiwake", 0, RT_IPC_FLAG_FIFO);
+        rt_sem_init(&rti_exit, "rtiexit", 0, RT_IPC_FLAG_FIFO);
+        for (index = 1; index < workers; index ++)
+        {
+            rt_thread_init(&rti_workers[index - 1], "rti", rti_worker_entry,
+                           (void *)(rt_ubase_t)index, rti_worker_stacks[index - 1],
+                           RT_INIT_WORKER_STACK_SIZE, rt_thread_self()->current_priority, 10);
+            rt_thread_startup(&rti_workers[index - 1]);
+        }
+    }
+#endif
+
+    rti_node_work(0);
+
+#if RT_INIT_WORKERS > 1
+    if (workers > 1)
+    {
+        for (index = 1; index < workers; index ++)
+            rt_sem_take(&rti_exit, RT_WAITING_FOREVER);
+
+        /* the thread object is detached when it exits, then it can be initialized again */
+        for (index = 1; index < workers; index ++)
+        {
+            while ((rti_workers[index - 1].stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+                rt_thread_yield();
+        }
+        rt_sem_detach(&rti_exit);
+        rt_sem_detach(&rti_wake);
+    }
+#endif
+}
+
+static void rti_stage_run(int stage, rti_entry_t *begin, rti_entry_t *end)
+{
+    int result;
+    rt_uint32_t stage_start, start;
+    rti_entry_t *entry;
+
+    rti_stage = stage;
+    stage_start = rt_timestamp_get();
+    /* the first one is the end of previous stage */
+    for (entry = begin + 1; entry < end; entry ++)
+    {
+#if RT_DEBUG_INIT
+        rt_kprintf("initialize %s", RTI_NAME(entry));
+#endif
+        rti_registered = 0;
+        start  = rt_timestamp_get();
+        result = RTI_FN(entry)();
+        /* the registration of node is not timed */
+        if (!rti_registered)
+            rti_record(RTI_NAME(entry), RTI_FN(entry), 0, result, start, rt_timestamp_get());
+#if RT_DEBUG_INIT
+        rt_kprintf(":%d done\n", result);
+#endif
+    }
+
+    rti_node_run();
+    rti_stage_wall[stage] = rt_timestamp_get() - stage_start;
+}
+
+/**
+ * This function will register an initialization node, it's invoked by the
+ * function exported by INIT_NODE_EXPORT.
+ *
+ * @param node the initialization node
+ */
+void rt_init_node_register(struct rt_init_node *node)
+{
+    struct rt_init_node **tail;
+
+    RT_ASSERT(node != RT_NULL);
+
+    node->level = rti_stage;
+    node->state = RTI_NODE_PENDING;
+    node->next  = RT_NULL;
+    for (tail = &rti_node_list; *tail != RT_NULL; tail = &((*tail)->next));
+    *tail = node;
+
+    rti_registered = 1;
+}
+
+/**
+ * This function will get the time of an initialization function or node.
+ *
+ * @param index the index of record, in the order of finish
+ * @param name the name of node, or the function name if RT_DEBUG_INIT is
+ *        enabled, otherwise RT_NULL
+ * @param stage the level of initialization
+ * @param start the time from board initialization to start, in microseconds
+ * @param time the time of running, in microseconds
+ *
+ * @return RT_EOK, or -RT_ERROR if there is no such record
+ */
+rt_err_t rt_init_record_get(rt_uint32_t index, const char **name, rt_uint8_t *stage,
+                            rt_uint32_t *start, rt_uint32_t *time)
+{
+    if (index >= rti_record_count)
+        return -RT_ERROR;
+
+    *name  = rti_records[index].name;
+    *stage = rti_records[index].stage;
+    *start = (rt_uint32_t)((rt_uint64_t)rti_records[index].start * 1000000 / rt_timestamp_get_frequency());
+    *time  = (rt_uint32_t)((rt_uint64_t)rti_records[index].time * 1000000 / rt_timestamp_get_frequency());
+
+    return RT_EOK;
+}
+
+/**
+ * This function will print the time of each initialization function and
+ * node, and the time of each stage.
+ */
+void rt_init_report(void)
+{
+    int stage;
+    rt_uint32_t index;
+    struct rti_record *record;
+
+    rt_kprintf("stage worker  start(us)   time(us) result name\n");
+    rt_kprintf("----- ------ ---------- ---------- ------ ----\n");
+    for (index = 0; index < rti_record_count; index ++)
+    {
+        record = &rti_records[index];
+        rt_kprintf("%5d %6d %10d %10d %6d ", record->stage, record->worker,
+                   (rt_uint32_t)((rt_uint64_t)record->start * 1000000 / rt_timestamp_get_frequency()),
+                   (rt_uint32_t)((rt_uint64_t)record->time * 1000000 / rt_timestamp_get_frequency()),
+                   record->result);
+        if (record->name != RT_NULL)
+            rt_kprintf("%s\n", record->name);
+        else
+            rt_kprintf("0x%p\n", record->fn);
+    }
+
+    /* the saving of parallel initialization is the sum minus the wall time */
+    for (stage = 1; stage < 7; stage ++)
+    {
+        rt_kprintf("stage %d: wall %d us, sum %d us\n", stage,
+                   (rt_uint32_t)((rt_uint64_t)rti_stage_wall[stage] * 1000000 / rt_timestamp_get_frequency()),
+                   (rt_uint32_t)((rt_uint64_t)rti_stage_sum[stage] * 1000000 / rt_timestamp_get_frequency()));
+    }
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static int initstat(void)
+{
+    rt_init_report();
+
+    return 0;
+}
+MSH_CMD_EXPORT(initstat, show the time of components initialization);
+#endif /* RT_USING_FINSH */
+#endif /* RT_USING_INIT_PARALLEL */
+
 /**
  * RT-Thread Components Initialization for board
  */
 void rt_components_board_init(void)
 {
-#if RT_DEBUG_INIT
+#ifdef RT_USING_INIT_PARALLEL
+    rti_boot_stamp = rt_timestamp_get();
+    rti_stage_run(1, RTI_ENTRY(rti_board_start), RTI_ENTRY(rti_board_end));
+#elif RT_DEBUG_INIT
     int result;
     const struct rt_init_desc *desc;
     for (desc = &__rt_init_desc_rti_board_start; desc < &__rt_init_desc_rti_board_end; desc ++)
@@ -106,7 +516,19 @@ void rt_components_board_init(void)
  */
 void rt_components_init(void)
 {
+#ifdef RT_USING_INIT_PARALLEL
 #if RT_DEBUG_INIT
+    rt_kprintf("do components initialization.\n");
+#endif
+    rti_stage_run(2, RTI_ENTRY(rti_board_end), RTI_ENTRY(rti_prev_end));
+    rti_stage_run(3, RTI_ENTRY(rti_prev_end), RTI_ENTRY(rti_device_end));
+    rti_stage_run(4, RTI_ENTRY(rti_device_end), RTI_ENTRY(rti_component_end));
+    rti_stage_run(5, RTI_ENTRY(rti_component_end), RTI_ENTRY(rti_env_end));
+    rti_stage_run(6, RTI_ENTRY(rti_env_end), RTI_ENTRY(rti_end));
+#if RT_DEBUG_INIT
+    rt_init_report();
+#endif
+#elif RT_DEBUG_INIT
     int result;
     const struct rt_init_desc *desc;
 
@@ -234,6 +656,16 @@ int rtthread_startup(void)
     /* timer thread initialization */
     rt_system_timer_thread_init();
 
+#ifdef RT_USING_WORKQUEUE
+    /* system workqueue initialization */
+    rt_system_workqueue_init();
+#endif
+
+#if defined(RT_USING_KLOG) && defined(RT_USING_CONSOLE)
+    /* deferred console log thread initialization */
+    rt_klog_init();
+#endif
+
     /* idle thread initialization */
     rt_thread_idle_init();
 
@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * CPU usage accounting.
+ *
+ * The time between two switches is charged to the thread switched out by
+ * rt_schedule(), to the thread interrupted by rt_interrupt_enter(), or to the
+ * interrupts by rt_interrupt_leave() of the outermost interrupt. Only the
+ * timestamp is read and added at each switch, the usage is calculated by the
+ * reader, such as finsh command "top".
+ *
+ * The system tick is the timestamp by default, the BSP shall set a cycle
+ * counter by rt_timestamp_set() to see the threads run shorter than
+ * a tick.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_CPU_USAGE
+
+extern volatile rt_uint8_t rt_interrupt_nest;
+
+/* the timestamp of last accounting, and the time of interrupts */
+static rt_uint32_t _cpu_usage_stamp;
+static rt_uint64_t _cpu_usage_irq_time;
+
+/**
+ * @addtogroup Kernel
+ */
+
+/**@{*/
+
+/**
+ * This function will charge the time since last accounting to a thread or
+ * the interrupts. It's invoked by the scheduler and interrupt with interrupt
+ * disabled.
+ *
+ * @param thread the thread to be charged, RT_NULL for the interrupts
+ *
+ * @note please don't invoke this routine in application
+ */
+void rt_cpu_usage_account(struct rt_thread *thread)
+{
+    rt_uint32_t now;
+
+    now = rt_timestamp_get();
+    if (thread != RT_NULL)
+        thread->run_time += now - _cpu_usage_stamp;
+    else
+        _cpu_usage_irq_time += now - _cpu_usage_stamp;
+    _cpu_usage_stamp = now;
+}
+
+/**
+ * This function will start the accounting, the time before is not charged.
+ * It's invoked when the scheduler is started or the timestamp source is
+ * changed.
+ *
+ * @note please don't invoke this routine in application
+ */
+void rt_cpu_usage_start(void)
+{
+    _cpu_usage_stamp = rt_timestamp_get();
+}
+
+/**
+ * This function will get the run time of a thread or the interrupts, in the
+ * unit of timestamp.
+ *
+ * @param thread the thread, RT_NULL for the interrupts
+ *
+ * @return the run time
+ */
+rt_uint64_t rt_cpu_usage_get(rt_thread_t thread)
+{
+    rt_base_t level;
+    rt_uint64_t time;
+
+    level = rt_hw_interrupt_disable();
+    time = (thread != RT_NULL) ? thread->run_time : _cpu_usage_irq_time;
+
+    /* the time not charged yet belongs to the running one */
+    if ((rt_interrupt_nest != 0 && thread == RT_NULL) ||
+        (rt_interrupt_nest == 0 && thread == rt_thread_self()))
+    {
+        time += rt_timestamp_get() - _cpu_usage_stamp;
+    }
+    rt_hw_interrupt_enable(level);
+
+    return time;
+}
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#ifndef RT_CPU_USAGE_TOP_THREADS
+#define RT_CPU_USAGE_TOP_THREADS    32
+#endif
+
+struct _top_entry
+{
+    rt_thread_t thread;
+    rt_uint64_t time;
+    rt_uint64_t delta;
+    rt_uint8_t  priority;
+    char        name[RT_NAME_MAX];
+};
+
+/* the snapshots at the beginning and end of window */
+static struct _top_entry _top_first[RT_CPU_USAGE_TOP_THREADS];
+static struct _top_entry _top_last[RT_CPU_USAGE_TOP_THREADS];
+static int _top_first_count, _top_last_count;
+static rt_uint64_t _top_first_irq, _top_last_irq;
+
+static int _top_snapshot(struct _top_entry *entry, rt_uint64_t *irq)
+{
+    int count;
+    rt_list_t *node;
+    struct rt_thread *thread;
+    struct rt_object_information *info;
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+
+    /* the scheduler is locked so that the thread is not deleted */
+    rt_enter_critical();
+    count = 0;
+    for (node = info->object_list.next;
+         node != &(info->object_list) && count < RT_CPU_USAGE_TOP_THREADS;
+         node = node->next)
+    {
+        thread = rt_list_entry(node, struct rt_thread, list);
+
+        entry[count].thread   = thread;
+        entry[count].time     = rt_cpu_usage_get(thread);
+        entry[count].priority = thread->current_priority;
+        rt_strncpy(entry[count].name, thread->name, RT_NAME_MAX);
+        count ++;
+    }
+    *irq = rt_cpu_usage_get(RT_NULL);
+    rt_exit_critical();
+
+    return count;
+}
+
+static void _top_print(rt_int32_t period)
+{
+    int index, first, max;
+    rt_uint64_t total, delta;
+
+    /* the time of each thread in window, a new thread starts from 0 */
+    total = _top_last_irq - _top_first_irq;
+    for (index = 0; index < _top_last_count; index ++)
+    {
+        delta = _top_last[index].time;
+        for (first = 0; first < _top_first_count; first ++)
+        {
+            if (_top_first[first].thread == _top_last[index].thread &&
+                _top_first[first].time <= delta)
+            {
+                delta -= _top_first[first].time;
+                break;
+            }
+        }
+
+        _top_last[index].delta = delta;
+        total += delta;
+    }
+    if (total == 0)
+        total = 1;
+
+    rt_kprintf("window %d ms, interrupt %d.%d%%\n", period,
+               (int)((_top_last_irq - _top_first_irq) * 1000 / total / 10),
+               (int)((_top_last_irq - _top_first_irq) * 1000 / total % 10));
+    rt_kprintf("%-*.s pri    cpu\n", RT_NAME_MAX, "thread");
+    for (index = 0; index < RT_NAME_MAX; index ++)
+        rt_kprintf("-");
+    rt_kprintf(" --- ------\n");
+
+    /* print the busiest thread first */
+    for (first = 0; first < _top_last_count; first ++)
+    {
+        max = first;
+        for (index = first + 1; index < _top_last_count; index ++)
+        {
+            if (_top_last[index].delta > _top_last[max].delta)
+                max = index;
+        }
+
+        delta = _top_last[max].delta * 1000 / total;
+        rt_kprintf("%-*.*s %3d %3d.%d%%\n", RT_NAME_MAX, RT_NAME_MAX, _top_last[max].name,
+                   _top_last[max].priority, (int)(delta / 10), (int)(delta % 10));
+
+        if (max != first)
+        {
+            struct _top_entry entry;
+
+            entry = _top_last[first];
+            _top_last[first] = _top_last[max];
+            _top_last[max] = entry;
+        }
+    }
+}
+
+static rt_int32_t _top_number(const char *str)
+{
+    rt_int32_t value;
+
+    for (value = 0; *str >= '0' && *str <= '9'; str ++)
+        value = value * 10 + (*str - '0');
+
+    return value;
+}
+
+static int top(int argc, char **argv)
+{
+    rt_int32_t period, times;
+
+    period = (argc > 1) ? _top_number(argv[1]) : 1000;
+    times  = (argc > 2) ? _top_number(argv[2]) : 1;
+    if (argc > 3 || period <= 0 || times <= 0)
+    {
+        rt_kprintf("Usage: top [window ms] [times]\n");
+
+        return 0;
+    }
+
+    /* the windows are consecutive, the end of one is the beginning of next */
+    _top_last_count = _top_snapshot(_top_last, &_top_last_irq);
+    while (times --)
+    {
+        rt_memcpy(_top_first, _top_last, sizeof(_top_first));
+        _top_first_count = _top_last_count;
+        _top_first_irq   = _top_last_irq;
+
+        rt_thread_mdelay(period);
+
+        _top_last_count = _top_snapshot(_top_last, &_top_last_irq);
+        _top_print(period);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(top, show the CPU usage of threads in consecutive windows);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_CPU_USAGE */
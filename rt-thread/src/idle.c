@@ -15,6 +15,8 @@
  * 2018-07-14     armink       add idle hook list
  * 2018-11-22     Jesven       add per cpu idle task
  *                             combine the code of primary and secondary cpu
+ * 2026-10-17     weizx208     add tickless idle
+ * 2026-10-17     weizx208     scan the stack watermark of threads
  */
 
 #include <rthw.h>
@@ -172,6 +174,11 @@ void rt_thread_idle_excute(void)
         rt_object_delete((rt_object_t)thread);
         rt_hw_interrupt_enable(lock);
     }
+
+#ifdef RT_USING_MEM_CACHE
+    /* release the cached memory of closed threads */
+    rt_mem_cache_reclaim();
+#endif
 #endif
 }
 
@@ -194,8 +201,14 @@ static void rt_thread_idle_entry(void *parameter)
 #endif
 
         rt_thread_idle_excute();
+#ifdef RT_USING_STACK_WATERMARK
+        rt_thread_stack_scan();
+#endif
 #ifdef RT_USING_PM
         rt_system_power_manager();
+#endif
+#ifdef RT_USING_TICKLESS
+        rt_tickless_enter();
 #endif
     }
 }
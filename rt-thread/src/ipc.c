@@ -37,6 +37,12 @@
  * 2020-07-29     Meco Man     fix thread->event_set/event_info when received an
  *                             event without pending
  * 2020-10-11     Meco Man     add value overflow-check code
+ * 2026-10-17     weizx208     add trace of thread block and wake
+ * 2026-10-17     weizx208     add single-producer/single-consumer ring buffer
+ * 2026-10-17     weizx208     add zero-copy message queue on memory pool
+ * 2026-10-17     weizx208     add batched send and receive of mailbox and message queue
+ * 2026-10-17     weizx208     add priority index of suspended thread list
+ * 2026-10-17     weizx208     add fast path of mutex without contention
  */
 
 #include <rtthread.h>
@@ -48,12 +54,100 @@ extern void (*rt_object_take_hook)(struct rt_object *object);
 extern void (*rt_object_put_hook)(struct rt_object *object);
 #endif
 
+#ifdef RT_USING_IPC_PRIO_INDEX
+#if RT_THREAD_PRIORITY_MAX > 32
+#error "RT_USING_IPC_PRIO_INDEX supports 32 priorities at most"
+#endif
+
+/* the index of the most significant set bit of a non-zero value */
+#if defined(__CC_ARM)
+#define _rt_ipc_fls(value)      (31 - (int)__clz(value))
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+#define _rt_ipc_fls(value)      (31 - (int)__CLZ(value))
+#elif defined(__GNUC__) || defined(__CLANG_ARM)
+#define _rt_ipc_fls(value)      (31 - __builtin_clz(value))
+#else
+static int _rt_ipc_fls(rt_uint32_t value)
+{
+    int bit = 31;
+
+    while (!(value & 0x80000000UL))
+    {
+        value <<= 1;
+        bit --;
+    }
+
+    return bit;
+}
+#endif
+
+#define _RT_IPC_INDEX(index)    (index)
+#else
+#define _RT_IPC_INDEX(index)    RT_NULL
+
+struct rt_ipc_prio_index;
+#endif
+
 /**
  * @addtogroup IPC
  */
 
 /**@{*/
 
+#ifdef RT_USING_IPC_PRIO_INDEX
+/**
+ * This function will initialize the priority index of a suspended thread list.
+ *
+ * @param index the priority index
+ * @param list the suspended thread list
+ */
+rt_inline void rt_ipc_prio_index_init(struct rt_ipc_prio_index *index, rt_list_t *list)
+{
+    index->list  = list;
+    index->group = 0;
+    rt_memset(index->tail, 0, sizeof(index->tail));
+}
+
+/**
+ * This function will insert a thread behind the suspended threads of the same
+ * or higher priority, the position is found by the index in constant time.
+ *
+ * @param index the priority index of suspended thread list
+ * @param thread the thread object to be inserted
+ */
+rt_inline void rt_ipc_prio_insert(struct rt_ipc_prio_index *index, struct rt_thread *thread)
+{
+    rt_uint8_t priority;
+    rt_uint32_t higher;
+    rt_list_t *position;
+
+    priority = thread->current_priority;
+
+    if (index->tail[priority] != RT_NULL)
+    {
+        /* behind the last thread of the same priority */
+        position = &(index->tail[priority]->tlist);
+    }
+    else
+    {
+        /* behind the last thread of the nearest higher priority */
+        higher = index->group & ((1UL << priority) - 1);
+        if (higher != 0)
+            position = &(index->tail[_rt_ipc_fls(higher)]->tlist);
+        else
+            position = index->list;
+    }
+    rt_list_insert_after(position, &(thread->tlist));
+
+    index->tail[priority] = thread;
+    index->group |= 1UL << priority;
+
+    thread->wait_index    = index;
+    thread->wait_priority = priority;
+}
+#endif
+
 /**
  * This function will initialize an IPC object
  *
@@ -66,6 +160,10 @@ rt_inline rt_err_t rt_ipc_object_init(struct rt_ipc_object *ipc)
     /* initialize ipc object */
     rt_list_init(&(ipc->suspend_thread));
 
+#ifdef RT_USING_IPC_PRIO_INDEX
+    rt_ipc_prio_index_init(&(ipc->suspend_index), &(ipc->suspend_thread));
+#endif
+
     return RT_EOK;
 }
 
@@ -74,16 +172,20 @@ rt_inline rt_err_t rt_ipc_object_init(struct rt_ipc_object *ipc)
  * double-queue object (mailbox etc.) contains this kind of list.
  *
  * @param list the IPC suspended thread list
+ * @param index the priority index of list, RT_NULL if it's not indexed
  * @param thread the thread object to be suspended
  * @param flag the IPC object flag,
  *        which shall be RT_IPC_FLAG_FIFO/RT_IPC_FLAG_PRIO.
  *
  * @return the operation status, RT_EOK on successful
  */
-rt_inline rt_err_t rt_ipc_list_suspend(rt_list_t        *list,
-                                       struct rt_thread *thread,
-                                       rt_uint8_t        flag)
+rt_inline rt_err_t rt_ipc_list_suspend(rt_list_t                *list,
+                                       struct rt_ipc_prio_index *index,
+                                       struct rt_thread         *thread,
+                                       rt_uint8_t                flag)
 {
+    RT_TRACE_RECORD(RT_TRACE_IPC_BLOCK, thread->current_priority, thread);
+
     /* suspend thread */
     rt_thread_suspend(thread);
 
@@ -94,6 +196,13 @@ rt_inline rt_err_t rt_ipc_list_suspend(rt_list_t        *list,
         break;
 
     case RT_IPC_FLAG_PRIO:
+#ifdef RT_USING_IPC_PRIO_INDEX
+        if (index != RT_NULL)
+        {
+            rt_ipc_prio_insert(index, thread);
+            break;
+        }
+#endif
         {
             struct rt_list_node *n;
             struct rt_thread *sthread;
@@ -145,6 +254,7 @@ rt_inline rt_err_t rt_ipc_list_resume(rt_list_t *list)
     thread = rt_list_entry(list->next, struct rt_thread, tlist);
 
     RT_DEBUG_LOG(RT_DEBUG_IPC, ("resume thread:%s\n", thread->name));
+    RT_TRACE_RECORD(RT_TRACE_IPC_WAKE, thread->current_priority, thread);
 
     /* resume it */
     rt_thread_resume(thread);
@@ -152,6 +262,25 @@ rt_inline rt_err_t rt_ipc_list_resume(rt_list_t *list)
     return RT_EOK;
 }
 
+/**
+ * This function will resume the first threads in the list of a IPC object,
+ * it's used when a number of resources are available at once.
+ *
+ * @param list the thread list
+ * @param count the maximum number of threads to resume
+ *
+ * @return the number of resumed threads
+ */
+rt_inline rt_size_t rt_ipc_list_resume_n(rt_list_t *list, rt_size_t count)
+{
+    rt_size_t resumed;
+
+    for (resumed = 0; resumed < count && !rt_list_isempty(list); resumed ++)
+        rt_ipc_list_resume(list);
+
+    return resumed;
+}
+
 /**
  * This function will resume all suspended threads in a list, including
  * suspend list of IPC object and private list of mailbox etc.
@@ -175,6 +304,7 @@ rt_inline rt_err_t rt_ipc_list_resume_all(rt_list_t *list)
         thread = rt_list_entry(list->next, struct rt_thread, tlist);
         /* set error code to RT_ERROR */
         thread->error = -RT_ERROR;
+        RT_TRACE_RECORD(RT_TRACE_IPC_WAKE, thread->current_priority, thread);
 
         /*
          * resume thread
@@ -190,6 +320,49 @@ rt_inline rt_err_t rt_ipc_list_resume_all(rt_list_t *list)
     return RT_EOK;
 }
 
+#ifdef RT_USING_IPC_PRIO_INDEX
+/**
+ * This function will update the priority index when a thread is removed from
+ * a suspended thread list. It shall be invoked before the thread is removed.
+ *
+ * @param thread the thread object to be removed
+ */
+void rt_ipc_prio_remove(struct rt_thread *thread)
+{
+    struct rt_ipc_prio_index *index;
+    struct rt_thread *prev;
+    register rt_base_t temp;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    index = thread->wait_index;
+    if (index != RT_NULL)
+    {
+        if (index->tail[thread->wait_priority] == thread)
+        {
+            /* the previous thread is the new tail if it's in the same priority */
+            prev = RT_NULL;
+            if (thread->tlist.prev != index->list)
+            {
+                prev = rt_list_entry(thread->tlist.prev, struct rt_thread, tlist);
+                if (prev->wait_priority != thread->wait_priority)
+                    prev = RT_NULL;
+            }
+
+            index->tail[thread->wait_priority] = prev;
+            if (prev == RT_NULL)
+                index->group &= ~(1UL << thread->wait_priority);
+        }
+
+        thread->wait_index = RT_NULL;
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+}
+#endif
+
 #ifdef RT_USING_SEMAPHORE
 /**
  * This function will initialize a semaphore and put it under control of
@@ -376,6 +549,7 @@ rt_err_t rt_sem_take(rt_sem_t sem, rt_int32_t time)
 
             /* suspend thread */
             rt_ipc_list_suspend(&(sem->parent.suspend_thread),
+                                _RT_IPC_INDEX(&(sem->parent.suspend_index)),
                                 thread,
                                 sem->parent.parent.flag);
 
@@ -525,6 +699,71 @@ rt_err_t rt_sem_control(rt_sem_t sem, int cmd, void *arg)
 #endif /* end of RT_USING_SEMAPHORE */
 
 #ifdef RT_USING_MUTEX
+#ifdef RT_USING_MUTEX_FAST
+/*
+ * The lock word of mutex is 0 if the mutex is free, or the owner if it's
+ * taken by compare-and-swap without contention, and the other fields are
+ * left as free. Once a thread finds it taken, by the owner again or another
+ * thread, the mutex is moved to the slow path with interrupt disabled: the
+ * fields are set as if the owner took it there, and the lock word stays
+ * RT_MUTEX_LOCK_SLOW until the mutex is free again. So the priority
+ * inheritance is the same as before.
+ *
+ * The original priority is the one of owner when it takes the mutex, which
+ * is published in the mutex just after the lock word. Before that, it's kept
+ * in the thread with the mutex being taken, in case the owner is preempted
+ * and the mutex is contended in between. A mutex is released without
+ * contention only if the owner is at the original priority, otherwise it's
+ * restored in the slow path.
+ */
+
+/**
+ * This function will compare and swap a word atomically, it's replaced by
+ * the port of CPU with the instructions of exclusive access.
+ *
+ * @param ptr the address of word
+ * @param old the value expected
+ * @param value the value to be stored
+ *
+ * @return RT_TRUE if the word was old and is stored with value
+ */
+RT_WEAK rt_bool_t rt_hw_atomic_cas(volatile rt_ubase_t *ptr, rt_ubase_t old, rt_ubase_t value)
+{
+    rt_base_t level;
+    rt_bool_t result;
+
+    level = rt_hw_interrupt_disable();
+    result = (*ptr == old);
+    if (result)
+        *ptr = value;
+    rt_hw_interrupt_enable(level);
+
+    return result;
+}
+
+/* move the mutex to the slow path, it's invoked with interrupt disabled */
+static void _rt_mutex_slow(rt_mutex_t mutex)
+{
+    struct rt_thread *owner;
+
+    if (mutex->lock == RT_MUTEX_LOCK_SLOW)
+        return;
+
+    owner = (struct rt_thread *)mutex->lock;
+    if (owner != RT_NULL)
+    {
+        mutex->value = 0;
+        mutex->owner = owner;
+        mutex->hold  = 1;
+
+        /* the owner isn't back to publish its original priority */
+        if (owner->mutex_taking == mutex)
+            mutex->original_priority = owner->mutex_taking_priority;
+    }
+    mutex->lock = RT_MUTEX_LOCK_SLOW;
+}
+#endif
+
 /**
  * This function will initialize a mutex and put it under control of resource
  * management.
@@ -550,6 +789,9 @@ rt_err_t rt_mutex_init(rt_mutex_t mutex, const char *name, rt_uint8_t flag)
     mutex->owner = RT_NULL;
     mutex->original_priority = 0xFF;
     mutex->hold  = 0;
+#ifdef RT_USING_MUTEX_FAST
+    mutex->lock  = 0;
+#endif
 
     /* set flag */
     mutex->parent.parent.flag = flag;
@@ -611,6 +853,9 @@ rt_mutex_t rt_mutex_create(const char *name, rt_uint8_t flag)
     mutex->owner              = RT_NULL;
     mutex->original_priority  = 0xFF;
     mutex->hold               = 0;
+#ifdef RT_USING_MUTEX_FAST
+    mutex->lock               = 0;
+#endif
 
     /* set flag */
     mutex->parent.parent.flag = flag;
@@ -670,10 +915,32 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
     /* get current thread */
     thread = rt_thread_self();
 
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
+
+#ifdef RT_USING_MUTEX_FAST
+    /* take it without contention */
+    thread->mutex_taking          = mutex;
+    thread->mutex_taking_priority = thread->current_priority;
+    if (rt_hw_atomic_cas(&(mutex->lock), 0, (rt_ubase_t)thread))
+    {
+        /* publish the original priority */
+        mutex->original_priority = thread->mutex_taking_priority;
+        thread->mutex_taking     = RT_NULL;
+
+        thread->error = RT_EOK;
+        RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mutex->parent.parent)));
+
+        return RT_EOK;
+    }
+    thread->mutex_taking = RT_NULL;
+#endif
+
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
-    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mutex->parent.parent)));
+#ifdef RT_USING_MUTEX_FAST
+    _rt_mutex_slow(mutex);
+#endif
 
     RT_DEBUG_LOG(RT_DEBUG_IPC,
                  ("mutex_take: current thread %s, mutex value: %d, hold: %d\n",
@@ -748,6 +1015,7 @@ rt_err_t rt_mutex_take(rt_mutex_t mutex, rt_int32_t time)
 
                 /* suspend current thread */
                 rt_ipc_list_suspend(&(mutex->parent.suspend_thread),
+                                    _RT_IPC_INDEX(&(mutex->parent.suspend_index)),
                                     thread,
                                     mutex->parent.parent.flag);
 
@@ -820,15 +1088,26 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
     /* get current thread */
     thread = rt_thread_self();
 
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mutex->parent.parent)));
+
+#ifdef RT_USING_MUTEX_FAST
+    /* release it without contention, no priority to be restored */
+    if (thread->current_priority == mutex->original_priority &&
+        rt_hw_atomic_cas(&(mutex->lock), (rt_ubase_t)thread, 0))
+        return RT_EOK;
+#endif
+
     /* disable interrupt */
     temp = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_MUTEX_FAST
+    _rt_mutex_slow(mutex);
+#endif
+
     RT_DEBUG_LOG(RT_DEBUG_IPC,
                  ("mutex_release:current thread %s, mutex value: %d, hold: %d\n",
                   thread->name, mutex->value, mutex->hold));
 
-    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mutex->parent.parent)));
-
     /* mutex only can be released by owner */
     if (thread != mutex->owner)
     {
@@ -898,6 +1177,10 @@ rt_err_t rt_mutex_release(rt_mutex_t mutex)
             /* clear owner */
             mutex->owner             = RT_NULL;
             mutex->original_priority = 0xff;
+#ifdef RT_USING_MUTEX_FAST
+            /* back to the fast path */
+            mutex->lock              = 0;
+#endif
         }
     }
 
@@ -1124,6 +1407,7 @@ rt_err_t rt_event_send(rt_event_t event, rt_uint32_t set)
                     event->set &= ~thread->event_set;
 
                 /* resume thread, and thread list breaks out */
+                RT_TRACE_RECORD(RT_TRACE_IPC_WAKE, thread->current_priority, thread);
                 rt_thread_resume(thread);
 
                 /* need do a scheduling */
@@ -1235,6 +1519,7 @@ rt_err_t rt_event_recv(rt_event_t   event,
 
         /* put thread to suspended thread list */
         rt_ipc_list_suspend(&(event->parent.suspend_thread),
+                            _RT_IPC_INDEX(&(event->parent.suspend_index)),
                             thread,
                             event->parent.parent.flag);
 
@@ -1355,6 +1640,9 @@ rt_err_t rt_mb_init(rt_mailbox_t mb,
 
     /* initialize an additional list of sender suspend thread */
     rt_list_init(&(mb->suspend_sender_thread));
+#ifdef RT_USING_IPC_PRIO_INDEX
+    rt_ipc_prio_index_init(&(mb->suspend_sender_index), &(mb->suspend_sender_thread));
+#endif
 
     return RT_EOK;
 }
@@ -1427,6 +1715,9 @@ rt_mailbox_t rt_mb_create(const char *name, rt_size_t size, rt_uint8_t flag)
 
     /* initialize an additional list of sender suspend thread */
     rt_list_init(&(mb->suspend_sender_thread));
+#ifdef RT_USING_IPC_PRIO_INDEX
+    rt_ipc_prio_index_init(&(mb->suspend_sender_index), &(mb->suspend_sender_thread));
+#endif
 
     return mb;
 }
@@ -1521,6 +1812,7 @@ rt_err_t rt_mb_send_wait(rt_mailbox_t mb,
         RT_DEBUG_IN_THREAD_CONTEXT;
         /* suspend current thread */
         rt_ipc_list_suspend(&(mb->suspend_sender_thread),
+                            _RT_IPC_INDEX(&(mb->suspend_sender_index)),
                             thread,
                             mb->parent.parent.flag);
 
@@ -1676,6 +1968,7 @@ rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout)
         RT_DEBUG_IN_THREAD_CONTEXT;
         /* suspend current thread */
         rt_ipc_list_suspend(&(mb->parent.suspend_thread),
+                            _RT_IPC_INDEX(&(mb->parent.suspend_index)),
                             thread,
                             mb->parent.parent.flag);
 
@@ -1759,122 +2052,454 @@ rt_err_t rt_mb_recv(rt_mailbox_t mb, rt_ubase_t *value, rt_int32_t timeout)
 }
 
 /**
- * This function can get or set some extra attributions of a mailbox object.
+ * This function will send a number of mails to mailbox object. The mails are
+ * put into the free slots in one pass, and the waiting receivers are waked up
+ * once for each pass. If the mailbox is full, current thread will be suspended
+ * until timeout.
  *
  * @param mb the mailbox object
- * @param cmd the execution command
- * @param arg the execution argument
+ * @param values the mails
+ * @param count the number of mails
+ * @param timeout the waiting time
  *
- * @return the error code
+ * @return the number of mails which are sent, the error code is saved in the
+ *         errno of thread when it's less than count.
  */
-rt_err_t rt_mb_control(rt_mailbox_t mb, int cmd, void *arg)
+rt_size_t rt_mb_send_n(rt_mailbox_t      mb,
+                       const rt_ubase_t *values,
+                       rt_size_t         count,
+                       rt_int32_t        timeout)
 {
-    rt_ubase_t level;
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    rt_uint32_t tick_delta;
+    rt_size_t sent, length, index;
 
     /* parameter check */
     RT_ASSERT(mb != RT_NULL);
     RT_ASSERT(rt_object_get_type(&mb->parent.parent) == RT_Object_Class_MailBox);
+    RT_ASSERT(values != RT_NULL || count == 0);
 
-    if (cmd == RT_IPC_CMD_RESET)
+    /* initialize delta tick */
+    tick_delta = 0;
+    sent = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mb->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    while (sent < count)
     {
-        /* disable interrupt */
-        level = rt_hw_interrupt_disable();
+        /* mailbox is full */
+        if (mb->entry == mb->size)
+        {
+            /* reset error number in thread */
+            thread->error = RT_EOK;
 
-        /* resume all waiting thread */
-        rt_ipc_list_resume_all(&(mb->parent.suspend_thread));
-        /* also resume all mailbox private suspended thread */
-        rt_ipc_list_resume_all(&(mb->suspend_sender_thread));
+            /* no waiting, return full */
+            if (timeout == 0)
+            {
+                /* enable interrupt */
+                rt_hw_interrupt_enable(temp);
 
-        /* re-init mailbox */
-        mb->entry      = 0;
-        mb->in_offset  = 0;
-        mb->out_offset = 0;
+                thread->error = -RT_EFULL;
 
-        /* enable interrupt */
-        rt_hw_interrupt_enable(level);
+                return sent;
+            }
 
-        rt_schedule();
+            RT_DEBUG_IN_THREAD_CONTEXT;
+            /* suspend current thread */
+            rt_ipc_list_suspend(&(mb->suspend_sender_thread),
+                                _RT_IPC_INDEX(&(mb->suspend_sender_index)),
+                                thread,
+                                mb->parent.parent.flag);
 
-        return RT_EOK;
-    }
+            /* has waiting time, start thread timer */
+            if (timeout > 0)
+            {
+                /* get the start tick of timer */
+                tick_delta = rt_tick_get();
 
-    return -RT_ERROR;
-}
-#endif /* end of RT_USING_MAILBOX */
+                RT_DEBUG_LOG(RT_DEBUG_IPC, ("mb_send_n: start timer of thread:%s\n",
+                                            thread->name));
 
-#ifdef RT_USING_MESSAGEQUEUE
-struct rt_mq_message
-{
-    struct rt_mq_message *next;
-};
+                /* reset the timeout of thread timer and start it */
+                rt_timer_control(&(thread->thread_timer),
+                                 RT_TIMER_CTRL_SET_TIME,
+                                 &timeout);
+                rt_timer_start(&(thread->thread_timer));
+            }
 
-/**
- * This function will initialize a message queue and put it under control of
- * resource management.
- *
- * @param mq the message object
- * @param name the name of message queue
- * @param msgpool the beginning address of buffer to save messages
- * @param msg_size the maximum size of message
- * @param pool_size the size of buffer to save messages
- * @param flag the flag of message queue
- *
- * @return the operation status, RT_EOK on successful
- */
-rt_err_t rt_mq_init(rt_mq_t     mq,
-                    const char *name,
-                    void       *msgpool,
-                    rt_size_t   msg_size,
-                    rt_size_t   pool_size,
-                    rt_uint8_t  flag)
-{
-    struct rt_mq_message *head;
-    register rt_base_t temp;
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
 
-    /* parameter check */
-    RT_ASSERT(mq != RT_NULL);
+            /* re-schedule */
+            rt_schedule();
 
-    /* initialize object */
-    rt_object_init(&(mq->parent.parent), RT_Object_Class_MessageQueue, name);
+            /* resume from suspend state */
+            if (thread->error != RT_EOK)
+                return sent;
 
-    /* set parent flag */
-    mq->parent.parent.flag = flag;
+            /* disable interrupt */
+            temp = rt_hw_interrupt_disable();
 
-    /* initialize ipc object */
-    rt_ipc_object_init(&(mq->parent));
+            /* if it's not waiting forever and then re-calculate timeout tick */
+            if (timeout > 0)
+            {
+                tick_delta = rt_tick_get() - tick_delta;
+                timeout -= tick_delta;
+                if (timeout < 0)
+                    timeout = 0;
+            }
 
-    /* set message pool */
-    mq->msg_pool = msgpool;
+            continue;
+        }
 
-    /* get correct message size */
-    mq->msg_size = RT_ALIGN(msg_size, RT_ALIGN_SIZE);
-    mq->max_msgs = pool_size / (mq->msg_size + sizeof(struct rt_mq_message));
+        /* fill the free slots */
+        length = mb->size - mb->entry;
+        if (length > count - sent)
+            length = count - sent;
+        for (index = 0; index < length; index ++)
+        {
+            mb->msg_pool[mb->in_offset] = values[sent ++];
+            /* increase input offset */
+            ++ mb->in_offset;
+            if (mb->in_offset >= mb->size)
+                mb->in_offset = 0;
+        }
+        /* increase message entry */
+        mb->entry += length;
 
-    /* initialize message list */
-    mq->msg_queue_head = RT_NULL;
-    mq->msg_queue_tail = RT_NULL;
+        /* resume suspended thread, one for each mail at most */
+        if (rt_ipc_list_resume_n(&(mb->parent.suspend_thread), length) != 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
 
-    /* initialize message empty list */
-    mq->msg_queue_free = RT_NULL;
-    for (temp = 0; temp < mq->max_msgs; temp ++)
-    {
-        head = (struct rt_mq_message *)((rt_uint8_t *)mq->msg_pool +
-                                        temp * (mq->msg_size + sizeof(struct rt_mq_message)));
-        head->next = (struct rt_mq_message *)mq->msg_queue_free;
-        mq->msg_queue_free = head;
-    }
+            rt_schedule();
 
-    /* the initial entry is zero */
-    mq->entry = 0;
+            /* disable interrupt */
+            temp = rt_hw_interrupt_disable();
+        }
+    }
 
-    /* initialize an additional list of sender suspend thread */
-    rt_list_init(&(mq->suspend_sender_thread));
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
 
-    return RT_EOK;
+    return sent;
 }
 
 /**
- * This function will detach a message queue object from resource management
+ * This function will receive a number of mails from mailbox object. All the
+ * mails in mailbox are taken in one pass, up to count. If there is no mail in
+ * mailbox object, the thread shall wait for a specified time.
+ *
+ * @param mb the mailbox object
+ * @param values the received mails will be saved in
+ * @param count the maximum number of mails
+ * @param timeout the waiting time
+ *
+ * @return the number of mails which are received, the error code is saved in
+ *         the errno of thread when it's zero.
+ */
+rt_size_t rt_mb_recv_n(rt_mailbox_t mb,
+                       rt_ubase_t  *values,
+                       rt_size_t    count,
+                       rt_int32_t   timeout)
+{
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    rt_uint32_t tick_delta;
+    rt_size_t length, index, resumed;
+
+    /* parameter check */
+    RT_ASSERT(mb != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mb->parent.parent) == RT_Object_Class_MailBox);
+    RT_ASSERT(values != RT_NULL);
+
+    if (count == 0)
+        return 0;
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mb->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* mailbox is empty */
+    while (mb->entry == 0)
+    {
+        /* reset error number in thread */
+        thread->error = RT_EOK;
+
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            thread->error = -RT_ETIMEOUT;
+
+            return 0;
+        }
+
+        RT_DEBUG_IN_THREAD_CONTEXT;
+        /* suspend current thread */
+        rt_ipc_list_suspend(&(mb->parent.suspend_thread),
+                            _RT_IPC_INDEX(&(mb->parent.suspend_index)),
+                            thread,
+                            mb->parent.parent.flag);
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("mb_recv_n: start timer of thread:%s\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* resume from suspend state */
+        if (thread->error != RT_EOK)
+            return 0;
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    /* take the mails */
+    length = mb->entry;
+    if (length > count)
+        length = count;
+    for (index = 0; index < length; index ++)
+    {
+        values[index] = mb->msg_pool[mb->out_offset];
+        /* increase output offset */
+        ++ mb->out_offset;
+        if (mb->out_offset >= mb->size)
+            mb->out_offset = 0;
+    }
+    /* decrease message entry */
+    mb->entry -= length;
+
+    /* resume suspended thread, one for each free slot at most */
+    resumed = rt_ipc_list_resume_n(&(mb->suspend_sender_thread), length);
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mb->parent.parent)));
+
+    if (resumed != 0)
+        rt_schedule();
+
+    return length;
+}
+
+/**
+ * This function can get or set some extra attributions of a mailbox object.
+ *
+ * @param mb the mailbox object
+ * @param cmd the execution command
+ * @param arg the execution argument
+ *
+ * @return the error code
+ */
+rt_err_t rt_mb_control(rt_mailbox_t mb, int cmd, void *arg)
+{
+    rt_ubase_t level;
+
+    /* parameter check */
+    RT_ASSERT(mb != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mb->parent.parent) == RT_Object_Class_MailBox);
+
+    if (cmd == RT_IPC_CMD_RESET)
+    {
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        /* resume all waiting thread */
+        rt_ipc_list_resume_all(&(mb->parent.suspend_thread));
+        /* also resume all mailbox private suspended thread */
+        rt_ipc_list_resume_all(&(mb->suspend_sender_thread));
+
+        /* re-init mailbox */
+        mb->entry      = 0;
+        mb->in_offset  = 0;
+        mb->out_offset = 0;
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
+    return -RT_ERROR;
+}
+#endif /* end of RT_USING_MAILBOX */
+
+#ifdef RT_USING_MESSAGEQUEUE
+struct rt_mq_message
+{
+    struct rt_mq_message *next;
+};
+
+#ifdef RT_USING_MEMPOOL
+/*
+ * This function will return the blocks which are still in a zero-copy
+ * message queue to its memory pool.
+ */
+static void _rt_mq_release_ref(rt_mq_t mq)
+{
+    register rt_ubase_t temp;
+    struct rt_mq_message *msg;
+    void *block;
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    while (mq->msg_queue_head != RT_NULL)
+    {
+        /* get message from queue */
+        msg = (struct rt_mq_message *)mq->msg_queue_head;
+
+        /* move message queue head */
+        mq->msg_queue_head = msg->next;
+        /* reach queue tail, set to NULL */
+        if (mq->msg_queue_tail == msg)
+            mq->msg_queue_tail = RT_NULL;
+
+        if (mq->entry > 0)
+            mq->entry --;
+
+        /* the message holds the pointer of block */
+        block = *(void **)(msg + 1);
+
+        /* put message to free list */
+        msg->next = (struct rt_mq_message *)mq->msg_queue_free;
+        mq->msg_queue_free = msg;
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* the waiting thread of memory pool may be resumed */
+        rt_mp_free(block);
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+}
+#endif
+
+/**
+ * This function will initialize a message queue and put it under control of
+ * resource management.
+ *
+ * @param mq the message object
+ * @param name the name of message queue
+ * @param msgpool the beginning address of buffer to save messages
+ * @param msg_size the maximum size of message
+ * @param pool_size the size of buffer to save messages
+ * @param flag the flag of message queue
+ *
+ * @return the operation status, RT_EOK on successful
+ */
+rt_err_t rt_mq_init(rt_mq_t     mq,
+                    const char *name,
+                    void       *msgpool,
+                    rt_size_t   msg_size,
+                    rt_size_t   pool_size,
+                    rt_uint8_t  flag)
+{
+    struct rt_mq_message *head;
+    register rt_base_t temp;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+
+    /* initialize object */
+    rt_object_init(&(mq->parent.parent), RT_Object_Class_MessageQueue, name);
+
+    /* set parent flag */
+    mq->parent.parent.flag = flag;
+
+    /* initialize ipc object */
+    rt_ipc_object_init(&(mq->parent));
+
+    /* set message pool */
+    mq->msg_pool = msgpool;
+
+    /* get correct message size */
+    mq->msg_size = RT_ALIGN(msg_size, RT_ALIGN_SIZE);
+    mq->max_msgs = pool_size / (mq->msg_size + sizeof(struct rt_mq_message));
+
+    /* initialize message list */
+    mq->msg_queue_head = RT_NULL;
+    mq->msg_queue_tail = RT_NULL;
+
+    /* initialize message empty list */
+    mq->msg_queue_free = RT_NULL;
+    for (temp = 0; temp < mq->max_msgs; temp ++)
+    {
+        head = (struct rt_mq_message *)((rt_uint8_t *)mq->msg_pool +
+                                        temp * (mq->msg_size + sizeof(struct rt_mq_message)));
+        head->next = (struct rt_mq_message *)mq->msg_queue_free;
+        mq->msg_queue_free = head;
+    }
+
+    /* the initial entry is zero */
+    mq->entry = 0;
+
+    /* initialize an additional list of sender suspend thread */
+    rt_list_init(&(mq->suspend_sender_thread));
+#ifdef RT_USING_IPC_PRIO_INDEX
+    rt_ipc_prio_index_init(&(mq->suspend_sender_index), &(mq->suspend_sender_thread));
+#endif
+
+#ifdef RT_USING_MEMPOOL
+    /* copying message queue */
+    mq->msg_mp = RT_NULL;
+#endif
+
+    return RT_EOK;
+}
+
+/**
+ * This function will detach a message queue object from resource management
  *
  * @param mq the message queue object
  *
@@ -1892,6 +2517,12 @@ rt_err_t rt_mq_detach(rt_mq_t mq)
     /* also resume all message queue private suspended thread */
     rt_ipc_list_resume_all(&(mq->suspend_sender_thread));
 
+#ifdef RT_USING_MEMPOOL
+    /* release the blocks of zero-copy message queue */
+    if (mq->msg_mp != RT_NULL)
+        _rt_mq_release_ref(mq);
+#endif
+
     /* detach message queue object */
     rt_object_detach(&(mq->parent.parent));
 
@@ -1965,6 +2596,14 @@ rt_mq_t rt_mq_create(const char *name,
 
     /* initialize an additional list of sender suspend thread */
     rt_list_init(&(mq->suspend_sender_thread));
+#ifdef RT_USING_IPC_PRIO_INDEX
+    rt_ipc_prio_index_init(&(mq->suspend_sender_index), &(mq->suspend_sender_thread));
+#endif
+
+#ifdef RT_USING_MEMPOOL
+    /* copying message queue */
+    mq->msg_mp = RT_NULL;
+#endif
 
     return mq;
 }
@@ -1990,6 +2629,12 @@ rt_err_t rt_mq_delete(rt_mq_t mq)
     /* also resume all message queue private suspended thread */
     rt_ipc_list_resume_all(&(mq->suspend_sender_thread));
 
+#ifdef RT_USING_MEMPOOL
+    /* release the blocks of zero-copy message queue */
+    if (mq->msg_mp != RT_NULL)
+        _rt_mq_release_ref(mq);
+#endif
+
     /* free message queue pool */
     RT_KERNEL_FREE(mq->msg_pool);
 
@@ -2070,6 +2715,7 @@ rt_err_t rt_mq_send_wait(rt_mq_t     mq,
         RT_DEBUG_IN_THREAD_CONTEXT;
         /* suspend current thread */
         rt_ipc_list_suspend(&(mq->suspend_sender_thread),
+                            _RT_IPC_INDEX(&(mq->suspend_sender_index)),
                             thread,
                             mq->parent.parent.flag);
 
@@ -2343,6 +2989,7 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
 
         /* suspend current thread */
         rt_ipc_list_suspend(&(mq->parent.suspend_thread),
+                            _RT_IPC_INDEX(&(mq->parent.suspend_index)),
                             thread,
                             mq->parent.parent.flag);
 
@@ -2439,11 +3086,332 @@ rt_err_t rt_mq_recv(rt_mq_t    mq,
 }
 
 /**
- * This function can get or set some extra attributions of a message queue
- * object.
+ * This function will send a number of messages to message queue object. The
+ * free messages are taken in one pass, and the waiting receivers are waked up
+ * once for each pass. If the message queue is full, current thread will be
+ * suspended until timeout.
  *
  * @param mq the message queue object
- * @param cmd the execution command
+ * @param buffer the messages, which are saved one after another
+ * @param size the size of each message in buffer
+ * @param count the number of messages
+ * @param timeout the waiting time
+ *
+ * @return the number of messages which are sent, the error code is saved in
+ *         the errno of thread when it's less than count.
+ */
+rt_size_t rt_mq_send_n(rt_mq_t     mq,
+                       const void *buffer,
+                       rt_size_t   size,
+                       rt_size_t   count,
+                       rt_int32_t  timeout)
+{
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    struct rt_mq_message *head, *tail, *msg;
+    rt_uint32_t tick_delta;
+    rt_size_t sent, length;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL || count == 0);
+    RT_ASSERT(size != 0);
+    /* greater than one message size */
+    RT_ASSERT(size <= mq->msg_size);
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    sent = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(mq->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    while (sent < count)
+    {
+        /* message queue is full */
+        if (mq->msg_queue_free == RT_NULL)
+        {
+            /* reset error number in thread */
+            thread->error = RT_EOK;
+
+            /* no waiting, return full */
+            if (timeout == 0)
+            {
+                /* enable interrupt */
+                rt_hw_interrupt_enable(temp);
+
+                thread->error = -RT_EFULL;
+
+                return sent;
+            }
+
+            RT_DEBUG_IN_THREAD_CONTEXT;
+            /* suspend current thread */
+            rt_ipc_list_suspend(&(mq->suspend_sender_thread),
+                                _RT_IPC_INDEX(&(mq->suspend_sender_index)),
+                                thread,
+                                mq->parent.parent.flag);
+
+            /* has waiting time, start thread timer */
+            if (timeout > 0)
+            {
+                /* get the start tick of timer */
+                tick_delta = rt_tick_get();
+
+                RT_DEBUG_LOG(RT_DEBUG_IPC, ("mq_send_n: start timer of thread:%s\n",
+                                            thread->name));
+
+                /* reset the timeout of thread timer and start it */
+                rt_timer_control(&(thread->thread_timer),
+                                 RT_TIMER_CTRL_SET_TIME,
+                                 &timeout);
+                rt_timer_start(&(thread->thread_timer));
+            }
+
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            /* re-schedule */
+            rt_schedule();
+
+            /* resume from suspend state */
+            if (thread->error != RT_EOK)
+                return sent;
+
+            /* disable interrupt */
+            temp = rt_hw_interrupt_disable();
+
+            /* if it's not waiting forever and then re-calculate timeout tick */
+            if (timeout > 0)
+            {
+                tick_delta = rt_tick_get() - tick_delta;
+                timeout -= tick_delta;
+                if (timeout < 0)
+                    timeout = 0;
+            }
+
+            continue;
+        }
+
+        /* take the free messages */
+        head = tail = (struct rt_mq_message *)mq->msg_queue_free;
+        for (length = 1; length < count - sent && tail->next != RT_NULL; length ++)
+            tail = tail->next;
+        mq->msg_queue_free = tail->next;
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* copy buffers */
+        for (msg = head; ; msg = msg->next)
+        {
+            rt_memcpy(msg + 1, (const rt_uint8_t *)buffer + sent * size, size);
+            sent ++;
+
+            if (msg == tail)
+                break;
+        }
+        /* the tail is the new tailer of list, the next shall be NULL */
+        tail->next = RT_NULL;
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+
+        /* link messages to message queue */
+        if (mq->msg_queue_tail != RT_NULL)
+            ((struct rt_mq_message *)mq->msg_queue_tail)->next = head;
+        mq->msg_queue_tail = tail;
+        if (mq->msg_queue_head == RT_NULL)
+            mq->msg_queue_head = head;
+
+        /* increase message entry */
+        mq->entry += length;
+
+        /* resume suspended thread, one for each message at most */
+        if (rt_ipc_list_resume_n(&(mq->parent.suspend_thread), length) != 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            rt_schedule();
+
+            /* disable interrupt */
+            temp = rt_hw_interrupt_disable();
+        }
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    return sent;
+}
+
+/**
+ * This function will receive a number of messages from message queue object.
+ * All the messages in queue are taken in one pass, up to count. If there is no
+ * message in message queue object, the thread shall wait for a specified time.
+ *
+ * @param mq the message queue object
+ * @param buffer the received messages will be saved in, one after another
+ * @param size the size of each message in buffer
+ * @param count the maximum number of messages
+ * @param timeout the waiting time
+ *
+ * @return the number of messages which are received, the error code is saved
+ *         in the errno of thread when it's zero.
+ */
+rt_size_t rt_mq_recv_n(rt_mq_t    mq,
+                       void      *buffer,
+                       rt_size_t  size,
+                       rt_size_t  count,
+                       rt_int32_t timeout)
+{
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    struct rt_mq_message *head, *tail, *msg;
+    rt_uint32_t tick_delta;
+    rt_size_t length, index, resumed;
+
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(buffer != RT_NULL);
+    RT_ASSERT(size != 0);
+
+    if (count == 0)
+        return 0;
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(mq->parent.parent)));
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+
+    /* message queue is empty */
+    while (mq->entry == 0)
+    {
+        RT_DEBUG_IN_THREAD_CONTEXT;
+
+        /* reset error number in thread */
+        thread->error = RT_EOK;
+
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            thread->error = -RT_ETIMEOUT;
+
+            return 0;
+        }
+
+        /* suspend current thread */
+        rt_ipc_list_suspend(&(mq->parent.suspend_thread),
+                            _RT_IPC_INDEX(&(mq->parent.suspend_index)),
+                            thread,
+                            mq->parent.parent.flag);
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("mq_recv_n: start timer of thread:%s\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* recv message */
+        if (thread->error != RT_EOK)
+            return 0;
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    /* take the messages from queue */
+    head = tail = (struct rt_mq_message *)mq->msg_queue_head;
+    for (length = 1; length < count && tail->next != RT_NULL; length ++)
+        tail = tail->next;
+
+    /* move message queue head */
+    mq->msg_queue_head = tail->next;
+    /* reach queue tail, set to NULL */
+    if (mq->msg_queue_tail == tail)
+        mq->msg_queue_tail = RT_NULL;
+
+    /* decrease message entry */
+    mq->entry -= length;
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    /* copy messages */
+    for (msg = head, index = 0; ; msg = msg->next, index ++)
+    {
+        rt_memcpy((rt_uint8_t *)buffer + index * size, msg + 1,
+                  size > mq->msg_size ? mq->msg_size : size);
+
+        if (msg == tail)
+            break;
+    }
+
+    /* disable interrupt */
+    temp = rt_hw_interrupt_disable();
+    /* put messages to free list */
+    tail->next = (struct rt_mq_message *)mq->msg_queue_free;
+    mq->msg_queue_free = head;
+
+    /* resume suspended thread, one for each free message at most */
+    resumed = rt_ipc_list_resume_n(&(mq->suspend_sender_thread), length);
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(temp);
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(mq->parent.parent)));
+
+    if (resumed != 0)
+        rt_schedule();
+
+    return length;
+}
+
+/**
+ * This function can get or set some extra attributions of a message queue
+ * object.
+ *
+ * @param mq the message queue object
+ * @param cmd the execution command
  * @param arg the execution argument
  *
  * @return the error code
@@ -2459,6 +3427,12 @@ rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg)
 
     if (cmd == RT_IPC_CMD_RESET)
     {
+#ifdef RT_USING_MEMPOOL
+        /* return the blocks of zero-copy message queue to its memory pool */
+        if (mq->msg_mp != RT_NULL)
+            _rt_mq_release_ref(mq);
+#endif
+
         /* disable interrupt */
         level = rt_hw_interrupt_disable();
 
@@ -2497,6 +3471,808 @@ rt_err_t rt_mq_control(rt_mq_t mq, int cmd, void *arg)
 
     return -RT_ERROR;
 }
-#endif /* end of RT_USING_MESSAGEQUEUE */
+
+#ifdef RT_USING_MEMPOOL
+/**
+ * This function will initialize a zero-copy message queue. The messages are
+ * the blocks of a memory pool, only the pointer of block is passed through the
+ * queue, and the ownership of block is passed from the sender to the receiver.
+ * The blocks which are still in the queue are returned to the memory pool when
+ * the queue is reset or detached, so the memory pool shall be kept until then.
+ *
+ * @param mq the message object
+ * @param name the name of message queue
+ * @param msgpool the beginning address of buffer to save the message pointers
+ * @param pool_size the size of buffer to save the message pointers
+ * @param mp the memory pool which the messages are allocated from
+ * @param flag the flag of message queue
+ *
+ * @return the operation status, RT_EOK on successful
+ */
+rt_err_t rt_mq_init_mp(rt_mq_t     mq,
+                       const char *name,
+                       void       *msgpool,
+                       rt_size_t   pool_size,
+                       rt_mp_t     mp,
+                       rt_uint8_t  flag)
+{
+    /* parameter check */
+    RT_ASSERT(mp != RT_NULL);
+
+    rt_mq_init(mq, name, msgpool, sizeof(void *), pool_size, flag);
+    mq->msg_mp = mp;
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_HEAP
+/**
+ * This function will create a zero-copy message queue object from system
+ * resource.
+ *
+ * @param name the name of message queue
+ * @param max_msgs the maximum number of message in queue
+ * @param mp the memory pool which the messages are allocated from
+ * @param flag the flag of message queue
+ *
+ * @return the created message queue, RT_NULL on error happen
+ */
+rt_mq_t rt_mq_create_mp(const char *name,
+                        rt_size_t   max_msgs,
+                        rt_mp_t     mp,
+                        rt_uint8_t  flag)
+{
+    rt_mq_t mq;
+
+    /* parameter check */
+    RT_ASSERT(mp != RT_NULL);
+
+    mq = rt_mq_create(name, sizeof(void *), max_msgs, flag);
+    if (mq != RT_NULL)
+        mq->msg_mp = mp;
+
+    return mq;
+}
+#endif
+
+/**
+ * This function will allocate a message block from the memory pool of a
+ * zero-copy message queue.
+ *
+ * @param mq the message queue object
+ * @param timeout the waiting time
+ *
+ * @return the allocated block, RT_NULL on error happen
+ */
+void *rt_mq_alloc(rt_mq_t mq, rt_int32_t timeout)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&mq->parent.parent) == RT_Object_Class_MessageQueue);
+    RT_ASSERT(mq->msg_mp != RT_NULL);
+
+    return rt_mp_alloc(mq->msg_mp, timeout);
+}
+
+/**
+ * This function will send a block to a zero-copy message queue. The block is
+ * not copied, it's owned by the queue and then by the receiver on success. On
+ * error, the block is still owned by the sender.
+ *
+ * @param mq the message queue object
+ * @param block the block allocated from the memory pool of message queue
+ * @param timeout the waiting time
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_send_ref(rt_mq_t mq, void *block, rt_int32_t timeout)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(mq->msg_mp != RT_NULL);
+    RT_ASSERT(block != RT_NULL);
+    /* the header of an allocated block is its memory pool */
+    RT_ASSERT(*((rt_mp_t *)block - 1) == mq->msg_mp);
+
+    return rt_mq_send_wait(mq, &block, sizeof(void *), timeout);
+}
+
+/**
+ * This function will receive a block from a zero-copy message queue. The
+ * receiver owns the block, and shall release it by rt_mp_free.
+ *
+ * @param mq the message queue object
+ * @param block the received block will be saved in
+ * @param timeout the waiting time
+ *
+ * @return the error code
+ */
+rt_err_t rt_mq_recv_ref(rt_mq_t mq, void **block, rt_int32_t timeout)
+{
+    /* parameter check */
+    RT_ASSERT(mq != RT_NULL);
+    RT_ASSERT(mq->msg_mp != RT_NULL);
+    RT_ASSERT(block != RT_NULL);
+
+    return rt_mq_recv(mq, block, sizeof(void *), timeout);
+}
+#endif /* end of RT_USING_MEMPOOL */
+#endif /* end of RT_USING_MESSAGEQUEUE */
+
+#ifdef RT_USING_RINGBUF
+/*
+ * The ring buffer is shared by one producer and one consumer, the producer
+ * only changes the write index and the consumer only changes the read index,
+ * so the data is transferred without disabling interrupt. The interrupt is
+ * disabled only when a thread shall be suspended or resumed.
+ */
+#if defined(__CC_ARM)
+#define _rt_ringbuf_barrier()       __dmb(0xF)
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+#define _rt_ringbuf_barrier()       __DMB()
+#elif defined(__GNUC__)
+#define _rt_ringbuf_barrier()       __sync_synchronize()
+#else
+#define _rt_ringbuf_barrier()
+#endif
+
+/* resume the thread waiting on the ring buffer if there is */
+static void _rt_ringbuf_wakeup(rt_list_t *list)
+{
+    register rt_ubase_t temp;
+
+    /*
+     * the list is checked without lock at first, the waiting thread checks
+     * the index again with interrupt disabled before it's suspended.
+     */
+    if (rt_list_isempty(list))
+        return;
+
+    temp = rt_hw_interrupt_disable();
+    if (!rt_list_isempty(list))
+    {
+        rt_ipc_list_resume(list);
+        rt_hw_interrupt_enable(temp);
+
+        rt_schedule();
+
+        return;
+    }
+    rt_hw_interrupt_enable(temp);
+}
+
+static rt_size_t _rt_ringbuf_write(rt_ringbuf_t rb, const rt_uint8_t *buffer, rt_size_t size)
+{
+    rt_uint32_t in, offset;
+    rt_size_t space, length;
+
+    in = rb->in;
+    space = rb->size - (in - rb->out);
+    if (size > space)
+        size = space;
+    if (size == 0)
+        return 0;
+
+    offset = in & (rb->size - 1);
+    length = rb->size - offset;
+    if (length > size)
+        length = size;
+
+    rt_memcpy(rb->buffer + offset, buffer, length);
+    rt_memcpy(rb->buffer, buffer + length, size - length);
+
+    /* the data shall be written before the index */
+    _rt_ringbuf_barrier();
+    rb->in = in + size;
+    _rt_ringbuf_barrier();
+
+    return size;
+}
+
+static rt_size_t _rt_ringbuf_read(rt_ringbuf_t rb, rt_uint8_t *buffer, rt_size_t size)
+{
+    rt_uint32_t out, offset;
+    rt_size_t used, length;
+
+    out = rb->out;
+    used = rb->in - out;
+    if (size > used)
+        size = used;
+    if (size == 0)
+        return 0;
+
+    /* the data shall be read after the index */
+    _rt_ringbuf_barrier();
+
+    offset = out & (rb->size - 1);
+    length = rb->size - offset;
+    if (length > size)
+        length = size;
+
+    rt_memcpy(buffer, rb->buffer + offset, length);
+    rt_memcpy(buffer + length, rb->buffer, size - length);
+
+    _rt_ringbuf_barrier();
+    rb->out = out + size;
+    _rt_ringbuf_barrier();
+
+    return size;
+}
+
+/**
+ * This function will initialize a ring buffer and put it under control of
+ * resource management.
+ *
+ * @param rb the ring buffer object
+ * @param name the name of ring buffer
+ * @param pool the begin address of buffer to save data
+ * @param size the size of buffer, it shall be power of 2
+ * @param flag the flag of ring buffer
+ *
+ * @return the operation status, RT_EOK on successful
+ */
+rt_err_t rt_ringbuf_init(rt_ringbuf_t rb,
+                         const char  *name,
+                         void        *pool,
+                         rt_size_t    size,
+                         rt_uint8_t   flag)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(pool != RT_NULL);
+    RT_ASSERT(size != 0 && (size & (size - 1)) == 0);
+
+    /* initialize object */
+    rt_object_init(&(rb->parent.parent), RT_Object_Class_RingBuf, name);
+
+    /* set parent flag */
+    rb->parent.parent.flag = flag;
+
+    /* initialize ipc object */
+    rt_ipc_object_init(&(rb->parent));
+
+    /* initialize ring buffer */
+    rb->buffer = (rt_uint8_t *)pool;
+    rb->size   = size;
+    rb->in     = 0;
+    rb->out    = 0;
+
+    /* initialize an additional list of sender suspend thread */
+    rt_list_init(&(rb->suspend_sender_thread));
+
+    return RT_EOK;
+}
+
+/**
+ * This function will detach a ring buffer from resource management
+ *
+ * @param rb the ring buffer object
+ *
+ * @return the operation status, RT_EOK on successful
+ */
+rt_err_t rt_ringbuf_detach(rt_ringbuf_t rb)
+{
+    /* parameter check */
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rb->parent.parent) == RT_Object_Class_RingBuf);
+    RT_ASSERT(rt_object_is_systemobject(&rb->parent.parent));
+
+    /* resume all suspended thread */
+    rt_ipc_list_resume_all(&(rb->parent.suspend_thread));
+    /* also resume all ring buffer private suspended thread */
+    rt_ipc_list_resume_all(&(rb->suspend_sender_thread));
+
+    /* detach ring buffer object */
+    rt_object_detach(&(rb->parent.parent));
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_HEAP
+/**
+ * This function will create a ring buffer object from system resource
+ *
+ * @param name the name of ring buffer
+ * @param size the size of buffer, it shall be power of 2
+ * @param flag the flag of ring buffer
+ *
+ * @return the created ring buffer, RT_NULL on error happen
+ */
+rt_ringbuf_t rt_ringbuf_create(const char *name, rt_size_t size, rt_uint8_t flag)
+{
+    rt_ringbuf_t rb;
+
+    RT_ASSERT(size != 0 && (size & (size - 1)) == 0);
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* allocate object */
+    rb = (rt_ringbuf_t)rt_object_allocate(RT_Object_Class_RingBuf, name);
+    if (rb == RT_NULL)
+        return rb;
+
+    /* set parent */
+    rb->parent.parent.flag = flag;
+
+    /* initialize ipc object */
+    rt_ipc_object_init(&(rb->parent));
+
+    /* initialize ring buffer */
+    rb->size   = size;
+    rb->buffer = (rt_uint8_t *)RT_KERNEL_MALLOC(size);
+    if (rb->buffer == RT_NULL)
+    {
+        /* delete ring buffer object */
+        rt_object_delete(&(rb->parent.parent));
+
+        return RT_NULL;
+    }
+    rb->in  = 0;
+    rb->out = 0;
+
+    /* initialize an additional list of sender suspend thread */
+    rt_list_init(&(rb->suspend_sender_thread));
+
+    return rb;
+}
+
+/**
+ * This function will delete a ring buffer object and release the memory
+ *
+ * @param rb the ring buffer object
+ *
+ * @return the error code
+ */
+rt_err_t rt_ringbuf_delete(rt_ringbuf_t rb)
+{
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* parameter check */
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rb->parent.parent) == RT_Object_Class_RingBuf);
+    RT_ASSERT(rt_object_is_systemobject(&rb->parent.parent) == RT_FALSE);
+
+    /* resume all suspended thread */
+    rt_ipc_list_resume_all(&(rb->parent.suspend_thread));
+    /* also resume all ring buffer private suspended thread */
+    rt_ipc_list_resume_all(&(rb->suspend_sender_thread));
+
+    /* free ring buffer pool */
+    RT_KERNEL_FREE(rb->buffer);
+
+    /* delete ring buffer object */
+    rt_object_delete(&(rb->parent.parent));
+
+    return RT_EOK;
+}
+#endif
+
+/**
+ * This function will get the length of data in ring buffer.
+ *
+ * @param rb the ring buffer object
+ *
+ * @return the length of data
+ */
+rt_size_t rt_ringbuf_data_len(rt_ringbuf_t rb)
+{
+    RT_ASSERT(rb != RT_NULL);
+
+    return rb->in - rb->out;
+}
+
+/**
+ * This function will put data into ring buffer without blocking, it can be
+ * invoked in interrupt service routine. If there is a thread suspended on
+ * the ring buffer, it will be waked up.
+ *
+ * @param rb the ring buffer object
+ * @param buffer the data
+ * @param size the size of data
+ *
+ * @return the size of data which is put, it's less than size when the ring
+ *         buffer is full.
+ */
+rt_size_t rt_ringbuf_put(rt_ringbuf_t rb, const void *buffer, rt_size_t size)
+{
+    /* parameter check */
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rb->parent.parent) == RT_Object_Class_RingBuf);
+
+    size = _rt_ringbuf_write(rb, (const rt_uint8_t *)buffer, size);
+    if (size != 0)
+        _rt_ringbuf_wakeup(&(rb->parent.suspend_thread));
+
+    return size;
+}
+
+/**
+ * This function will put data into ring buffer. If the ring buffer is full,
+ * current thread will be suspended until timeout.
+ *
+ * @param rb the ring buffer object
+ * @param buffer the data
+ * @param size the size of data
+ * @param timeout the waiting time
+ *
+ * @return the size of data which is put, the error code is saved in the errno
+ *         of thread when it's less than size.
+ */
+rt_size_t rt_ringbuf_put_wait(rt_ringbuf_t rb,
+                              const void  *buffer,
+                              rt_size_t    size,
+                              rt_int32_t   timeout)
+{
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    rt_uint32_t tick_delta;
+    rt_size_t length;
+
+    /* parameter check */
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rb->parent.parent) == RT_Object_Class_RingBuf);
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    length = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    RT_OBJECT_HOOK_CALL(rt_object_put_hook, (&(rb->parent.parent)));
+
+    while (1)
+    {
+        length += rt_ringbuf_put(rb, (const rt_uint8_t *)buffer + length, size - length);
+        if (length == size)
+            break;
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+
+        /* the consumer has taken some data */
+        if (rb->in - rb->out != rb->size)
+        {
+            rt_hw_interrupt_enable(temp);
+            continue;
+        }
+
+        /* reset error number in thread */
+        thread->error = RT_EOK;
+
+        /* no waiting, return full */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            thread->error = -RT_EFULL;
+
+            break;
+        }
+
+        RT_DEBUG_IN_THREAD_CONTEXT;
+        /* suspend current thread */
+        rt_ipc_list_suspend(&(rb->suspend_sender_thread),
+                            RT_NULL,
+                            thread,
+                            rb->parent.parent.flag);
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("ringbuf_put_wait: start timer of thread:%s\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* resume from suspend state */
+        if (thread->error != RT_EOK)
+            break;
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    return length;
+}
+
+/**
+ * This function will get data from ring buffer without blocking, it can be
+ * invoked in interrupt service routine. If there is a thread suspended on
+ * the ring buffer to put data, it will be waked up.
+ *
+ * @param rb the ring buffer object
+ * @param buffer the buffer to save data
+ * @param size the size of buffer
+ *
+ * @return the size of data which is got
+ */
+rt_size_t rt_ringbuf_get(rt_ringbuf_t rb, void *buffer, rt_size_t size)
+{
+    /* parameter check */
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rb->parent.parent) == RT_Object_Class_RingBuf);
+
+    size = _rt_ringbuf_read(rb, (rt_uint8_t *)buffer, size);
+    if (size != 0)
+        _rt_ringbuf_wakeup(&(rb->suspend_sender_thread));
+
+    return size;
+}
+
+/**
+ * This function will get data from ring buffer. If the ring buffer is empty,
+ * current thread will be suspended until there is data or timeout.
+ *
+ * @param rb the ring buffer object
+ * @param buffer the buffer to save data
+ * @param size the size of buffer
+ * @param timeout the waiting time
+ *
+ * @return the size of data which is got, the error code is saved in the errno
+ *         of thread when it's 0.
+ */
+rt_size_t rt_ringbuf_get_wait(rt_ringbuf_t rb,
+                              void        *buffer,
+                              rt_size_t    size,
+                              rt_int32_t   timeout)
+{
+    struct rt_thread *thread;
+    register rt_ubase_t temp;
+    rt_uint32_t tick_delta;
+    rt_size_t length;
+
+    /* parameter check */
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rb->parent.parent) == RT_Object_Class_RingBuf);
+
+    /* initialize delta tick */
+    tick_delta = 0;
+    /* get current thread */
+    thread = rt_thread_self();
+
+    RT_OBJECT_HOOK_CALL(rt_object_trytake_hook, (&(rb->parent.parent)));
+
+    while (1)
+    {
+        length = rt_ringbuf_get(rb, buffer, size);
+        if (length != 0 || size == 0)
+            break;
+
+        /* disable interrupt */
+        temp = rt_hw_interrupt_disable();
+
+        /* the producer has put some data */
+        if (rb->in != rb->out)
+        {
+            rt_hw_interrupt_enable(temp);
+            continue;
+        }
+
+        /* reset error number in thread */
+        thread->error = RT_EOK;
+
+        /* no waiting, return timeout */
+        if (timeout == 0)
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(temp);
+
+            thread->error = -RT_ETIMEOUT;
+
+            return 0;
+        }
+
+        RT_DEBUG_IN_THREAD_CONTEXT;
+        /* suspend current thread */
+        rt_ipc_list_suspend(&(rb->parent.suspend_thread),
+                            _RT_IPC_INDEX(&(rb->parent.suspend_index)),
+                            thread,
+                            rb->parent.parent.flag);
+
+        /* has waiting time, start thread timer */
+        if (timeout > 0)
+        {
+            /* get the start tick of timer */
+            tick_delta = rt_tick_get();
+
+            RT_DEBUG_LOG(RT_DEBUG_IPC, ("ringbuf_get_wait: start timer of thread:%s\n",
+                                        thread->name));
+
+            /* reset the timeout of thread timer and start it */
+            rt_timer_control(&(thread->thread_timer),
+                             RT_TIMER_CTRL_SET_TIME,
+                             &timeout);
+            rt_timer_start(&(thread->thread_timer));
+        }
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(temp);
+
+        /* re-schedule */
+        rt_schedule();
+
+        /* resume from suspend state */
+        if (thread->error != RT_EOK)
+            return 0;
+
+        /* if it's not waiting forever and then re-calculate timeout tick */
+        if (timeout > 0)
+        {
+            tick_delta = rt_tick_get() - tick_delta;
+            timeout -= tick_delta;
+            if (timeout < 0)
+                timeout = 0;
+        }
+    }
+
+    RT_OBJECT_HOOK_CALL(rt_object_take_hook, (&(rb->parent.parent)));
+
+    return length;
+}
+
+/**
+ * This function will get the contiguous free region of ring buffer, the
+ * producer can fill it directly and then commit it with
+ * rt_ringbuf_write_commit.
+ *
+ * @param rb the ring buffer object
+ * @param ptr the start address of region will be saved in
+ *
+ * @return the size of region, 0 if the ring buffer is full
+ */
+rt_size_t rt_ringbuf_write_region(rt_ringbuf_t rb, void **ptr)
+{
+    rt_uint32_t in, offset;
+    rt_size_t space, length;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(ptr != RT_NULL);
+
+    in = rb->in;
+    space = rb->size - (in - rb->out);
+    offset = in & (rb->size - 1);
+    length = rb->size - offset;
+
+    *ptr = rb->buffer + offset;
+
+    return length < space ? length : space;
+}
+
+/**
+ * This function will commit the data which is filled in the free region.
+ *
+ * @param rb the ring buffer object
+ * @param size the size of data, it shall not be larger than the region
+ */
+void rt_ringbuf_write_commit(rt_ringbuf_t rb, rt_size_t size)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(size <= rb->size - (rb->in - rb->out));
+
+    if (size == 0)
+        return;
+
+    _rt_ringbuf_barrier();
+    rb->in += size;
+    _rt_ringbuf_barrier();
+
+    _rt_ringbuf_wakeup(&(rb->parent.suspend_thread));
+}
+
+/**
+ * This function will get the contiguous data region of ring buffer, the
+ * consumer can process it directly and then release it with
+ * rt_ringbuf_read_commit.
+ *
+ * @param rb the ring buffer object
+ * @param ptr the start address of region will be saved in
+ *
+ * @return the size of region, 0 if the ring buffer is empty
+ */
+rt_size_t rt_ringbuf_read_region(rt_ringbuf_t rb, void **ptr)
+{
+    rt_uint32_t out, offset;
+    rt_size_t used, length;
+
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(ptr != RT_NULL);
+
+    out = rb->out;
+    used = rb->in - out;
+    _rt_ringbuf_barrier();
+
+    offset = out & (rb->size - 1);
+    length = rb->size - offset;
+
+    *ptr = rb->buffer + offset;
+
+    return length < used ? length : used;
+}
+
+/**
+ * This function will release the data which is processed in the data region.
+ *
+ * @param rb the ring buffer object
+ * @param size the size of data, it shall not be larger than the region
+ */
+void rt_ringbuf_read_commit(rt_ringbuf_t rb, rt_size_t size)
+{
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(size <= rb->in - rb->out);
+
+    if (size == 0)
+        return;
+
+    _rt_ringbuf_barrier();
+    rb->out += size;
+    _rt_ringbuf_barrier();
+
+    _rt_ringbuf_wakeup(&(rb->suspend_sender_thread));
+}
+
+/**
+ * This function can get or set some extra attributions of a ring buffer
+ * object.
+ *
+ * @param rb the ring buffer object
+ * @param cmd the execution command
+ * @param arg the execution argument
+ *
+ * @return the error code
+ */
+rt_err_t rt_ringbuf_control(rt_ringbuf_t rb, int cmd, void *arg)
+{
+    rt_ubase_t level;
+
+    /* parameter check */
+    RT_ASSERT(rb != RT_NULL);
+    RT_ASSERT(rt_object_get_type(&rb->parent.parent) == RT_Object_Class_RingBuf);
+
+    if (cmd == RT_IPC_CMD_RESET)
+    {
+        /* disable interrupt */
+        level = rt_hw_interrupt_disable();
+
+        /* resume all waiting thread */
+        rt_ipc_list_resume_all(&(rb->parent.suspend_thread));
+        /* also resume all ring buffer private suspended thread */
+        rt_ipc_list_resume_all(&(rb->suspend_sender_thread));
+
+        /* re-init ring buffer */
+        rb->in  = 0;
+        rb->out = 0;
+
+        /* enable interrupt */
+        rt_hw_interrupt_enable(level);
+
+        rt_schedule();
+
+        return RT_EOK;
+    }
+
+    return -RT_ERROR;
+}
+#endif /* end of RT_USING_RINGBUF */
 
 /**@}*/
@@ -9,6 +9,9 @@
  * 2006-05-03     Bernard      add IRQ_DEBUG
  * 2016-08-09     ArdaFu       add interrupt enter and leave hook.
  * 2018-11-22     Jesven       rt_interrupt_get_nest function add disable irq
+ * 2026-10-17     weizx208     add trace of interrupt enter and leave
+ * 2026-10-17     weizx208     add CPU usage accounting
+ * 2026-10-17     weizx208     measure the interrupt service spans
  */
 
 #include <rthw.h>
@@ -67,6 +70,16 @@ void rt_interrupt_enter(void)
 
     level = rt_hw_interrupt_disable();
     rt_interrupt_nest ++;
+#ifdef RT_USING_CPU_USAGE
+    /* the interrupted thread is charged when entering the outermost interrupt */
+    if (rt_interrupt_nest == 1 && rt_thread_self() != RT_NULL)
+        rt_cpu_usage_account(rt_thread_self());
+#endif
+#ifdef RT_USING_IRQ_LATENCY
+    if (rt_interrupt_nest == 1)
+        RT_IRQ_LATENCY_BEGIN(RT_IRQ_LATENCY_ISR, RT_RETURN_ADDRESS());
+#endif
+    RT_TRACE_RECORD(RT_TRACE_IRQ_ENTER, rt_interrupt_nest, RT_NULL);
     RT_OBJECT_HOOK_CALL(rt_interrupt_enter_hook,());
     rt_hw_interrupt_enable(level);
 }
@@ -86,6 +99,15 @@ void rt_interrupt_leave(void)
                                 rt_interrupt_nest));
 
     level = rt_hw_interrupt_disable();
+    RT_TRACE_RECORD(RT_TRACE_IRQ_LEAVE, rt_interrupt_nest, RT_NULL);
+#ifdef RT_USING_CPU_USAGE
+    if (rt_interrupt_nest == 1 && rt_thread_self() != RT_NULL)
+        rt_cpu_usage_account(RT_NULL);
+#endif
+#ifdef RT_USING_IRQ_LATENCY
+    if (rt_interrupt_nest == 1)
+        RT_IRQ_LATENCY_END(RT_IRQ_LATENCY_ISR);
+#endif
     rt_interrupt_nest --;
     RT_OBJECT_HOOK_CALL(rt_interrupt_leave_hook,());
     rt_hw_interrupt_enable(level);
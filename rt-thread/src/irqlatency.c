@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Interrupt latency measurement.
+ *
+ * Three kinds of span are measured: the interrupt disabled by the outermost
+ * rt_hw_interrupt_disable()/rt_hw_interrupt_enable() pair, the scheduler
+ * locked by the outermost rt_enter_critical()/rt_exit_critical() pair, and
+ * the outermost interrupt service routine between rt_interrupt_enter() and
+ * rt_interrupt_leave(). For each kind, the longest spans are kept together
+ * with the return address of the function beginning the span, one for each
+ * caller, see finsh command "irqlat".
+ *
+ * rthw.h redirects rt_hw_interrupt_disable() and rt_hw_interrupt_enable() to
+ * the functions here. A span shorter than all the kept ones is dropped after
+ * one compare, so that it's cheap enough to be enabled in a soak test.
+ *
+ * The system tick is the timestamp by default, the BSP shall set a cycle
+ * counter by rt_timestamp_set(), which clears the spans measured.
+ */
+
+/* call the functions of port in this file */
+#define RT_IRQ_LATENCY_RAW
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_IRQ_LATENCY
+
+#ifndef RT_IRQ_LATENCY_TOP
+#define RT_IRQ_LATENCY_TOP          8
+#endif
+
+/* the level returned by rt_hw_interrupt_disable() if it was enabled, such
+ * as PRIMASK of Cortex-M */
+#ifndef RT_IRQ_LATENCY_LEVEL_ENABLED
+#define RT_IRQ_LATENCY_LEVEL_ENABLED    0
+#endif
+
+struct _latency_entry
+{
+    void       *caller;
+    rt_uint32_t max;
+};
+
+struct _latency_span
+{
+    /* the span in progress, caller is RT_NULL if none */
+    void       *caller;
+    rt_uint32_t stamp;
+
+    rt_uint32_t count;
+    /* the shortest one kept, when the table is full */
+    rt_uint32_t threshold;
+    struct _latency_entry top[RT_IRQ_LATENCY_TOP];
+};
+
+static struct _latency_span _latency_spans[RT_IRQ_LATENCY_SPANS];
+
+static void _latency_keep(struct _latency_span *span, void *caller, rt_uint32_t time)
+{
+    int index, min;
+
+    /* the longest one of each caller */
+    min = 0;
+    for (index = 0; index < RT_IRQ_LATENCY_TOP; index ++)
+    {
+        if (span->top[index].caller == caller)
+        {
+            if (time > span->top[index].max)
+                span->top[index].max = time;
+            break;
+        }
+
+        if (span->top[index].max < span->top[min].max)
+            min = index;
+    }
+
+    /* replace the shortest one, or an empty one whose max is 0 */
+    if (index == RT_IRQ_LATENCY_TOP)
+    {
+        span->top[min].caller = caller;
+        span->top[min].max    = time;
+    }
+
+    span->threshold = span->top[0].max;
+    for (index = 0; index < RT_IRQ_LATENCY_TOP; index ++)
+    {
+        if (span->top[index].caller == RT_NULL)
+        {
+            span->threshold = 0;
+            break;
+        }
+        if (span->top[index].max < span->threshold)
+            span->threshold = span->top[index].max;
+    }
+}
+
+/**
+ * @addtogroup Kernel
+ */
+
+/**@{*/
+
+/**
+ * This function will begin a span. It's invoked with interrupt disabled.
+ *
+ * @param span the kind of span, RT_IRQ_LATENCY_IRQ_OFF etc.
+ * @param caller the return address of the function beginning the span
+ *
+ * @note please don't invoke this routine in application
+ */
+void rt_irq_latency_begin(int span, void *caller)
+{
+    RT_ASSERT(span < RT_IRQ_LATENCY_SPANS);
+
+    _latency_spans[span].stamp  = rt_timestamp_get();
+    _latency_spans[span].caller = (caller != RT_NULL) ? caller : (void *)1;
+}
+
+/**
+ * This function will end a span, nothing is done if no span is in progress.
+ * It's invoked with interrupt disabled.
+ *
+ * @param span the kind of span, RT_IRQ_LATENCY_IRQ_OFF etc.
+ *
+ * @note please don't invoke this routine in application
+ */
+void rt_irq_latency_end(int span)
+{
+    rt_uint32_t time;
+    struct _latency_span *latency;
+
+    RT_ASSERT(span < RT_IRQ_LATENCY_SPANS);
+
+    latency = &_latency_spans[span];
+    if (latency->caller == RT_NULL)
+        return;
+
+    time = rt_timestamp_get() - latency->stamp;
+    latency->count ++;
+    if (time > latency->threshold)
+        _latency_keep(latency, latency->caller, time);
+    latency->caller = RT_NULL;
+}
+
+/**
+ * This function will disable interrupt, and begin a span if it was enabled.
+ * rthw.h maps rt_hw_interrupt_disable() to it.
+ *
+ * @return the interrupt status before
+ */
+rt_base_t rt_irq_latency_disable(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    if (level == RT_IRQ_LATENCY_LEVEL_ENABLED)
+        rt_irq_latency_begin(RT_IRQ_LATENCY_IRQ_OFF, RT_RETURN_ADDRESS());
+
+    return level;
+}
+
+/**
+ * This function will end the span if interrupt is to be enabled, and restore
+ * interrupt. rthw.h maps rt_hw_interrupt_enable() to it.
+ *
+ * @param level the interrupt status returned by rt_irq_latency_disable
+ */
+void rt_irq_latency_enable(rt_base_t level)
+{
+    if (level == RT_IRQ_LATENCY_LEVEL_ENABLED)
+        rt_irq_latency_end(RT_IRQ_LATENCY_IRQ_OFF);
+
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will clear the spans measured, the spans in progress are
+ * still measured.
+ */
+void rt_irq_latency_reset(void)
+{
+    int span;
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    for (span = 0; span < RT_IRQ_LATENCY_SPANS; span ++)
+    {
+        _latency_spans[span].count     = 0;
+        _latency_spans[span].threshold = 0;
+        rt_memset(_latency_spans[span].top, 0, sizeof(_latency_spans[span].top));
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void _latency_print(int span, const char *name)
+{
+    int index, first, max;
+    rt_base_t level;
+    rt_uint32_t count;
+    struct _latency_entry top[RT_IRQ_LATENCY_TOP], entry;
+
+    level = rt_hw_interrupt_disable();
+    count = _latency_spans[span].count;
+    rt_memcpy(top, _latency_spans[span].top, sizeof(top));
+    rt_hw_interrupt_enable(level);
+
+    rt_kprintf("%s, %d spans\n", name, count);
+    rt_kprintf("%-*s        max       us\n", (int)sizeof(void *) * 2 + 2, "caller");
+    for (index = 0; index < (int)sizeof(void *) * 2 + 2; index ++)
+        rt_kprintf("-");
+    rt_kprintf(" ---------- --------\n");
+
+    /* print the longest first */
+    for (first = 0; first < RT_IRQ_LATENCY_TOP; first ++)
+    {
+        max = first;
+        for (index = first + 1; index < RT_IRQ_LATENCY_TOP; index ++)
+        {
+            if (top[index].max > top[max].max)
+                max = index;
+        }
+        if (top[max].caller == RT_NULL)
+            break;
+
+        rt_kprintf("0x%p %10d %8d\n", top[max].caller, top[max].max,
+                   (rt_uint32_t)((rt_uint64_t)top[max].max * 1000000 / rt_timestamp_get_frequency()));
+
+        entry = top[first];
+        top[first] = top[max];
+        top[max] = entry;
+    }
+}
+
+static int irqlat(int argc, char **argv)
+{
+    if (argc == 2 && rt_strcmp(argv[1], "reset") == 0)
+    {
+        rt_irq_latency_reset();
+
+        return 0;
+    }
+    if (argc != 1)
+    {
+        rt_kprintf("Usage: irqlat [reset]\n");
+
+        return -1;
+    }
+
+    rt_kprintf("frequency %d\n", rt_timestamp_get_frequency());
+    _latency_print(RT_IRQ_LATENCY_IRQ_OFF, "interrupt disabled");
+    _latency_print(RT_IRQ_LATENCY_SCHED_LOCK, "scheduler locked");
+    _latency_print(RT_IRQ_LATENCY_ISR, "interrupt service");
+
+    return 0;
+}
+MSH_CMD_EXPORT(irqlat, show the longest interrupt latency spans and callers);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_IRQ_LATENCY */
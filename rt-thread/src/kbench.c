@@ -0,0 +1,1330 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ * 2026-10-17     weizx208     add the cases of scaling and backends
+ * 2026-10-17     weizx208     move the tick forward only in timer expire
+ * 2026-10-17     weizx208     add the string cases on each word alignment
+ */
+
+/*
+ * Kernel micro-benchmark.
+ *
+ * The finsh command "kbench [case] [loops]" runs the cases of kernel services
+ * and prints one line "case,count,min,avg,max,p99" for each, in the unit of
+ * timestamp. The first line "# kbench <frequency>" tells the frequency of
+ * timestamp, so that the output of two runs can be compared by diff or a
+ * script.
+ *
+ * The system tick is the timestamp by default, the BSP shall set a cycle
+ * counter by rt_timestamp_set() to get cycles per operation.
+ *
+ * The workers run at RT_KBENCH_PRIORITY and RT_KBENCH_PRIORITY - 1, no other
+ * thread of these priorities shall be ready during the benchmark.
+ *
+ * The name of a case tells the backend or configuration it depends on, such
+ * as "timer_wheel_start_100" or "schedule_256", and the number of objects,
+ * so the runs of two configurations are compared case by case. The memory
+ * and string cases, such as "memcpy_256_shifted", tell the word alignment of
+ * the buffers, which is measured apart.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_KBENCH
+
+#ifndef RT_USING_SEMAPHORE
+#error "kbench requires RT_USING_SEMAPHORE"
+#endif
+
+#ifndef RT_KBENCH_SAMPLES
+#define RT_KBENCH_SAMPLES       256
+#endif
+#ifndef RT_KBENCH_PRIORITY
+#define RT_KBENCH_PRIORITY      3
+#endif
+#ifndef RT_KBENCH_STACK_SIZE
+#define RT_KBENCH_STACK_SIZE    512
+#endif
+
+#if RT_KBENCH_PRIORITY < 1 || RT_KBENCH_PRIORITY >= RT_THREAD_PRIORITY_MAX
+#error "RT_KBENCH_PRIORITY shall be in 1 ~ RT_THREAD_PRIORITY_MAX - 1"
+#endif
+
+/* the priority of worker woken up, it preempts the other at once */
+#define KBENCH_PRIORITY_HIGH    (RT_KBENCH_PRIORITY - 1)
+#define KBENCH_WORKER_MAX       5
+
+#define _KBENCH_STR(x)          #x
+#define KBENCH_STR(x)           _KBENCH_STR(x)
+
+/* the case run with a parameter, such as the number of objects */
+#define KBENCH_CASE(fn, n)                                                  \
+    static void fn##_##n(void)                                              \
+    {                                                                       \
+        fn(n);                                                              \
+    }
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static rt_uint32_t _kbench_samples[RT_KBENCH_SAMPLES];
+static rt_uint32_t _kbench_count;
+
+/* the shared states of workers */
+static volatile rt_uint32_t _kbench_stamp;
+static volatile rt_uint32_t _kbench_active;
+static rt_uint32_t _kbench_loops;
+static struct rt_semaphore _kbench_done;
+
+static struct rt_thread _kbench_threads[KBENCH_WORKER_MAX];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _kbench_stacks[KBENCH_WORKER_MAX][RT_KBENCH_STACK_SIZE];
+
+static void _kbench_record(rt_uint32_t value)
+{
+    if (_kbench_count < RT_KBENCH_SAMPLES)
+        _kbench_samples[_kbench_count ++] = value;
+}
+
+struct _kbench_worker
+{
+    void (*entry)(void *parameter);
+    void *parameter;
+    rt_uint8_t priority;
+};
+
+static void _kbench_worker_entry(void *parameter)
+{
+    struct _kbench_worker *worker;
+
+    worker = (struct _kbench_worker *)parameter;
+    worker->entry(worker->parameter);
+
+    _kbench_active --;
+    rt_sem_release(&_kbench_done);
+}
+
+/* start the workers together, and wait until all of them exit */
+static void _kbench_run_workers(struct _kbench_worker *workers, int count)
+{
+    int index;
+    rt_err_t result;
+
+    RT_ASSERT(count <= KBENCH_WORKER_MAX);
+
+    _kbench_active = count;
+    rt_enter_critical();
+    for (index = 0; index < count; index ++)
+    {
+        result = rt_thread_init(&_kbench_threads[index], "kbench",
+                                _kbench_worker_entry, &workers[index],
+                                _kbench_stacks[index], RT_KBENCH_STACK_SIZE,
+                                workers[index].priority, 10);
+        RT_ASSERT(result == RT_EOK);
+        rt_thread_startup(&_kbench_threads[index]);
+    }
+    rt_exit_critical();
+
+    for (index = 0; index < count; index ++)
+        rt_sem_take(&_kbench_done, RT_WAITING_FOREVER);
+
+    /* the thread object is detached when it exits, then it can be initialized again */
+    for (index = 0; index < count; index ++)
+    {
+        while ((_kbench_threads[index].stat & RT_THREAD_STAT_MASK) != RT_THREAD_CLOSE)
+            rt_thread_delay(1);
+    }
+}
+
+static void _kbench_timestamp_run(void)
+{
+    rt_uint32_t loop, stamp;
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+}
+
+static void _kbench_critical_run(void)
+{
+    rt_uint32_t loop, stamp;
+
+    /* lock and unlock the scheduler, no thread is woken up */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_enter_critical();
+        rt_exit_critical();
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+}
+
+/* the name tells the levels of priority, the lookup of which is measured */
+#define KBENCH_SCHEDULE_NAME    "schedule_" KBENCH_STR(RT_THREAD_PRIORITY_MAX)
+
+static void _kbench_schedule_run(void)
+{
+    rt_uint32_t loop, stamp;
+
+    /* look up the highest ready priority, the caller is still the one */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_schedule();
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+}
+
+static void _kbench_yield_entry(void *parameter)
+{
+    rt_uint32_t loop;
+
+    /* the time from yield of one thread to the return in another */
+    for (loop = 0; loop < _kbench_loops / 2; loop ++)
+    {
+        _kbench_stamp = rt_timestamp_get();
+        rt_thread_yield();
+        if (_kbench_active == 2)
+            _kbench_record(rt_timestamp_get() - _kbench_stamp);
+    }
+}
+
+static void _kbench_yield_run(void)
+{
+    struct _kbench_worker workers[2] =
+    {
+        {_kbench_yield_entry, RT_NULL, RT_KBENCH_PRIORITY},
+        {_kbench_yield_entry, RT_NULL, RT_KBENCH_PRIORITY},
+    };
+
+    _kbench_run_workers(workers, 2);
+}
+
+static struct rt_semaphore _kbench_ping, _kbench_pong;
+
+static void _kbench_ping_entry(void *parameter)
+{
+    rt_uint32_t loop, stamp;
+
+    /* a round trip takes two semaphores and two switches */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_sem_release(&_kbench_ping);
+        rt_sem_take(&_kbench_pong, RT_WAITING_FOREVER);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+}
+
+static void _kbench_pong_entry(void *parameter)
+{
+    rt_uint32_t loop;
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        rt_sem_take(&_kbench_ping, RT_WAITING_FOREVER);
+        rt_sem_release(&_kbench_pong);
+    }
+}
+
+static void _kbench_sem_run(void)
+{
+    struct _kbench_worker workers[2] =
+    {
+        {_kbench_ping_entry, RT_NULL, RT_KBENCH_PRIORITY},
+        {_kbench_pong_entry, RT_NULL, RT_KBENCH_PRIORITY},
+    };
+
+    rt_sem_init(&_kbench_ping, "kping", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&_kbench_pong, "kpong", 0, RT_IPC_FLAG_FIFO);
+    _kbench_run_workers(workers, 2);
+    rt_sem_detach(&_kbench_pong);
+    rt_sem_detach(&_kbench_ping);
+}
+
+#ifdef RT_USING_HEAP
+#define KBENCH_WAITERS          64
+
+static struct rt_semaphore _kbench_wait_sem;
+
+static void _kbench_waiter_entry(void *parameter)
+{
+    rt_sem_take(&_kbench_wait_sem, RT_WAITING_FOREVER);
+    rt_sem_release(&_kbench_done);
+}
+
+static void _kbench_wait_entry(void *parameter)
+{
+    rt_uint32_t loop;
+
+    /* it's suspended after the waiters of the same priority, and times out */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        rt_sem_release(&_kbench_ping);
+        _kbench_stamp = rt_timestamp_get();
+        rt_sem_take(&_kbench_wait_sem, 1);
+    }
+}
+
+static void _kbench_wait_record_entry(void *parameter)
+{
+    rt_uint32_t loop;
+
+    /* the time from the take to the switch, the insertion into the suspended
+     * list is done with interrupt disabled in between */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        rt_sem_take(&_kbench_ping, RT_WAITING_FOREVER);
+        _kbench_record(rt_timestamp_get() - _kbench_stamp);
+    }
+}
+
+static void _kbench_sem_wait(int waiters)
+{
+    int index, count;
+    rt_thread_t thread;
+    struct _kbench_worker workers[2] =
+    {
+        {_kbench_wait_entry,        RT_NULL, KBENCH_PRIORITY_HIGH},
+        {_kbench_wait_record_entry, RT_NULL, RT_KBENCH_PRIORITY},
+    };
+
+    rt_sem_init(&_kbench_ping, "kping", 0, RT_IPC_FLAG_FIFO);
+    rt_sem_init(&_kbench_wait_sem, "kwait", 0, RT_IPC_FLAG_PRIO);
+
+    /* the waiters block at once as they preempt the caller */
+    for (count = 0; count < waiters; count ++)
+    {
+        thread = rt_thread_create("kwait", _kbench_waiter_entry, RT_NULL,
+                                  RT_KBENCH_STACK_SIZE, KBENCH_PRIORITY_HIGH, 10);
+        if (thread == RT_NULL)
+            break;
+        rt_thread_startup(thread);
+    }
+
+    if (count == waiters)
+        _kbench_run_workers(workers, 2);
+
+    for (index = 0; index < count; index ++)
+        rt_sem_release(&_kbench_wait_sem);
+    for (index = 0; index < count; index ++)
+        rt_sem_take(&_kbench_done, RT_WAITING_FOREVER);
+
+    rt_sem_detach(&_kbench_wait_sem);
+    rt_sem_detach(&_kbench_ping);
+}
+KBENCH_CASE(_kbench_sem_wait, 64)
+#endif /* RT_USING_HEAP */
+
+#ifdef RT_USING_MUTEX
+static struct rt_mutex _kbench_mutex;
+
+#define KBENCH_MUTEX_BATCH      16
+
+static void _kbench_mutex_fast_run(void)
+{
+    rt_uint32_t loop, batch, stamp;
+
+    /* take and release without contention, the average of a batch as it's
+     * close to the cost of timestamp */
+    rt_mutex_init(&_kbench_mutex, "kmutex", RT_IPC_FLAG_FIFO);
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        for (batch = 0; batch < KBENCH_MUTEX_BATCH; batch ++)
+        {
+            rt_mutex_take(&_kbench_mutex, RT_WAITING_FOREVER);
+            rt_mutex_release(&_kbench_mutex);
+        }
+        _kbench_record((rt_timestamp_get() - stamp) / KBENCH_MUTEX_BATCH);
+    }
+    rt_mutex_detach(&_kbench_mutex);
+}
+
+static void _kbench_mutex_low_entry(void *parameter)
+{
+    rt_uint32_t loop;
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        rt_mutex_take(&_kbench_mutex, RT_WAITING_FOREVER);
+        /* wake the high one up, it blocks on the mutex and inherits to me */
+        rt_sem_release(&_kbench_ping);
+        rt_mutex_release(&_kbench_mutex);
+    }
+}
+
+static void _kbench_mutex_high_entry(void *parameter)
+{
+    rt_uint32_t loop, stamp;
+
+    /* the contended take, with priority inheritance and two switches */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        rt_sem_take(&_kbench_ping, RT_WAITING_FOREVER);
+        stamp = rt_timestamp_get();
+        rt_mutex_take(&_kbench_mutex, RT_WAITING_FOREVER);
+        _kbench_record(rt_timestamp_get() - stamp);
+        rt_mutex_release(&_kbench_mutex);
+    }
+}
+
+static void _kbench_mutex_run(void)
+{
+    struct _kbench_worker workers[2] =
+    {
+        {_kbench_mutex_high_entry, RT_NULL, KBENCH_PRIORITY_HIGH},
+        {_kbench_mutex_low_entry,  RT_NULL, RT_KBENCH_PRIORITY},
+    };
+
+    rt_sem_init(&_kbench_ping, "kping", 0, RT_IPC_FLAG_FIFO);
+    rt_mutex_init(&_kbench_mutex, "kmutex", RT_IPC_FLAG_FIFO);
+    _kbench_run_workers(workers, 2);
+    rt_mutex_detach(&_kbench_mutex);
+    rt_sem_detach(&_kbench_ping);
+}
+#endif /* RT_USING_MUTEX */
+
+#ifdef RT_USING_EVENT
+#define KBENCH_EVENT_WAITERS    (KBENCH_WORKER_MAX - 1)
+
+static struct rt_event _kbench_event;
+static rt_uint32_t _kbench_received;
+
+static void _kbench_event_send_entry(void *parameter)
+{
+    rt_uint32_t loop;
+
+    /* all waiters run before the send returns */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        _kbench_stamp = rt_timestamp_get();
+        rt_event_send(&_kbench_event, (1UL << KBENCH_EVENT_WAITERS) - 1);
+    }
+}
+
+static void _kbench_event_wait_entry(void *parameter)
+{
+    rt_uint32_t loop, set;
+
+    /* the time from send to the last waiter woken up */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        rt_event_recv(&_kbench_event, 1UL << (rt_ubase_t)parameter,
+                      RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR, RT_WAITING_FOREVER, &set);
+        if (++ _kbench_received == KBENCH_EVENT_WAITERS)
+        {
+            _kbench_record(rt_timestamp_get() - _kbench_stamp);
+            _kbench_received = 0;
+        }
+    }
+}
+
+static void _kbench_event_run(void)
+{
+    int index;
+    struct _kbench_worker workers[KBENCH_WORKER_MAX];
+
+    workers[0].entry     = _kbench_event_send_entry;
+    workers[0].parameter = RT_NULL;
+    workers[0].priority  = RT_KBENCH_PRIORITY;
+    for (index = 0; index < KBENCH_EVENT_WAITERS; index ++)
+    {
+        workers[index + 1].entry     = _kbench_event_wait_entry;
+        workers[index + 1].parameter = (void *)(rt_ubase_t)index;
+        workers[index + 1].priority  = KBENCH_PRIORITY_HIGH;
+    }
+
+    _kbench_received = 0;
+    rt_event_init(&_kbench_event, "kevent", RT_IPC_FLAG_FIFO);
+    _kbench_run_workers(workers, KBENCH_WORKER_MAX);
+    rt_event_detach(&_kbench_event);
+}
+#endif /* RT_USING_EVENT */
+
+#ifdef RT_USING_MAILBOX
+static struct rt_mailbox _kbench_mb;
+static rt_ubase_t _kbench_mb_pool[8];
+
+static void _kbench_mb_send_entry(void *parameter)
+{
+    rt_uint32_t loop, stamp;
+
+    /* the send, a switch to receiver, the receive, and a switch back */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_mb_send(&_kbench_mb, loop);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+}
+
+static void _kbench_mb_recv_entry(void *parameter)
+{
+    rt_uint32_t loop;
+    rt_ubase_t value;
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+        rt_mb_recv(&_kbench_mb, &value, RT_WAITING_FOREVER);
+}
+
+static void _kbench_mb_run(void)
+{
+    struct _kbench_worker workers[2] =
+    {
+        {_kbench_mb_recv_entry, RT_NULL, KBENCH_PRIORITY_HIGH},
+        {_kbench_mb_send_entry, RT_NULL, RT_KBENCH_PRIORITY},
+    };
+
+    rt_mb_init(&_kbench_mb, "kmb", _kbench_mb_pool,
+               sizeof(_kbench_mb_pool) / sizeof(_kbench_mb_pool[0]), RT_IPC_FLAG_FIFO);
+    _kbench_run_workers(workers, 2);
+    rt_mb_detach(&_kbench_mb);
+}
+
+#define KBENCH_BATCH            16
+
+/* the cost per item, sent and received one by one or in a batch */
+static void _kbench_mb_batch(int batch)
+{
+    static rt_ubase_t pool[KBENCH_BATCH];
+    rt_ubase_t values[KBENCH_BATCH];
+    rt_uint32_t loop, stamp;
+    int index;
+
+    rt_mb_init(&_kbench_mb, "kmb", pool, KBENCH_BATCH, RT_IPC_FLAG_FIFO);
+    for (index = 0; index < KBENCH_BATCH; index ++)
+        values[index] = index;
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        if (batch == 1)
+        {
+            for (index = 0; index < KBENCH_BATCH; index ++)
+                rt_mb_send(&_kbench_mb, values[index]);
+            for (index = 0; index < KBENCH_BATCH; index ++)
+                rt_mb_recv(&_kbench_mb, &values[index], 0);
+        }
+        else
+        {
+            rt_mb_send_n(&_kbench_mb, values, KBENCH_BATCH, 0);
+            rt_mb_recv_n(&_kbench_mb, values, KBENCH_BATCH, 0);
+        }
+        _kbench_record((rt_timestamp_get() - stamp) / KBENCH_BATCH);
+    }
+    rt_mb_detach(&_kbench_mb);
+}
+KBENCH_CASE(_kbench_mb_batch, 1)
+KBENCH_CASE(_kbench_mb_batch, 16)
+#endif /* RT_USING_MAILBOX */
+
+#ifdef RT_USING_MESSAGEQUEUE
+#define KBENCH_MSG_SIZE         16
+
+static struct rt_messagequeue _kbench_mq;
+static rt_uint8_t _kbench_mq_pool[8 * (KBENCH_MSG_SIZE + sizeof(void *))];
+
+static void _kbench_mq_send_entry(void *parameter)
+{
+    rt_uint32_t loop, stamp;
+    rt_uint8_t buffer[KBENCH_MSG_SIZE];
+
+    rt_memset(buffer, 0, sizeof(buffer));
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_mq_send(&_kbench_mq, buffer, sizeof(buffer));
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+}
+
+static void _kbench_mq_recv_entry(void *parameter)
+{
+    rt_uint32_t loop;
+    rt_uint8_t buffer[KBENCH_MSG_SIZE];
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+        rt_mq_recv(&_kbench_mq, buffer, sizeof(buffer), RT_WAITING_FOREVER);
+}
+
+static void _kbench_mq_run(void)
+{
+    struct _kbench_worker workers[2] =
+    {
+        {_kbench_mq_recv_entry, RT_NULL, KBENCH_PRIORITY_HIGH},
+        {_kbench_mq_send_entry, RT_NULL, RT_KBENCH_PRIORITY},
+    };
+
+    rt_mq_init(&_kbench_mq, "kmq", _kbench_mq_pool, KBENCH_MSG_SIZE,
+               sizeof(_kbench_mq_pool), RT_IPC_FLAG_FIFO);
+    _kbench_run_workers(workers, 2);
+    rt_mq_detach(&_kbench_mq);
+}
+
+#define KBENCH_MQ_BATCH         16
+
+/* the cost per message, sent and received one by one or in a batch */
+static void _kbench_mq_batch(int batch)
+{
+    static rt_uint8_t pool[KBENCH_MQ_BATCH * (KBENCH_MSG_SIZE + sizeof(void *))];
+    rt_uint8_t buffer[KBENCH_MQ_BATCH][KBENCH_MSG_SIZE];
+    rt_uint32_t loop, stamp;
+    int index;
+
+    rt_mq_init(&_kbench_mq, "kmq", pool, KBENCH_MSG_SIZE, sizeof(pool), RT_IPC_FLAG_FIFO);
+    rt_memset(buffer, 0, sizeof(buffer));
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        if (batch == 1)
+        {
+            for (index = 0; index < KBENCH_MQ_BATCH; index ++)
+                rt_mq_send(&_kbench_mq, buffer[index], KBENCH_MSG_SIZE);
+            for (index = 0; index < KBENCH_MQ_BATCH; index ++)
+                rt_mq_recv(&_kbench_mq, buffer[index], KBENCH_MSG_SIZE, 0);
+        }
+        else
+        {
+            rt_mq_send_n(&_kbench_mq, buffer, KBENCH_MSG_SIZE, KBENCH_MQ_BATCH, 0);
+            rt_mq_recv_n(&_kbench_mq, buffer, KBENCH_MSG_SIZE, KBENCH_MQ_BATCH, 0);
+        }
+        _kbench_record((rt_timestamp_get() - stamp) / KBENCH_MQ_BATCH);
+    }
+    rt_mq_detach(&_kbench_mq);
+}
+KBENCH_CASE(_kbench_mq_batch, 1)
+KBENCH_CASE(_kbench_mq_batch, 16)
+
+#define KBENCH_MQ_MSGS          4
+#define KBENCH_MQ_SIZE_MAX      512
+
+static rt_uint8_t _kbench_mq_payload[KBENCH_MQ_SIZE_MAX];
+
+/* a message sent and received by copy, without switch */
+static void _kbench_mq_copy(int size)
+{
+    static rt_uint8_t pool[KBENCH_MQ_MSGS * (KBENCH_MQ_SIZE_MAX + sizeof(void *))];
+    rt_uint32_t loop, stamp;
+
+    rt_mq_init(&_kbench_mq, "kmq", pool, size, sizeof(pool), RT_IPC_FLAG_FIFO);
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_mq_send(&_kbench_mq, _kbench_mq_payload, size);
+        rt_mq_recv(&_kbench_mq, _kbench_mq_payload, size, 0);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+    rt_mq_detach(&_kbench_mq);
+}
+KBENCH_CASE(_kbench_mq_copy, 16)
+KBENCH_CASE(_kbench_mq_copy, 128)
+KBENCH_CASE(_kbench_mq_copy, 512)
+
+#ifdef RT_USING_MEMPOOL
+/* a block allocated, passed by reference and freed, without switch */
+static void _kbench_mq_ref(int size)
+{
+    static struct rt_mempool mp;
+    static rt_uint8_t mp_pool[KBENCH_MQ_MSGS * (KBENCH_MQ_SIZE_MAX + sizeof(void *))];
+    static rt_uint8_t pool[KBENCH_MQ_MSGS * (sizeof(void *) + sizeof(void *))];
+    rt_uint32_t loop, stamp;
+    void *block;
+
+    rt_mp_init(&mp, "kmp", mp_pool, sizeof(mp_pool), size);
+    rt_mq_init_mp(&_kbench_mq, "kmq", pool, sizeof(pool), &mp, RT_IPC_FLAG_FIFO);
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        block = rt_mq_alloc(&_kbench_mq, 0);
+        rt_mq_send_ref(&_kbench_mq, block, 0);
+        rt_mq_recv_ref(&_kbench_mq, &block, 0);
+        rt_mp_free(block);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+    rt_mq_detach(&_kbench_mq);
+    rt_mp_detach(&mp);
+}
+KBENCH_CASE(_kbench_mq_ref, 16)
+KBENCH_CASE(_kbench_mq_ref, 128)
+KBENCH_CASE(_kbench_mq_ref, 512)
+#endif /* RT_USING_MEMPOOL */
+#endif /* RT_USING_MESSAGEQUEUE */
+
+#define KBENCH_TIMERS           8
+
+/* the number of timers fired */
+static volatile rt_uint32_t _kbench_fired;
+
+static void _kbench_timeout(void *parameter)
+{
+    _kbench_fired ++;
+}
+
+static void _kbench_timer_run(void)
+{
+    int index;
+    rt_uint32_t loop, stamp;
+    static struct rt_timer timers[KBENCH_TIMERS];
+
+    /* the timers of different timeout never expire in benchmark */
+    for (index = 0; index < KBENCH_TIMERS; index ++)
+    {
+        rt_timer_init(&timers[index], "ktimer", _kbench_timeout, RT_NULL,
+                      RT_TICK_PER_SECOND * (10 + index), RT_TIMER_FLAG_ONE_SHOT);
+        rt_timer_start(&timers[index]);
+    }
+
+    /* a stop and start of one timer among the others */
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_timer_stop(&timers[loop % KBENCH_TIMERS]);
+        rt_timer_start(&timers[loop % KBENCH_TIMERS]);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+
+    for (index = 0; index < KBENCH_TIMERS; index ++)
+        rt_timer_detach(&timers[index]);
+}
+
+#ifdef RT_USING_HEAP
+#ifdef RT_USING_TIMER_WHEEL
+#define KBENCH_TIMER_NAME       "timer_wheel"
+#else
+#define KBENCH_TIMER_NAME       "timer_list"
+#endif
+
+#define KBENCH_TIMER_START      0
+#define KBENCH_TIMER_STOP       1
+#define KBENCH_TIMER_EXPIRE     2
+
+/*
+ * the timeout spread in 10 ~ 20 seconds, it never expires in benchmark, even
+ * the tick is moved forward one tick each loop of timer expire
+ */
+#define KBENCH_TIMER_TIMEOUT(n) (RT_TICK_PER_SECOND * 10 + ((n) * 7919) % (RT_TICK_PER_SECOND * 10) + \
+                                 _kbench_loops)
+
+/* start, stop or expire one timer among the others */
+static void _kbench_timers(int count, int op)
+{
+    int index;
+    rt_base_t level;
+    rt_tick_t tick;
+    rt_uint32_t loop, stamp, fired;
+    struct rt_timer *timers, *timer;
+
+    timers = (struct rt_timer *)rt_malloc(sizeof(struct rt_timer) * (count + 1));
+    if (timers == RT_NULL)
+        return;
+
+    for (index = 0; index < count; index ++)
+    {
+        rt_timer_init(&timers[index], "ktimer", _kbench_timeout, RT_NULL,
+                      KBENCH_TIMER_TIMEOUT(index), RT_TIMER_FLAG_ONE_SHOT);
+        rt_timer_start(&timers[index]);
+    }
+    timer = &timers[count];
+    rt_timer_init(timer, "ktimer", _kbench_timeout, RT_NULL, 1, RT_TIMER_FLAG_ONE_SHOT);
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        tick = (op == KBENCH_TIMER_EXPIRE) ? 1 : KBENCH_TIMER_TIMEOUT(loop);
+        rt_timer_control(timer, RT_TIMER_CTRL_SET_TIME, &tick);
+
+        if (op == KBENCH_TIMER_START)
+        {
+            stamp = rt_timestamp_get();
+            rt_timer_start(timer);
+            _kbench_record(rt_timestamp_get() - stamp);
+            rt_timer_stop(timer);
+        }
+        else if (op == KBENCH_TIMER_STOP)
+        {
+            rt_timer_start(timer);
+            stamp = rt_timestamp_get();
+            rt_timer_stop(timer);
+            _kbench_record(rt_timestamp_get() - stamp);
+        }
+        else
+        {
+            /*
+             * the tick is moved to the timeout of timer and left there, as the
+             * timing wheel only goes forward. The scheduler is locked as it's
+             * not in interrupt.
+             */
+            rt_enter_critical();
+            level = rt_hw_interrupt_disable();
+            rt_timer_start(timer);
+            fired = _kbench_fired;
+            rt_tick_set(rt_tick_get() + 1);
+            stamp = rt_timestamp_get();
+            rt_timer_check();
+            stamp = rt_timestamp_get() - stamp;
+            rt_hw_interrupt_enable(level);
+            rt_exit_critical();
+
+            /* only the timer started is expired */
+            RT_ASSERT(_kbench_fired == fired + 1);
+            _kbench_record(stamp);
+        }
+    }
+
+    for (index = 0; index <= count; index ++)
+        rt_timer_detach(&timers[index]);
+    rt_free(timers);
+}
+
+static void _kbench_timer_start(int count)
+{
+    _kbench_timers(count, KBENCH_TIMER_START);
+}
+KBENCH_CASE(_kbench_timer_start, 10)
+KBENCH_CASE(_kbench_timer_start, 100)
+KBENCH_CASE(_kbench_timer_start, 1000)
+
+static void _kbench_timer_stop(int count)
+{
+    _kbench_timers(count, KBENCH_TIMER_STOP);
+}
+KBENCH_CASE(_kbench_timer_stop, 10)
+KBENCH_CASE(_kbench_timer_stop, 100)
+KBENCH_CASE(_kbench_timer_stop, 1000)
+
+static void _kbench_timer_expire(int count)
+{
+    _kbench_timers(count, KBENCH_TIMER_EXPIRE);
+}
+KBENCH_CASE(_kbench_timer_expire, 10)
+KBENCH_CASE(_kbench_timer_expire, 100)
+KBENCH_CASE(_kbench_timer_expire, 1000)
+#endif /* RT_USING_HEAP */
+
+#if defined(RT_USING_HEAP) || defined(RT_USING_MEMHEAP)
+#define KBENCH_BLOCKS           8
+
+/* a free and an allocation of mixed sizes, with some blocks alive */
+static void _kbench_alloc_mix(void *(*alloc)(rt_size_t size), void (*release)(void *ptr))
+{
+    static const rt_uint16_t sizes[] = {16, 200, 48, 1000, 24, 64, 512, 32};
+    void *blocks[KBENCH_BLOCKS];
+    rt_uint32_t loop, stamp;
+    int index;
+
+    for (index = 0; index < KBENCH_BLOCKS; index ++)
+        blocks[index] = alloc(sizes[index]);
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        index = loop % KBENCH_BLOCKS;
+
+        stamp = rt_timestamp_get();
+        if (blocks[index] != RT_NULL)
+            release(blocks[index]);
+        blocks[index] = alloc(sizes[(loop * 5 + 3) % KBENCH_BLOCKS]);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+
+    for (index = 0; index < KBENCH_BLOCKS; index ++)
+    {
+        if (blocks[index] != RT_NULL)
+            release(blocks[index]);
+    }
+}
+
+#define KBENCH_TRACE_SLOTS      16
+
+/* replay a trace of allocations and frees, the size and lifetime are random
+ * with a fixed seed, so that each heap backend runs the same requests */
+static void _kbench_alloc_trace(void *(*alloc)(rt_size_t size), void (*release)(void *ptr))
+{
+    static const rt_uint16_t sizes[] = {12, 16, 24, 32, 40, 64, 96, 128, 200, 256};
+    void *blocks[KBENCH_TRACE_SLOTS];
+    rt_uint32_t loop, stamp, seed;
+    int index;
+
+    rt_memset(blocks, 0, sizeof(blocks));
+    seed = 1;
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        seed  = seed * 1103515245 + 12345;
+        index = (seed >> 16) % KBENCH_TRACE_SLOTS;
+
+        stamp = rt_timestamp_get();
+        if (blocks[index] != RT_NULL)
+        {
+            release(blocks[index]);
+            blocks[index] = RT_NULL;
+        }
+        else
+        {
+            blocks[index] = alloc(sizes[(seed >> 8) % (sizeof(sizes) / sizeof(sizes[0]))]);
+        }
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+
+    for (index = 0; index < KBENCH_TRACE_SLOTS; index ++)
+    {
+        if (blocks[index] != RT_NULL)
+            release(blocks[index]);
+    }
+}
+#endif
+
+#ifdef RT_USING_HEAP
+static void _kbench_malloc_run(void)
+{
+    _kbench_alloc_mix(rt_malloc, rt_free);
+}
+
+static void _kbench_malloc_trace_run(void)
+{
+    _kbench_alloc_trace(rt_malloc, rt_free);
+}
+
+/* the heap backend in the name of case */
+#if defined(RT_USING_MEMHEAP_AS_HEAP)
+#define KBENCH_MALLOC_NAME      "malloc_memheap"
+#elif defined(RT_USING_TLSF)
+#define KBENCH_MALLOC_NAME      "malloc_tlsf"
+#elif defined(RT_USING_SLAB)
+#define KBENCH_MALLOC_NAME      "malloc_slab"
+#else
+#define KBENCH_MALLOC_NAME      "malloc_small"
+#endif
+#endif /* RT_USING_HEAP */
+
+#if defined(RT_USING_MEMHEAP) && !defined(RT_USING_MEMHEAP_AS_HEAP)
+static struct rt_memheap _kbench_memheap;
+static rt_uint8_t _kbench_memheap_pool[4096];
+
+static void *_kbench_memheap_alloc(rt_size_t size)
+{
+    return rt_memheap_alloc(&_kbench_memheap, size);
+}
+
+static void _kbench_memheap_run(void)
+{
+    rt_memheap_init(&_kbench_memheap, "kheap", _kbench_memheap_pool,
+                    sizeof(_kbench_memheap_pool));
+    _kbench_alloc_mix(_kbench_memheap_alloc, rt_memheap_free);
+    rt_memheap_detach(&_kbench_memheap);
+}
+
+static void _kbench_memheap_trace_run(void)
+{
+    rt_memheap_init(&_kbench_memheap, "kheap", _kbench_memheap_pool,
+                    sizeof(_kbench_memheap_pool));
+    _kbench_alloc_trace(_kbench_memheap_alloc, rt_memheap_free);
+    rt_memheap_detach(&_kbench_memheap);
+}
+#endif
+
+#ifdef RT_USING_MEMPOOL
+static void _kbench_mempool_run(void)
+{
+    static struct rt_mempool mp;
+    static rt_uint8_t pool[8 * (64 + sizeof(void *))];
+    rt_uint32_t loop, stamp;
+    void *block;
+
+    rt_mp_init(&mp, "kmp", pool, sizeof(pool), 64);
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        block = rt_mp_alloc(&mp, RT_WAITING_NO);
+        rt_mp_free(block);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+    rt_mp_detach(&mp);
+}
+#endif
+
+#define KBENCH_COPY_MAX         4096
+
+/*
+ * the cases of memory and string functions on the word alignments, the
+ * destination and source are both aligned, or both 3 bytes off, or the
+ * source is 3 bytes off the aligned destination, which is shifted in words
+ */
+#define KBENCH_ALIGN_CASES(fn, n)                                           \
+    static void fn##_##n##_aligned(void)                                    \
+    {                                                                       \
+        fn(n, 0, 0);                                                        \
+    }                                                                       \
+    static void fn##_##n##_same(void)                                       \
+    {                                                                       \
+        fn(n, 3, 3);                                                        \
+    }                                                                       \
+    static void fn##_##n##_shifted(void)                                    \
+    {                                                                       \
+        fn(n, 0, 3);                                                        \
+    }
+#define KBENCH_ALIGN_ENTRIES(name, fn, n)                                   \
+    {name "_" #n "_aligned",    fn##_##n##_aligned},                        \
+    {name "_" #n "_same",       fn##_##n##_same},                           \
+    {name "_" #n "_shifted",    fn##_##n##_shifted}
+
+/* the cases of a function on one buffer, aligned or 3 bytes off */
+#define KBENCH_OFFSET_CASES(fn, n)                                          \
+    static void fn##_##n##_aligned(void)                                    \
+    {                                                                       \
+        fn(n, 0, 0);                                                        \
+    }                                                                       \
+    static void fn##_##n##_unaligned(void)                                  \
+    {                                                                       \
+        fn(n, 0, 3);                                                        \
+    }
+#define KBENCH_OFFSET_ENTRIES(name, fn, n)                                  \
+    {name "_" #n "_aligned",    fn##_##n##_aligned},                        \
+    {name "_" #n "_unaligned",  fn##_##n##_unaligned}
+
+/* the source is large enough for the overlapped move */
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _kbench_copy_src[KBENCH_COPY_MAX + 16];
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _kbench_copy_dst[KBENCH_COPY_MAX + 16];
+
+static void _kbench_memcpy(int size, int dst, int src)
+{
+    rt_uint32_t loop, stamp;
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_memcpy(_kbench_copy_dst + dst, _kbench_copy_src + src, size);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+}
+KBENCH_ALIGN_CASES(_kbench_memcpy, 16)
+KBENCH_ALIGN_CASES(_kbench_memcpy, 256)
+KBENCH_ALIGN_CASES(_kbench_memcpy, 4096)
+
+/* the destination overlaps the end of source, it's copied backward */
+static void _kbench_memmove(int size, int dst, int src)
+{
+    rt_uint32_t loop, stamp;
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_memmove(_kbench_copy_src + 8 + dst, _kbench_copy_src + src, size);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+}
+KBENCH_ALIGN_CASES(_kbench_memmove, 16)
+KBENCH_ALIGN_CASES(_kbench_memmove, 256)
+KBENCH_ALIGN_CASES(_kbench_memmove, 4096)
+
+static void _kbench_memcmp(int size, int dst, int src)
+{
+    rt_uint32_t loop, stamp;
+    volatile rt_int32_t result;
+
+    /* the same bytes, so the whole length is compared */
+    rt_memset(_kbench_copy_src, 0x5a, sizeof(_kbench_copy_src));
+    rt_memset(_kbench_copy_dst, 0x5a, sizeof(_kbench_copy_dst));
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        result = rt_memcmp(_kbench_copy_dst + dst, _kbench_copy_src + src, size);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+    (void)result;
+}
+KBENCH_ALIGN_CASES(_kbench_memcmp, 16)
+KBENCH_ALIGN_CASES(_kbench_memcmp, 256)
+KBENCH_ALIGN_CASES(_kbench_memcmp, 4096)
+
+/* a string of size characters at the offset */
+static char *_kbench_string(rt_uint8_t *buffer, int size, int offset)
+{
+    rt_memset(buffer + offset, 'a', size);
+    buffer[offset + size] = '\0';
+
+    return (char *)buffer + offset;
+}
+
+/* the offset of destination is not used */
+static void _kbench_strlen(int size, int dst, int src)
+{
+    rt_uint32_t loop, stamp;
+    volatile rt_size_t result;
+    char *str;
+
+    str = _kbench_string(_kbench_copy_src, size, src);
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        result = rt_strlen(str);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+    (void)result;
+}
+KBENCH_OFFSET_CASES(_kbench_strlen, 16)
+KBENCH_OFFSET_CASES(_kbench_strlen, 256)
+KBENCH_OFFSET_CASES(_kbench_strlen, 4096)
+
+/* the same strings, so the whole length is compared up to the terminator */
+static void _kbench_strncmp(int size, int dst, int src)
+{
+    rt_uint32_t loop, stamp;
+    volatile rt_int32_t result;
+    char *cs, *ct;
+
+    cs = _kbench_string(_kbench_copy_dst, size, dst);
+    ct = _kbench_string(_kbench_copy_src, size, src);
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        result = rt_strncmp(cs, ct, size + 1);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+    (void)result;
+}
+KBENCH_ALIGN_CASES(_kbench_strncmp, 16)
+KBENCH_ALIGN_CASES(_kbench_strncmp, 256)
+KBENCH_ALIGN_CASES(_kbench_strncmp, 4096)
+
+#if defined(RT_USING_KLOG) && defined(RT_USING_CONSOLE)
+#define KBENCH_KLOG_LOOPS       32
+
+static void _kbench_klog_run(void)
+{
+    rt_uint32_t loop, stamp;
+
+    /* a line formatted into the log, which is printed as a comment of output */
+    for (loop = 0; loop < _kbench_loops && loop < KBENCH_KLOG_LOOPS; loop ++)
+    {
+        stamp = rt_timestamp_get();
+        rt_kprintf("# klog %d\n", loop);
+        _kbench_record(rt_timestamp_get() - stamp);
+
+        /* let the log thread write it out, it's never dropped */
+        rt_thread_delay(1);
+    }
+}
+#endif
+
+#ifdef RT_USING_HEAP
+#ifdef RT_USING_OBJECT_HASH
+#define KBENCH_FIND_NAME        "find_hash"
+#else
+#define KBENCH_FIND_NAME        "find_list"
+#endif
+
+/* look up one of the named objects */
+static void _kbench_find(int count)
+{
+    struct rt_semaphore *sems;
+    char name[RT_NAME_MAX];
+    rt_uint32_t loop, stamp;
+    int index;
+
+    sems = (struct rt_semaphore *)rt_malloc(sizeof(struct rt_semaphore) * count);
+    if (sems == RT_NULL)
+        return;
+
+    for (index = 0; index < count; index ++)
+    {
+        rt_snprintf(name, sizeof(name), "k%d", index);
+        rt_sem_init(&sems[index], name, 0, RT_IPC_FLAG_FIFO);
+    }
+
+    for (loop = 0; loop < _kbench_loops; loop ++)
+    {
+        rt_snprintf(name, sizeof(name), "k%d", (loop * 7) % count);
+
+        stamp = rt_timestamp_get();
+        rt_object_find(name, RT_Object_Class_Semaphore);
+        _kbench_record(rt_timestamp_get() - stamp);
+    }
+
+    for (index = 0; index < count; index ++)
+        rt_sem_detach(&sems[index]);
+    rt_free(sems);
+}
+KBENCH_CASE(_kbench_find, 500)
+#endif /* RT_USING_HEAP */
+
+static const struct
+{
+    const char *name;
+    void (*run)(void);
+} _kbench_cases[] =
+{
+    {"timestamp",       _kbench_timestamp_run},
+    {"critical",        _kbench_critical_run},
+    {KBENCH_SCHEDULE_NAME, _kbench_schedule_run},
+    {"yield",           _kbench_yield_run},
+    {"sem",             _kbench_sem_run},
+#ifdef RT_USING_HEAP
+    {"sem_wait_64",     _kbench_sem_wait_64},
+#endif
+#ifdef RT_USING_MUTEX
+    {"mutex",           _kbench_mutex_fast_run},
+    {"mutex_pi",        _kbench_mutex_run},
+#endif
+#ifdef RT_USING_EVENT
+    {"event_fanout",    _kbench_event_run},
+#endif
+#ifdef RT_USING_MAILBOX
+    {"mailbox",         _kbench_mb_run},
+    {"mailbox_x1",      _kbench_mb_batch_1},
+    {"mailbox_x16",     _kbench_mb_batch_16},
+#endif
+#ifdef RT_USING_MESSAGEQUEUE
+    {"mq",              _kbench_mq_run},
+    {"mq_x1",           _kbench_mq_batch_1},
+    {"mq_x16",          _kbench_mq_batch_16},
+    {"mq_copy_16",      _kbench_mq_copy_16},
+    {"mq_copy_128",     _kbench_mq_copy_128},
+    {"mq_copy_512",     _kbench_mq_copy_512},
+#ifdef RT_USING_MEMPOOL
+    {"mq_ref_16",       _kbench_mq_ref_16},
+    {"mq_ref_128",      _kbench_mq_ref_128},
+    {"mq_ref_512",      _kbench_mq_ref_512},
+#endif
+#endif
+    {"timer",           _kbench_timer_run},
+#ifdef RT_USING_HEAP
+    {KBENCH_TIMER_NAME "_start_10",     _kbench_timer_start_10},
+    {KBENCH_TIMER_NAME "_start_100",    _kbench_timer_start_100},
+    {KBENCH_TIMER_NAME "_start_1000",   _kbench_timer_start_1000},
+    {KBENCH_TIMER_NAME "_stop_10",      _kbench_timer_stop_10},
+    {KBENCH_TIMER_NAME "_stop_100",     _kbench_timer_stop_100},
+    {KBENCH_TIMER_NAME "_stop_1000",    _kbench_timer_stop_1000},
+    {KBENCH_TIMER_NAME "_expire_10",    _kbench_timer_expire_10},
+    {KBENCH_TIMER_NAME "_expire_100",   _kbench_timer_expire_100},
+    {KBENCH_TIMER_NAME "_expire_1000",  _kbench_timer_expire_1000},
+    {KBENCH_MALLOC_NAME, _kbench_malloc_run},
+    {KBENCH_MALLOC_NAME "_trace",       _kbench_malloc_trace_run},
+#endif
+#if defined(RT_USING_MEMHEAP) && !defined(RT_USING_MEMHEAP_AS_HEAP)
+    {"memheap",         _kbench_memheap_run},
+    {"memheap_trace",   _kbench_memheap_trace_run},
+#endif
+#ifdef RT_USING_MEMPOOL
+    {"mempool",         _kbench_mempool_run},
+#endif
+    KBENCH_ALIGN_ENTRIES("memcpy",  _kbench_memcpy,  16),
+    KBENCH_ALIGN_ENTRIES("memcpy",  _kbench_memcpy,  256),
+    KBENCH_ALIGN_ENTRIES("memcpy",  _kbench_memcpy,  4096),
+    KBENCH_ALIGN_ENTRIES("memmove", _kbench_memmove, 16),
+    KBENCH_ALIGN_ENTRIES("memmove", _kbench_memmove, 256),
+    KBENCH_ALIGN_ENTRIES("memmove", _kbench_memmove, 4096),
+    KBENCH_ALIGN_ENTRIES("memcmp",  _kbench_memcmp,  16),
+    KBENCH_ALIGN_ENTRIES("memcmp",  _kbench_memcmp,  256),
+    KBENCH_ALIGN_ENTRIES("memcmp",  _kbench_memcmp,  4096),
+    KBENCH_OFFSET_ENTRIES("strlen", _kbench_strlen, 16),
+    KBENCH_OFFSET_ENTRIES("strlen", _kbench_strlen, 256),
+    KBENCH_OFFSET_ENTRIES("strlen", _kbench_strlen, 4096),
+    KBENCH_ALIGN_ENTRIES("strncmp", _kbench_strncmp, 16),
+    KBENCH_ALIGN_ENTRIES("strncmp", _kbench_strncmp, 256),
+    KBENCH_ALIGN_ENTRIES("strncmp", _kbench_strncmp, 4096),
+#if defined(RT_USING_KLOG) && defined(RT_USING_CONSOLE)
+    {"klog",            _kbench_klog_run},
+#endif
+#ifdef RT_USING_HEAP
+    {KBENCH_FIND_NAME "_500",           _kbench_find_500},
+#endif
+};
+
+static void _kbench_report(const char *name)
+{
+    rt_uint32_t index, position, value, gap;
+    rt_uint64_t sum;
+
+    if (_kbench_count == 0)
+    {
+        rt_kprintf("%s,0,0,0,0,0\n", name);
+        return;
+    }
+
+    /* shell sort for the percentile */
+    for (gap = _kbench_count / 2; gap > 0; gap /= 2)
+    {
+        for (index = gap; index < _kbench_count; index ++)
+        {
+            value = _kbench_samples[index];
+            for (position = index;
+                 position >= gap && _kbench_samples[position - gap] > value;
+                 position -= gap)
+            {
+                _kbench_samples[position] = _kbench_samples[position - gap];
+            }
+            _kbench_samples[position] = value;
+        }
+    }
+
+    sum = 0;
+    for (index = 0; index < _kbench_count; index ++)
+        sum += _kbench_samples[index];
+
+    rt_kprintf("%s,%d,%d,%d,%d,%d\n", name, _kbench_count, _kbench_samples[0],
+               (rt_uint32_t)(sum / _kbench_count), _kbench_samples[_kbench_count - 1],
+               _kbench_samples[(_kbench_count * 99 + 99) / 100 - 1]);
+}
+
+static rt_uint32_t _kbench_number(const char *str)
+{
+    rt_uint32_t value;
+
+    for (value = 0; *str >= '0' && *str <= '9'; str ++)
+        value = value * 10 + (*str - '0');
+
+    return value;
+}
+
+static int kbench(int argc, char **argv)
+{
+    int index, found;
+    const char *name;
+
+    name = (argc > 1) ? argv[1] : "all";
+    _kbench_loops = (argc > 2) ? _kbench_number(argv[2]) : RT_KBENCH_SAMPLES;
+    if (argc > 3 || _kbench_loops == 0)
+        goto _usage;
+
+    rt_sem_init(&_kbench_done, "kdone", 0, RT_IPC_FLAG_FIFO);
+
+    rt_kprintf("# kbench %d\n", rt_timestamp_get_frequency());
+    rt_kprintf("case,count,min,avg,max,p99\n");
+    found = 0;
+    for (index = 0; index < sizeof(_kbench_cases) / sizeof(_kbench_cases[0]); index ++)
+    {
+        if (rt_strcmp(name, "all") != 0 && rt_strcmp(name, _kbench_cases[index].name) != 0)
+            continue;
+
+        _kbench_count = 0;
+        _kbench_cases[index].run();
+        _kbench_report(_kbench_cases[index].name);
+        found = 1;
+    }
+
+    rt_sem_detach(&_kbench_done);
+    if (found)
+        return 0;
+
+_usage:
+    rt_kprintf("Usage: kbench [case] [loops]\ncase: all");
+    for (index = 0; index < sizeof(_kbench_cases) / sizeof(_kbench_cases[0]); index ++)
+        rt_kprintf(" %s", _kbench_cases[index].name);
+    rt_kprintf("\n");
+
+    return -1;
+}
+MSH_CMD_EXPORT(kbench, kernel micro-benchmark);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_KBENCH */
@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ * 2026-10-17     weizx208     format in static buffers instead of the stack
+ * 2026-10-17     weizx208     format with interrupt enabled in a line of context
+ */
+
+/*
+ * Deferred console log.
+ *
+ * rt_kprintf formats the string and puts it into a ring buffer, the log thread
+ * writes the ring buffer to console later. So the caller is not blocked by the
+ * console device. The message is dropped when the ring buffer is full.
+ *
+ * The string is formatted in a static line, not in the stack of caller, so
+ * the stack of thread needn't hold a line. There are RT_KLOG_LINES lines, one
+ * for each nesting context: a thread, the thread which preempts it, and the
+ * nested interrupts. The caller takes a free line with interrupt disabled, and
+ * formats in it with interrupt enabled. The message is dropped if all the
+ * lines are taken.
+ *
+ * The string is written to console directly before the scheduler is started,
+ * and after rt_klog_flush() is invoked by the assert or fault handler.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_KLOG
+
+#if !defined(RT_USING_CONSOLE) || !defined(RT_USING_SEMAPHORE)
+#error "RT_USING_KLOG requires RT_USING_CONSOLE and RT_USING_SEMAPHORE"
+#endif
+
+#ifndef RT_KLOG_BUF_SIZE
+#define RT_KLOG_BUF_SIZE            1024
+#endif
+
+#if (RT_KLOG_BUF_SIZE & (RT_KLOG_BUF_SIZE - 1)) != 0
+#error "RT_KLOG_BUF_SIZE shall be power of 2"
+#endif
+
+#ifndef RT_KLOG_THREAD_PRIORITY
+#define RT_KLOG_THREAD_PRIORITY     (RT_THREAD_PRIORITY_MAX - 2)
+#endif
+
+#ifndef RT_KLOG_THREAD_STACK_SIZE
+#define RT_KLOG_THREAD_STACK_SIZE   512
+#endif
+
+#ifndef RT_KLOG_LEVEL
+#define RT_KLOG_LEVEL               RT_KLOG_DEBUG
+#endif
+
+#ifndef RT_KLOG_LINES
+#define RT_KLOG_LINES               4
+#endif
+
+#if RT_KLOG_LINES < 1 || RT_KLOG_LINES > 8
+#error "RT_KLOG_LINES shall be in 1 ~ 8"
+#endif
+
+static char _klog_buf[RT_KLOG_BUF_SIZE];
+/* the in index is only changed with interrupt disabled, out by the log thread */
+static volatile rt_uint32_t _klog_in = 0;
+static volatile rt_uint32_t _klog_out = 0;
+
+static rt_uint32_t _klog_dropped = 0;
+static rt_uint32_t _klog_dropped_bytes = 0;
+static rt_uint8_t _klog_level = RT_KLOG_LEVEL;
+/* write to console directly */
+static volatile rt_uint8_t _klog_sync = 1;
+
+static struct rt_semaphore _klog_sem;
+static struct rt_thread _klog_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _klog_thread_stack[RT_KLOG_THREAD_STACK_SIZE];
+
+static const char *const _klog_prefix[] =
+{
+    "[E] ", "[E] ", "[E] ", "[E] ", "[W] ", "[I] ", "[I] ", "[D] "
+};
+
+/* the format lines of nesting contexts, a bit of the mask for each taken line */
+static char _klog_lines[RT_KLOG_LINES][RT_CONSOLEBUF_SIZE];
+static rt_uint8_t _klog_lines_busy = 0;
+
+/* format the string with prefix in a static line, and put it into log */
+static void _klog_vprintf(const char *prefix, const char *fmt, va_list args)
+{
+    rt_base_t level;
+    rt_size_t length, size;
+    int index;
+    char *line;
+
+    /* only the line is taken with interrupt disabled */
+    level = rt_hw_interrupt_disable();
+    for (index = 0; index < RT_KLOG_LINES; index ++)
+    {
+        if (!(_klog_lines_busy & (1 << index)))
+            break;
+    }
+    if (index == RT_KLOG_LINES)
+    {
+        _klog_dropped ++;
+        rt_hw_interrupt_enable(level);
+
+        return;
+    }
+    _klog_lines_busy |= (1 << index);
+    rt_hw_interrupt_enable(level);
+
+    line = _klog_lines[index];
+
+    size = 0;
+    if (prefix != RT_NULL)
+    {
+        size = rt_strlen(prefix);
+        rt_memcpy(line, prefix, size);
+    }
+
+    /* the return value of vsnprintf is the length had the buffer been
+     * sufficiently large, the string is truncated to the buffer */
+    length = rt_vsnprintf(line + size, RT_CONSOLEBUF_SIZE - size, fmt, args);
+    length += size;
+    if (length > RT_CONSOLEBUF_SIZE - 1)
+        length = RT_CONSOLEBUF_SIZE - 1;
+
+    rt_klog_write(line, length);
+
+    level = rt_hw_interrupt_disable();
+    _klog_lines_busy &= ~(1 << index);
+    rt_hw_interrupt_enable(level);
+}
+
+/* write the buffered log to console, it returns when the buffer is empty */
+static void _klog_drain(void)
+{
+    static char line[RT_CONSOLEBUF_SIZE + 1];
+    rt_base_t level;
+    rt_uint32_t out, offset, length;
+
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        out = _klog_out;
+        length = _klog_in - out;
+        rt_hw_interrupt_enable(level);
+
+        if (length == 0)
+            break;
+
+        offset = out & (RT_KLOG_BUF_SIZE - 1);
+        if (length > RT_KLOG_BUF_SIZE - offset)
+            length = RT_KLOG_BUF_SIZE - offset;
+        if (length > RT_CONSOLEBUF_SIZE)
+            length = RT_CONSOLEBUF_SIZE;
+
+        rt_memcpy(line, &_klog_buf[offset], length);
+        line[length] = '\0';
+        rt_console_output(line, length);
+
+        _klog_out = out + length;
+    }
+}
+
+static void _klog_thread_entry(void *parameter)
+{
+    while (1)
+    {
+        rt_sem_take(&_klog_sem, RT_WAITING_FOREVER);
+        _klog_drain();
+    }
+}
+
+/**
+ * @addtogroup KernelService
+ */
+
+/**@{*/
+
+/**
+ * This function will put a string into the log buffer, it's invoked by
+ * rt_kprintf and rt_kputs.
+ *
+ * @param str the string
+ * @param length the length of string
+ *
+ * @return the length of string put into buffer, 0 if it's dropped.
+ */
+rt_size_t rt_klog_write(const char *str, rt_size_t length)
+{
+    rt_base_t level;
+    rt_uint32_t in, offset, size;
+    rt_bool_t empty;
+
+    if (_klog_sync || rt_thread_self() == RT_NULL)
+    {
+        rt_console_output(str, length);
+
+        return length;
+    }
+
+    level = rt_hw_interrupt_disable();
+
+    in = _klog_in;
+    if (length > RT_KLOG_BUF_SIZE - (in - _klog_out))
+    {
+        _klog_dropped ++;
+        _klog_dropped_bytes += length;
+        rt_hw_interrupt_enable(level);
+
+        return 0;
+    }
+    empty = (in == _klog_out);
+
+    /* the string is copied with interrupt disabled, it's short */
+    offset = in & (RT_KLOG_BUF_SIZE - 1);
+    size = RT_KLOG_BUF_SIZE - offset;
+    if (size > length)
+        size = length;
+    rt_memcpy(&_klog_buf[offset], str, size);
+    rt_memcpy(&_klog_buf[0], str + size, length - size);
+    _klog_in = in + length;
+
+    rt_hw_interrupt_enable(level);
+
+    /* wake up the log thread */
+    if (empty)
+        rt_sem_release(&_klog_sem);
+
+    return length;
+}
+
+/**
+ * This function will print a formatted string into the log buffer, it's
+ * invoked by rt_kprintf.
+ *
+ * @param fmt the format
+ * @param args the arguments of format
+ */
+void rt_klog_vprintf(const char *fmt, va_list args)
+{
+    _klog_vprintf(RT_NULL, fmt, args);
+}
+
+/**
+ * This function will print a formatted string with the severity level. It's
+ * dropped when the level is lower than the level set by rt_klog_set_level.
+ *
+ * @param level the severity level, RT_KLOG_ERROR ~ RT_KLOG_DEBUG
+ * @param fmt the format
+ */
+void rt_klog(rt_uint8_t level, const char *fmt, ...)
+{
+    va_list args;
+
+    if (level > _klog_level)
+        return;
+
+    if (level > RT_KLOG_DEBUG)
+        level = RT_KLOG_DEBUG;
+
+    va_start(args, fmt);
+    _klog_vprintf(_klog_prefix[level], fmt, args);
+    va_end(args);
+}
+
+/**
+ * This function will set the lowest severity level of rt_klog to print.
+ *
+ * @param level the severity level, RT_KLOG_ERROR ~ RT_KLOG_DEBUG
+ */
+void rt_klog_set_level(rt_uint8_t level)
+{
+    _klog_level = level;
+}
+
+/**
+ * This function will write the buffered log to console immediately, and the
+ * log is written to console directly after then. It's used when the system is
+ * going to stop, such as an assertion or fault.
+ */
+void rt_klog_flush(void)
+{
+    _klog_sync = 1;
+    _klog_drain();
+}
+
+/**
+ * This function will initialize the log thread, the log is buffered after
+ * the thread is started.
+ */
+void rt_klog_init(void)
+{
+    rt_sem_init(&_klog_sem, "klog", 0, RT_IPC_FLAG_FIFO);
+
+    rt_thread_init(&_klog_thread,
+                   "klog",
+                   _klog_thread_entry,
+                   RT_NULL,
+                   &_klog_thread_stack[0],
+                   sizeof(_klog_thread_stack),
+                   RT_KLOG_THREAD_PRIORITY,
+                   10);
+    rt_thread_startup(&_klog_thread);
+
+    _klog_sync = 0;
+}
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static int klog(int argc, char **argv)
+{
+    if (argc == 3 && !rt_strcmp(argv[1], "level") &&
+        argv[2][0] >= '0' && argv[2][0] <= '7' && argv[2][1] == '\0')
+    {
+        rt_klog_set_level(argv[2][0] - '0');
+    }
+    else if (argc != 1)
+    {
+        rt_kprintf("Usage: klog [level 3|4|6|7]\n");
+
+        return 0;
+    }
+
+    rt_kprintf("buffer: %d/%d, dropped: %d messages %d bytes, level: %d\n",
+               _klog_in - _klog_out, RT_KLOG_BUF_SIZE,
+               _klog_dropped, _klog_dropped_bytes, _klog_level);
+
+    return 0;
+}
+MSH_CMD_EXPORT(klog, deferred console log);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_KLOG */
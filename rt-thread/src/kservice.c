@@ -17,6 +17,9 @@
  * 2013-06-24     Bernard      remove rt_kprintf if RT_USING_CONSOLE is not defined.
  * 2013-09-24     aozima       make sure the device is in STREAM mode when used by rt_kprintf.
  * 2015-07-06     Bernard      Add rt_assert_handler routine.
+ * 2026-10-17     weizx208     copy and compare unaligned memory in words.
+ * 2026-10-17     weizx208     put the output of rt_kprintf into deferred log.
+ * 2026-10-17     weizx208     format rt_kprintf in the buffer of deferred log.
  */
 
 #include <rtthread.h>
@@ -189,6 +192,175 @@ void *rt_memset(void *s, int c, rt_ubase_t count)
 #endif
 }
 
+#ifndef RT_USING_TINY_SIZE
+/*
+ * The memory and string functions work on the words of the CPU. When the
+ * source and destination are not aligned in the same way, the source is read
+ * in aligned words, and each word is shifted into place with the previous one,
+ * so the unaligned copies and comparisons run at the speed of word access too.
+ * The bytes out of the buffer are never read, except that rt_strlen() and
+ * rt_strncmp() read the aligned word which holds the terminator.
+ */
+#define RT_WORD_SIZE            (sizeof(unsigned long))
+#define RT_WORD_BITS            (RT_WORD_SIZE * 8)
+#define RT_WORD_OFFSET(X)       ((rt_ubase_t)(X) & (RT_WORD_SIZE - 1))
+#define RT_WORD_BLOCK_SIZE      (RT_WORD_SIZE << 2)
+
+/* move the bytes of a word toward the lower or higher address */
+#ifdef ARCH_CPU_BIG_ENDIAN
+#define RT_WORD_DOWN(word, bits)    ((word) << (bits))
+#define RT_WORD_UP(word, bits)      ((word) >> (bits))
+#else
+#define RT_WORD_DOWN(word, bits)    ((word) >> (bits))
+#define RT_WORD_UP(word, bits)      ((word) << (bits))
+#endif
+
+/* non-zero if there is a zero byte in the word */
+#define RT_WORD_ONES            (~0UL / 0xff)
+#define RT_WORD_HAS_ZERO(word)  (((word) - RT_WORD_ONES) & ~(word) & (RT_WORD_ONES << 7))
+
+static void _rt_copy_forward(rt_uint8_t *dst, const rt_uint8_t *src, rt_ubase_t count)
+{
+    unsigned long *aligned_dst;
+    const unsigned long *aligned_src;
+    unsigned long word, carry;
+    rt_ubase_t offset, shift, index;
+
+    if (count >= RT_WORD_BLOCK_SIZE)
+    {
+        /* align the destination */
+        while (RT_WORD_OFFSET(dst))
+        {
+            *dst++ = *src++;
+            count --;
+        }
+        aligned_dst = (unsigned long *)dst;
+
+        offset = RT_WORD_OFFSET(src);
+        if (offset == 0)
+        {
+            aligned_src = (const unsigned long *)src;
+
+            /* copy 4 words at a time, which is a burst of LDM/STM on ARM */
+            while (count >= RT_WORD_BLOCK_SIZE)
+            {
+                *aligned_dst++ = *aligned_src++;
+                *aligned_dst++ = *aligned_src++;
+                *aligned_dst++ = *aligned_src++;
+                *aligned_dst++ = *aligned_src++;
+                count -= RT_WORD_BLOCK_SIZE;
+            }
+
+            while (count >= RT_WORD_SIZE)
+            {
+                *aligned_dst++ = *aligned_src++;
+                count -= RT_WORD_SIZE;
+            }
+
+            src = (const rt_uint8_t *)aligned_src;
+        }
+        else
+        {
+            /* the head of source in the first aligned word */
+            carry = 0;
+            for (index = 0; index < RT_WORD_SIZE - offset; index ++)
+                ((rt_uint8_t *)&carry)[index] = src[index];
+
+            aligned_src = (const unsigned long *)(src - offset) + 1;
+            shift = offset * 8;
+
+            /* the loaded word is always inside of source */
+            while (count >= RT_WORD_SIZE * 2)
+            {
+                word = *aligned_src++;
+                *aligned_dst++ = carry | RT_WORD_UP(word, RT_WORD_BITS - shift);
+                carry = RT_WORD_DOWN(word, shift);
+                count -= RT_WORD_SIZE;
+            }
+
+            src = (const rt_uint8_t *)aligned_src - (RT_WORD_SIZE - offset);
+        }
+
+        dst = (rt_uint8_t *)aligned_dst;
+    }
+
+    while (count--)
+        *dst++ = *src++;
+}
+
+static void _rt_copy_backward(rt_uint8_t *dst, const rt_uint8_t *src, rt_ubase_t count)
+{
+    unsigned long *aligned_dst;
+    const unsigned long *aligned_src;
+    unsigned long word, carry;
+    rt_ubase_t offset, shift, index;
+
+    /* copy from the end */
+    dst += count;
+    src += count;
+
+    if (count >= RT_WORD_BLOCK_SIZE)
+    {
+        /* align the end of destination */
+        while (RT_WORD_OFFSET(dst))
+        {
+            *--dst = *--src;
+            count --;
+        }
+        aligned_dst = (unsigned long *)dst;
+
+        offset = RT_WORD_OFFSET(src);
+        if (offset == 0)
+        {
+            aligned_src = (const unsigned long *)src;
+
+            while (count >= RT_WORD_BLOCK_SIZE)
+            {
+                *--aligned_dst = *--aligned_src;
+                *--aligned_dst = *--aligned_src;
+                *--aligned_dst = *--aligned_src;
+                *--aligned_dst = *--aligned_src;
+                count -= RT_WORD_BLOCK_SIZE;
+            }
+
+            while (count >= RT_WORD_SIZE)
+            {
+                *--aligned_dst = *--aligned_src;
+                count -= RT_WORD_SIZE;
+            }
+
+            src = (const rt_uint8_t *)aligned_src;
+        }
+        else
+        {
+            /* the tail of source in the last aligned word */
+            carry = 0;
+            for (index = 0; index < offset; index ++)
+                ((rt_uint8_t *)&carry)[RT_WORD_SIZE - offset + index] = src[index - offset];
+
+            aligned_src = (const unsigned long *)(src - offset);
+            shift = offset * 8;
+
+            /* the loaded word is always inside of source */
+            while (count >= RT_WORD_SIZE * 2)
+            {
+                word = *--aligned_src;
+                *--aligned_dst = carry | RT_WORD_DOWN(word, shift);
+                carry = RT_WORD_UP(word, RT_WORD_BITS - shift);
+                count -= RT_WORD_SIZE;
+            }
+
+            src = (const rt_uint8_t *)aligned_src + offset;
+        }
+
+        dst = (rt_uint8_t *)aligned_dst;
+    }
+
+    while (count--)
+        *--dst = *--src;
+}
+#endif
+
 /**
  * This function will copy memory content from source address to destination
  * address.
@@ -218,56 +390,9 @@ void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
 
     return dst;
 #else
-
-#define UNALIGNED(X, Y) \
-    (((long)X & (sizeof (long) - 1)) | ((long)Y & (sizeof (long) - 1)))
-#define BIGBLOCKSIZE    (sizeof (long) << 2)
-#define LITTLEBLOCKSIZE (sizeof (long))
-#define TOO_SMALL(LEN)  ((LEN) < BIGBLOCKSIZE)
-
-    char *dst_ptr = (char *)dst;
-    char *src_ptr = (char *)src;
-    long *aligned_dst;
-    long *aligned_src;
-    int len = count;
-
-    /* If the size is small, or either SRC or DST is unaligned,
-    then punt into the byte copy loop.  This should be rare. */
-    if (!TOO_SMALL(len) && !UNALIGNED(src_ptr, dst_ptr))
-    {
-        aligned_dst = (long *)dst_ptr;
-        aligned_src = (long *)src_ptr;
-
-        /* Copy 4X long words at a time if possible. */
-        while (len >= BIGBLOCKSIZE)
-        {
-            *aligned_dst++ = *aligned_src++;
-            *aligned_dst++ = *aligned_src++;
-            *aligned_dst++ = *aligned_src++;
-            *aligned_dst++ = *aligned_src++;
-            len -= BIGBLOCKSIZE;
-        }
-
-        /* Copy one long word at a time if possible. */
-        while (len >= LITTLEBLOCKSIZE)
-        {
-            *aligned_dst++ = *aligned_src++;
-            len -= LITTLEBLOCKSIZE;
-        }
-
-        /* Pick up any residual with a byte copier. */
-        dst_ptr = (char *)aligned_dst;
-        src_ptr = (char *)aligned_src;
-    }
-
-    while (len--)
-        *dst_ptr++ = *src_ptr++;
+    _rt_copy_forward((rt_uint8_t *)dst, (const rt_uint8_t *)src, count);
 
     return dst;
-#undef UNALIGNED
-#undef BIGBLOCKSIZE
-#undef LITTLEBLOCKSIZE
-#undef TOO_SMALL
 #endif
 }
 
@@ -283,6 +408,18 @@ void *rt_memcpy(void *dst, const void *src, rt_ubase_t count)
  */
 void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
 {
+#ifndef RT_USING_TINY_SIZE
+    rt_uint8_t *tmp = (rt_uint8_t *)dest;
+    const rt_uint8_t *s = (const rt_uint8_t *)src;
+
+    /* copy backward if the destination overlaps the end of source */
+    if (s < tmp && tmp < s + n)
+        _rt_copy_backward(tmp, s, n);
+    else
+        _rt_copy_forward(tmp, s, n);
+
+    return dest;
+#else
     char *tmp = (char *)dest, *s = (char *)src;
 
     if (s < tmp && tmp < s + n)
@@ -300,6 +437,7 @@ void *rt_memmove(void *dest, const void *src, rt_ubase_t n)
     }
 
     return dest;
+#endif
 }
 
 /**
@@ -316,9 +454,76 @@ rt_int32_t rt_memcmp(const void *cs, const void *ct, rt_ubase_t count)
     const unsigned char *su1, *su2;
     int res = 0;
 
+#ifndef RT_USING_TINY_SIZE
+    const unsigned long *aligned1, *aligned2;
+    unsigned long word, carry;
+    rt_ubase_t offset, shift, index;
+
+    su1 = (const unsigned char *)cs;
+    su2 = (const unsigned char *)ct;
+
+    if (count >= RT_WORD_BLOCK_SIZE)
+    {
+        /* align the first area */
+        while (RT_WORD_OFFSET(su1))
+        {
+            if ((res = *su1 - *su2) != 0)
+                return res;
+            su1 ++;
+            su2 ++;
+            count --;
+        }
+        aligned1 = (const unsigned long *)su1;
+
+        /* skip the equal words, the different one is found by bytes below */
+        offset = RT_WORD_OFFSET(su2);
+        if (offset == 0)
+        {
+            aligned2 = (const unsigned long *)su2;
+            while (count >= RT_WORD_SIZE && *aligned1 == *aligned2)
+            {
+                aligned1 ++;
+                aligned2 ++;
+                count -= RT_WORD_SIZE;
+            }
+
+            su2 = (const unsigned char *)aligned2;
+        }
+        else
+        {
+            carry = 0;
+            for (index = 0; index < RT_WORD_SIZE - offset; index ++)
+                ((rt_uint8_t *)&carry)[index] = su2[index];
+
+            aligned2 = (const unsigned long *)(su2 - offset) + 1;
+            shift = offset * 8;
+
+            while (count >= RT_WORD_SIZE * 2)
+            {
+                word = *aligned2;
+                if (*aligned1 != (carry | RT_WORD_UP(word, RT_WORD_BITS - shift)))
+                    break;
+
+                carry = RT_WORD_DOWN(word, shift);
+                aligned1 ++;
+                aligned2 ++;
+                count -= RT_WORD_SIZE;
+            }
+
+            su2 = (const unsigned char *)aligned2 - (RT_WORD_SIZE - offset);
+        }
+
+        su1 = (const unsigned char *)aligned1;
+    }
+
+    for (; 0 < count; ++su1, ++su2, count--)
+        if ((res = *su1 - *su2) != 0)
+            break;
+#else
     for (su1 = (const unsigned char *)cs, su2 = (const unsigned char *)ct; 0 < count; ++su1, ++su2, count--)
         if ((res = *su1 - *su2) != 0)
             break;
+#endif
 
     return res;
 }
@@ -420,6 +625,29 @@ rt_int32_t rt_strncmp(const char *cs, const char *ct, rt_ubase_t count)
 {
     register signed char __res = 0;
 
+#ifndef RT_USING_TINY_SIZE
+    /* compare in words when the strings are aligned in the same way */
+    if (count >= RT_WORD_SIZE && RT_WORD_OFFSET((rt_ubase_t)cs ^ (rt_ubase_t)ct) == 0)
+    {
+        while (count && RT_WORD_OFFSET(cs))
+        {
+            if ((__res = *cs - *ct++) != 0 || !*cs++)
+                return __res;
+            count --;
+        }
+
+        /* stop at the word which is different or holds the terminator */
+        while (count >= RT_WORD_SIZE &&
+               *(const unsigned long *)cs == *(const unsigned long *)ct &&
+               !RT_WORD_HAS_ZERO(*(const unsigned long *)cs))
+        {
+            cs += RT_WORD_SIZE;
+            ct += RT_WORD_SIZE;
+            count -= RT_WORD_SIZE;
+        }
+    }
+#endif
+
     while (count)
     {
         if ((__res = *cs - *ct++) != 0 || !*cs++)
@@ -482,7 +710,25 @@ rt_size_t rt_strlen(const char *s)
 {
     const char *sc;
 
-    for (sc = s; *sc != '\0'; ++sc) /* nothing */
+#ifndef RT_USING_TINY_SIZE
+    const unsigned long *aligned;
+
+    for (sc = s; RT_WORD_OFFSET(sc); ++sc)
+    {
+        if (*sc == '\0')
+            return sc - s;
+    }
+
+    /* find the word which holds the terminator */
+    for (aligned = (const unsigned long *)sc; !RT_WORD_HAS_ZERO(*aligned); ++aligned) /* nothing */
+        ;
+
+    sc = (const char *)aligned;
+#else
+    sc = s;
+#endif
+
+    for (; *sc != '\0'; ++sc) /* nothing */
         ;
 
     return sc - s;
@@ -1130,14 +1376,13 @@ RT_WEAK void rt_hw_console_output(const char *str)
 }
 
 /**
- * This function will put string to the console.
+ * This function will write string to the console device immediately.
  *
- * @param str the string output to the console.
+ * @param str the string output to the console, which is terminated by null.
+ * @param length the length of string
  */
-void rt_kputs(const char *str)
+void rt_console_output(const char *str, rt_size_t length)
 {
-    if (!str) return;
-
 #ifdef RT_USING_DEVICE
     if (_console_device == RT_NULL)
     {
@@ -1148,7 +1393,7 @@ void rt_kputs(const char *str)
         rt_uint16_t old_flag = _console_device->open_flag;
 
         _console_device->open_flag |= RT_DEVICE_FLAG_STREAM;
-        rt_device_write(_console_device, 0, str, rt_strlen(str));
+        rt_device_write(_console_device, 0, str, length);
         _console_device->open_flag = old_flag;
     }
 #else
@@ -1156,6 +1401,22 @@ void rt_kputs(const char *str)
 #endif
 }
 
+/**
+ * This function will put string to the console.
+ *
+ * @param str the string output to the console.
+ */
+void rt_kputs(const char *str)
+{
+    if (!str) return;
+
+#ifdef RT_USING_KLOG
+    rt_klog_write(str, rt_strlen(str));
+#else
+    rt_console_output(str, rt_strlen(str));
+#endif
+}
+
 /**
  * This function will print a formatted string on system console
  *
@@ -1164,6 +1425,12 @@ void rt_kputs(const char *str)
 void rt_kprintf(const char *fmt, ...)
 {
     va_list args;
+#ifdef RT_USING_KLOG
+    /* formatted in the buffer of log */
+    va_start(args, fmt);
+    rt_klog_vprintf(fmt, args);
+    va_end(args);
+#else
     rt_size_t length;
     static char rt_log_buf[RT_CONSOLEBUF_SIZE];
 
@@ -1176,23 +1443,9 @@ void rt_kprintf(const char *fmt, ...)
     length = rt_vsnprintf(rt_log_buf, sizeof(rt_log_buf) - 1, fmt, args);
     if (length > RT_CONSOLEBUF_SIZE - 1)
         length = RT_CONSOLEBUF_SIZE - 1;
-#ifdef RT_USING_DEVICE
-    if (_console_device == RT_NULL)
-    {
-        rt_hw_console_output(rt_log_buf);
-    }
-    else
-    {
-        rt_uint16_t old_flag = _console_device->open_flag;
-
-        _console_device->open_flag |= RT_DEVICE_FLAG_STREAM;
-        rt_device_write(_console_device, 0, rt_log_buf, length);
-        _console_device->open_flag = old_flag;
-    }
-#else
-    rt_hw_console_output(rt_log_buf);
-#endif
+    rt_console_output(rt_log_buf, length);
     va_end(args);
+#endif
 }
 #endif
 
@@ -1336,6 +1589,10 @@ void rt_assert_handler(const char *ex_string, const char *func, rt_size_t line)
 
     if (rt_assert_hook == RT_NULL)
     {
+#if defined(RT_USING_KLOG) && defined(RT_USING_CONSOLE)
+        /* the log thread will not run again */
+        rt_klog_flush();
+#endif
         rt_kprintf("(%s) assertion failed at function:%s, line number:%d \n", ex_string, func, line);
         while (dummy == 0);
     }
@@ -12,6 +12,7 @@
  * 2010-10-14     Bernard      fix rt_realloc issue when realloc a NULL pointer.
  * 2017-07-14     armink       fix rt_realloc issue when new size is 0
  * 2018-10-02     Bernard      Add 64bit support
+ * 2026-10-17     weizx208     release the list of memory cache in one lock
  */
 
 /*
@@ -279,6 +280,21 @@ void *rt_malloc(rt_size_t size)
 
     RT_DEBUG_NOT_IN_INTERRUPT;
 
+#ifdef RT_USING_MEM_CACHE
+    /* try the small memory cache of thread first */
+    {
+        void *cached;
+
+        cached = rt_mem_cache_alloc(&size);
+        if (cached != RT_NULL)
+        {
+            RT_OBJECT_HOOK_CALL(rt_malloc_hook, (cached, size));
+
+            return cached;
+        }
+    }
+#endif
+
     if (size != RT_ALIGN(size, RT_ALIGN_SIZE))
         RT_DEBUG_LOG(RT_DEBUG_MEM, ("malloc size %d, but align to %d\n",
                                     size, RT_ALIGN(size, RT_ALIGN_SIZE)));
@@ -540,6 +556,38 @@ void *rt_calloc(rt_size_t count, rt_size_t size)
     return p;
 }
 
+/* release a block, it's invoked with the heap locked */
+static void _heap_free(struct heap_mem *mem)
+{
+    /* ... which has to be in a used state ... */
+    if (!mem->used || mem->magic != HEAP_MAGIC)
+    {
+        rt_kprintf("to free a bad data block:\n");
+        rt_kprintf("mem: 0x%08x, used flag: %d, magic code: 0x%04x\n", mem, mem->used, mem->magic);
+    }
+    RT_ASSERT(mem->used);
+    RT_ASSERT(mem->magic == HEAP_MAGIC);
+    /* ... and is now unused. */
+    mem->used  = 0;
+    mem->magic = HEAP_MAGIC;
+#ifdef RT_USING_MEMTRACE
+    rt_mem_setname(mem, "    ");
+#endif
+
+    if (mem < lfree)
+    {
+        /* the newly freed struct is now the lowest */
+        lfree = mem;
+    }
+
+#ifdef RT_MEM_STATS
+    used_mem -= (mem->next - ((rt_uint8_t *)mem - heap_ptr));
+#endif
+
+    /* finally, see if prev or next are free also */
+    plug_holes(mem);
+}
+
 /**
  * This function will release the previously allocated memory block by
  * rt_malloc. The released memory block is taken back to system heap.
@@ -577,39 +625,44 @@ void rt_free(void *rmem)
                   (rt_ubase_t)rmem,
                   (rt_ubase_t)(mem->next - ((rt_uint8_t *)mem - heap_ptr))));
 
+#ifdef RT_USING_MEM_CACHE
+    /* keep it in the small memory cache of thread */
+    if (mem->used && mem->magic == HEAP_MAGIC &&
+        rt_mem_cache_free(rmem, mem->next - ((rt_uint8_t *)mem - heap_ptr) - SIZEOF_STRUCT_MEM))
+        return;
+#endif
 
     /* protect the heap from concurrent access */
     rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+    _heap_free(mem);
+    rt_sem_release(&heap_sem);
+}
 
-    /* ... which has to be in a used state ... */
-    if (!mem->used || mem->magic != HEAP_MAGIC)
-    {
-        rt_kprintf("to free a bad data block:\n");
-        rt_kprintf("mem: 0x%08x, used flag: %d, magic code: 0x%04x\n", mem, mem->used, mem->magic);
-    }
-    RT_ASSERT(mem->used);
-    RT_ASSERT(mem->magic == HEAP_MAGIC);
-    /* ... and is now unused. */
-    mem->used  = 0;
-    mem->magic = HEAP_MAGIC;
-#ifdef RT_USING_MEMTRACE
-    rt_mem_setname(mem, "    ");
-#endif
+#ifdef RT_USING_MEM_CACHE
+/**
+ * This function will release a list of memory blocks to system heap, the heap
+ * is locked once for all of them. It's used by the small memory cache of
+ * thread, the free hook has been invoked when the blocks were cached.
+ *
+ * @param list the first block, each block is linked by its first word
+ */
+void rt_free_list(void *list)
+{
+    void *rmem;
 
-    if (mem < lfree)
-    {
-        /* the newly freed struct is now the lowest */
-        lfree = mem;
-    }
+    RT_DEBUG_NOT_IN_INTERRUPT;
 
-#ifdef RT_MEM_STATS
-    used_mem -= (mem->next - ((rt_uint8_t *)mem - heap_ptr));
-#endif
+    rt_sem_take(&heap_sem, RT_WAITING_FOREVER);
+    while (list != RT_NULL)
+    {
+        rmem = list;
+        list = *(void **)rmem;
 
-    /* finally, see if prev or next are free also */
-    plug_holes(mem);
+        _heap_free((struct heap_mem *)((rt_uint8_t *)rmem - SIZEOF_STRUCT_MEM));
+    }
     rt_sem_release(&heap_sem);
 }
+#endif
 
 #ifdef RT_MEM_STATS
 void rt_memory_info(rt_uint32_t *total,
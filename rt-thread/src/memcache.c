@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ * 2026-10-17     weizx208     release the blocks to heap in one lock
+ * 2026-10-17     weizx208     check double free of cached block in debug
+ */
+
+/*
+ * Small memory cache of thread.
+ *
+ * Each thread keeps a few free blocks of the small size classes, so that the
+ * common small allocations are served without taking the lock of heap. When a
+ * class of the cache is full, half of its blocks are returned to the heap by
+ * rt_free_list(), which takes the lock of heap once for them. The cache of a
+ * closed thread is reclaimed by the idle thread.
+ *
+ * A cached block skips the checks of heap in rt_free(), so a double free is
+ * not found by the heap. With RT_DEBUG, rt_free() asserts that the block is
+ * not in the same class of the cache of current thread already, the block
+ * cached by another thread is not checked.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined (RT_USING_HEAP) && defined (RT_USING_MEM_CACHE)
+
+#ifdef RT_USING_SLAB
+#error "RT_USING_MEM_CACHE works with small memory, TLSF or memheap algorithm"
+#endif
+
+/* the maximum number of free blocks in each size class */
+#ifndef RT_MEM_CACHE_DEPTH
+#define RT_MEM_CACHE_DEPTH      8
+#endif
+
+#define MEM_CACHE_SIZE_MIN      16
+#define MEM_CACHE_SIZE(index)   ((rt_size_t)MEM_CACHE_SIZE_MIN << (index))
+#define MEM_CACHE_SIZE_MAX      MEM_CACHE_SIZE(RT_MEM_CACHE_CLASS - 1)
+
+#if RT_MEM_CACHE_DEPTH < 2 || RT_MEM_CACHE_DEPTH > 255
+#error "RT_MEM_CACHE_DEPTH shall be in 2 ~ 255"
+#endif
+
+/* the free link is saved in the first word of block */
+#define MEM_CACHE_NEXT(block)   (*(void **)(block))
+
+/* the cached blocks of closed threads, they are released by idle thread */
+static void *mem_cache_orphan = RT_NULL;
+
+/* get the cache of current thread, it's not used in interrupt */
+rt_inline struct rt_mem_cache *_mem_cache_get(void)
+{
+    rt_thread_t thread;
+
+    if (rt_interrupt_get_nest() != 0)
+        return RT_NULL;
+
+    thread = rt_thread_self();
+    if (thread == RT_NULL)
+        return RT_NULL;
+
+    return &(thread->mem_cache);
+}
+
+/* return the blocks of a class to heap */
+static void _mem_cache_flush(struct rt_mem_cache *cache, int index, int count)
+{
+    rt_base_t level;
+    void *block, *list;
+
+    /* take the blocks out of cache */
+    level = rt_hw_interrupt_disable();
+    list = RT_NULL;
+    while (count -- && cache->free[index] != RT_NULL)
+    {
+        block = cache->free[index];
+        cache->free[index] = MEM_CACHE_NEXT(block);
+        cache->count[index] --;
+
+        MEM_CACHE_NEXT(block) = list;
+        list = block;
+    }
+    rt_hw_interrupt_enable(level);
+
+    rt_free_list(list);
+}
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * This function will allocate a block from the cache of current thread. It's
+ * invoked by rt_malloc before the heap is locked.
+ *
+ * @param size the request size, it's rounded up to the size class when the
+ *        cache is missed, so that the block could be cached when it's freed.
+ *
+ * @return the cached block, or RT_NULL if the heap shall be used.
+ */
+void *rt_mem_cache_alloc(rt_size_t *size)
+{
+    int index;
+    rt_base_t level;
+    void *block;
+    struct rt_mem_cache *cache;
+
+    if (*size > MEM_CACHE_SIZE_MAX)
+        return RT_NULL;
+
+    cache = _mem_cache_get();
+    if (cache == RT_NULL)
+        return RT_NULL;
+
+    for (index = 0; MEM_CACHE_SIZE(index) < *size; index ++);
+
+    level = rt_hw_interrupt_disable();
+    block = cache->free[index];
+    if (block != RT_NULL)
+    {
+        cache->free[index] = MEM_CACHE_NEXT(block);
+        cache->count[index] --;
+        cache->hit ++;
+    }
+    else
+    {
+        cache->miss ++;
+        *size = MEM_CACHE_SIZE(index);
+    }
+    rt_hw_interrupt_enable(level);
+
+    return block;
+}
+
+/**
+ * This function will put a block into the cache of current thread. It's
+ * invoked by rt_free before the heap is locked.
+ *
+ * @param ptr the block to be released
+ * @param size the usable size of block
+ *
+ * @return RT_TRUE if the block is cached, RT_FALSE if it shall be released to heap.
+ */
+rt_bool_t rt_mem_cache_free(void *ptr, rt_size_t size)
+{
+    int index;
+    rt_base_t level;
+    struct rt_mem_cache *cache;
+
+    if (size < MEM_CACHE_SIZE_MIN || size >= MEM_CACHE_SIZE_MAX * 2)
+        return RT_FALSE;
+
+    cache = _mem_cache_get();
+    if (cache == RT_NULL)
+        return RT_FALSE;
+
+    /* the largest class which the block can hold */
+    for (index = RT_MEM_CACHE_CLASS - 1; MEM_CACHE_SIZE(index) > size; index --);
+
+    level = rt_hw_interrupt_disable();
+#ifdef RT_DEBUG
+    {
+        void *block;
+
+        /* RT_MEM_CACHE_DEPTH blocks at most */
+        for (block = cache->free[index]; block != RT_NULL; block = MEM_CACHE_NEXT(block))
+        {
+            RT_ASSERT(block != ptr);
+        }
+    }
+#endif
+    MEM_CACHE_NEXT(ptr) = cache->free[index];
+    cache->free[index] = ptr;
+    cache->count[index] ++;
+    rt_hw_interrupt_enable(level);
+
+    /* return half of blocks to heap in one batch */
+    if (cache->count[index] > RT_MEM_CACHE_DEPTH)
+        _mem_cache_flush(cache, index, RT_MEM_CACHE_DEPTH / 2 + 1);
+
+    return RT_TRUE;
+}
+
+/**
+ * This function will move the cached blocks of a closed thread to the
+ * orphan list, which is released by the idle thread later.
+ *
+ * @param thread the closed thread
+ */
+void rt_mem_cache_detach(rt_thread_t thread)
+{
+    int index;
+    rt_base_t level;
+    void *block;
+    struct rt_mem_cache *cache;
+
+    cache = &(thread->mem_cache);
+
+    level = rt_hw_interrupt_disable();
+    for (index = 0; index < RT_MEM_CACHE_CLASS; index ++)
+    {
+        while (cache->free[index] != RT_NULL)
+        {
+            block = cache->free[index];
+            cache->free[index] = MEM_CACHE_NEXT(block);
+
+            MEM_CACHE_NEXT(block) = mem_cache_orphan;
+            mem_cache_orphan = block;
+        }
+        cache->count[index] = 0;
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+/**
+ * This function will release the cached blocks of closed threads to heap.
+ * It's invoked by the idle thread.
+ */
+void rt_mem_cache_reclaim(void)
+{
+    int count;
+    rt_base_t level;
+    void *list, *chunk, *block;
+
+    level = rt_hw_interrupt_disable();
+    list = mem_cache_orphan;
+    mem_cache_orphan = RT_NULL;
+    rt_hw_interrupt_enable(level);
+
+    /* the heap is locked as long as a flush, for RT_MEM_CACHE_DEPTH blocks */
+    while (list != RT_NULL)
+    {
+        chunk = list;
+        block = list;
+        for (count = 1; count < RT_MEM_CACHE_DEPTH && MEM_CACHE_NEXT(block) != RT_NULL; count ++)
+            block = MEM_CACHE_NEXT(block);
+
+        list = MEM_CACHE_NEXT(block);
+        MEM_CACHE_NEXT(block) = RT_NULL;
+        rt_free_list(chunk);
+    }
+}
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+void list_mem_cache(void)
+{
+    int index;
+    rt_size_t cached;
+    rt_uint32_t total;
+    rt_list_t *node;
+    struct rt_thread *thread;
+    struct rt_object_information *info;
+
+    rt_kprintf("%-*.s  cached      hit     miss  hit rate\n", RT_NAME_MAX, "thread");
+    for (index = 0; index < RT_NAME_MAX; index ++)
+        rt_kprintf("-");
+    rt_kprintf("  ------  -------  -------  --------\n");
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    rt_enter_critical();
+    for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+    {
+        thread = rt_list_entry(node, struct rt_thread, list);
+
+        cached = 0;
+        for (index = 0; index < RT_MEM_CACHE_CLASS; index ++)
+            cached += thread->mem_cache.count[index] * MEM_CACHE_SIZE(index);
+
+        total = thread->mem_cache.hit + thread->mem_cache.miss;
+        rt_kprintf("%-*.*s  %6d  %7d  %7d  %7d%%\n", RT_NAME_MAX, RT_NAME_MAX, thread->name,
+                   cached, thread->mem_cache.hit, thread->mem_cache.miss,
+                   total ? (int)((rt_uint64_t)thread->mem_cache.hit * 100 / total) : 0);
+    }
+    rt_exit_critical();
+}
+FINSH_FUNCTION_EXPORT(list_mem_cache, list small memory cache of threads)
+#endif /* RT_USING_FINSH */
+
+#endif /* defined (RT_USING_HEAP) && defined (RT_USING_MEM_CACHE) */
@@ -17,6 +17,7 @@
  * 2013-05-24     Bernard      fix the rt_memheap_realloc issue.
  * 2013-07-11     Grissiom     fix the memory block splitting issue.
  * 2013-07-15     Grissiom     optimize rt_memheap_realloc
+ * 2026-10-17     weizx208     release the list of memory cache in one lock
  */
 
 #include <rthw.h>
@@ -488,45 +489,15 @@ void *rt_memheap_realloc(struct rt_memheap *heap, void *ptr, rt_size_t newsize)
     return ptr;
 }
 
-void rt_memheap_free(void *ptr)
+/* release a used block, it's invoked with the memheap locked */
+static void _memheap_free(struct rt_memheap *heap, struct rt_memheap_item *header_ptr)
 {
-    rt_err_t result;
-    struct rt_memheap *heap;
-    struct rt_memheap_item *header_ptr, *new_ptr;
+    struct rt_memheap_item *new_ptr;
     rt_uint32_t insert_header;
 
-    /* NULL check */
-    if (ptr == RT_NULL) return;
-
     /* set initial status as OK */
     insert_header = 1;
     new_ptr       = RT_NULL;
-    header_ptr    = (struct rt_memheap_item *)
-                    ((rt_uint8_t *)ptr - RT_MEMHEAP_SIZE);
-
-    RT_DEBUG_LOG(RT_DEBUG_MEMHEAP, ("free memory: memory[0x%08x], block[0x%08x]\n",
-                                    ptr, header_ptr));
-
-    /* check magic */
-    RT_ASSERT((header_ptr->magic & RT_MEMHEAP_MASK) == RT_MEMHEAP_MAGIC);
-    RT_ASSERT(header_ptr->magic & RT_MEMHEAP_USED);
-    /* check whether this block of memory has been over-written. */
-    RT_ASSERT((header_ptr->next->magic & RT_MEMHEAP_MASK) == RT_MEMHEAP_MAGIC);
-
-    /* get pool ptr */
-    heap = header_ptr->pool_ptr;
-
-    RT_ASSERT(heap);
-    RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
-
-    /* lock memheap */
-    result = rt_sem_take(&(heap->lock), RT_WAITING_FOREVER);
-    if (result != RT_EOK)
-    {
-        rt_set_errno(result);
-
-        return ;
-    }
 
     /* Mark the memory as available. */
     header_ptr->magic &= ~RT_MEMHEAP_USED;
@@ -585,6 +556,44 @@ void rt_memheap_free(void *ptr)
                      ("insert to free list: next_free 0x%08x, prev_free 0x%08x\n",
                       header_ptr->next_free, header_ptr->prev_free));
     }
+}
+
+void rt_memheap_free(void *ptr)
+{
+    rt_err_t result;
+    struct rt_memheap *heap;
+    struct rt_memheap_item *header_ptr;
+
+    /* NULL check */
+    if (ptr == RT_NULL) return;
+
+    header_ptr = (struct rt_memheap_item *)((rt_uint8_t *)ptr - RT_MEMHEAP_SIZE);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEMHEAP, ("free memory: memory[0x%08x], block[0x%08x]\n",
+                                    ptr, header_ptr));
+
+    /* check magic */
+    RT_ASSERT((header_ptr->magic & RT_MEMHEAP_MASK) == RT_MEMHEAP_MAGIC);
+    RT_ASSERT(header_ptr->magic & RT_MEMHEAP_USED);
+    /* check whether this block of memory has been over-written. */
+    RT_ASSERT((header_ptr->next->magic & RT_MEMHEAP_MASK) == RT_MEMHEAP_MAGIC);
+
+    /* get pool ptr */
+    heap = header_ptr->pool_ptr;
+
+    RT_ASSERT(heap);
+    RT_ASSERT(rt_object_get_type(&heap->parent) == RT_Object_Class_MemHeap);
+
+    /* lock memheap */
+    result = rt_sem_take(&(heap->lock), RT_WAITING_FOREVER);
+    if (result != RT_EOK)
+    {
+        rt_set_errno(result);
+
+        return ;
+    }
+
+    _memheap_free(heap, header_ptr);
 
     /* release lock */
     rt_sem_release(&(heap->lock));
@@ -606,6 +615,13 @@ void *rt_malloc(rt_size_t size)
 {
     void *ptr;
 
+#ifdef RT_USING_MEM_CACHE
+    /* try the small memory cache of thread first */
+    ptr = rt_mem_cache_alloc(&size);
+    if (ptr != RT_NULL)
+        return ptr;
+#endif
+
     /* try to allocate in system heap */
     ptr = rt_memheap_alloc(&_heap, size);
     if (ptr == RT_NULL)
@@ -643,9 +659,63 @@ void *rt_malloc(rt_size_t size)
 
 void rt_free(void *rmem)
 {
+#ifdef RT_USING_MEM_CACHE
+    struct rt_memheap_item *header_ptr;
+
+    if (rmem == RT_NULL)
+        return;
+
+    /* keep it in the small memory cache of thread */
+    header_ptr = (struct rt_memheap_item *)((rt_uint8_t *)rmem - RT_MEMHEAP_SIZE);
+    if (rt_mem_cache_free(rmem, MEMITEM_SIZE(header_ptr)))
+        return;
+#endif
+
     rt_memheap_free(rmem);
 }
 
+#ifdef RT_USING_MEM_CACHE
+/**
+ * This function will release a list of memory blocks to their memheaps, each
+ * memheap is locked once for the blocks of it in a row. It's used by the small
+ * memory cache of thread.
+ *
+ * @param list the first block, each block is linked by its first word
+ */
+void rt_free_list(void *list)
+{
+    void *rmem;
+    struct rt_memheap *heap, *locked;
+    struct rt_memheap_item *header_ptr;
+
+    locked = RT_NULL;
+    while (list != RT_NULL)
+    {
+        rmem = list;
+        list = *(void **)rmem;
+
+        header_ptr = (struct rt_memheap_item *)((rt_uint8_t *)rmem - RT_MEMHEAP_SIZE);
+        RT_ASSERT((header_ptr->magic & RT_MEMHEAP_MASK) == RT_MEMHEAP_MAGIC);
+        RT_ASSERT(header_ptr->magic & RT_MEMHEAP_USED);
+        RT_ASSERT((header_ptr->next->magic & RT_MEMHEAP_MASK) == RT_MEMHEAP_MAGIC);
+
+        heap = header_ptr->pool_ptr;
+        if (heap != locked)
+        {
+            if (locked != RT_NULL)
+                rt_sem_release(&(locked->lock));
+            rt_sem_take(&(heap->lock), RT_WAITING_FOREVER);
+            locked = heap;
+        }
+
+        _memheap_free(heap, header_ptr);
+    }
+
+    if (locked != RT_NULL)
+        rt_sem_release(&(locked->lock));
+}
+#endif
+
 void *rt_realloc(void *rmem, rt_size_t newsize)
 {
     void *new_ptr;
@@ -13,6 +13,8 @@
  * 2010-10-26     yi.qiu       add module support in rt_object_allocate and rt_object_free
  * 2017-12-10     Bernard      Add object_info enum.
  * 2018-01-25     Bernard      Fix the object find issue when enable MODULE.
+ * 2026-10-17     weizx208     add ring buffer object
+ * 2026-10-17     weizx208     add name hash index of objects
  */
 
 #include <rtthread.h>
@@ -39,6 +41,9 @@ enum rt_object_info_type
 #ifdef RT_USING_MESSAGEQUEUE
     RT_Object_Info_MessageQueue,                       /**< The object is a message queue. */
 #endif
+#ifdef RT_USING_RINGBUF
+    RT_Object_Info_RingBuf,                            /**< The object is a ring buffer. */
+#endif
 #ifdef RT_USING_MEMHEAP
     RT_Object_Info_MemHeap,                            /**< The object is a memory heap */
 #endif
@@ -78,6 +83,10 @@ static struct rt_object_information rt_object_container[RT_Object_Info_Unknown]
     /* initialize object container - message queue */
     {RT_Object_Class_MessageQueue, _OBJ_CONTAINER_LIST_INIT(RT_Object_Info_MessageQueue), sizeof(struct rt_messagequeue)},
 #endif
+#ifdef RT_USING_RINGBUF
+    /* initialize object container - ring buffer */
+    {RT_Object_Class_RingBuf, _OBJ_CONTAINER_LIST_INIT(RT_Object_Info_RingBuf), sizeof(struct rt_ringbuf)},
+#endif
 #ifdef RT_USING_MEMHEAP
     /* initialize object container - memory heap */
     {RT_Object_Class_MemHeap, _OBJ_CONTAINER_LIST_INIT(RT_Object_Info_MemHeap), sizeof(struct rt_memheap)},
@@ -94,6 +103,65 @@ static struct rt_object_information rt_object_container[RT_Object_Info_Unknown]
     {RT_Object_Class_Timer, _OBJ_CONTAINER_LIST_INIT(RT_Object_Info_Timer), sizeof(struct rt_timer)},
 };
 
+#ifdef RT_USING_OBJECT_HASH
+#ifndef RT_OBJECT_HASH_SIZE
+#define RT_OBJECT_HASH_SIZE     64
+#endif
+
+#if (RT_OBJECT_HASH_SIZE & (RT_OBJECT_HASH_SIZE - 1)) != 0
+#error "RT_OBJECT_HASH_SIZE shall be power of 2"
+#endif
+
+/* the objects of all types, which are hashed by the name and type */
+static struct rt_object *rt_object_hash[RT_OBJECT_HASH_SIZE];
+
+/* FNV-1a hash of the name (RT_NAME_MAX characters at most) and the type */
+static rt_uint32_t _object_hash(const char *name, rt_uint8_t type)
+{
+    rt_uint32_t hash = 2166136261u;
+    int index;
+
+    for (index = 0; index < RT_NAME_MAX && name[index] != '\0'; index ++)
+    {
+        hash ^= (rt_uint8_t)name[index];
+        hash *= 16777619u;
+    }
+    hash ^= type;
+    hash *= 16777619u;
+
+    return (hash ^ (hash >> 16)) & (RT_OBJECT_HASH_SIZE - 1);
+}
+
+/* insert the object into hash table, it's invoked with interrupt disabled */
+rt_inline void _object_hash_insert(struct rt_object *object, rt_uint8_t type)
+{
+    struct rt_object **bucket;
+
+    bucket = &rt_object_hash[_object_hash(object->name, type)];
+    /* the newer object is found first, as the object list */
+    object->hash_next = *bucket;
+    *bucket = object;
+}
+
+/* remove the object from hash table, it's invoked with interrupt disabled */
+rt_inline void _object_hash_remove(struct rt_object *object, rt_uint8_t type)
+{
+    struct rt_object **node;
+
+    node = &rt_object_hash[_object_hash(object->name, type)];
+    while (*node != RT_NULL)
+    {
+        if (*node == object)
+        {
+            *node = object->hash_next;
+            break;
+        }
+        node = &((*node)->hash_next);
+    }
+    object->hash_next = RT_NULL;
+}
+#endif
+
 #ifdef RT_USING_HOOK
 static void (*rt_object_attach_hook)(struct rt_object *object);
 static void (*rt_object_detach_hook)(struct rt_object *object);
@@ -339,6 +407,9 @@ void rt_object_init(struct rt_object         *object,
 
     /* insert object into information object list */
     rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_insert(object, type);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -359,12 +430,16 @@ void rt_object_detach(rt_object_t object)
 
     RT_OBJECT_HOOK_CALL(rt_object_detach_hook, (object));
 
-    /* reset object type */
-    object->type = 0;
-
     /* lock interrupt */
     temp = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(object, object->type & ~RT_Object_Class_Static);
+#endif
+
+    /* reset object type */
+    object->type = 0;
+
     /* remove from old list */
     rt_list_remove(&(object->list));
 
@@ -421,6 +496,9 @@ rt_object_t rt_object_allocate(enum rt_object_class_type type, const char *name)
 
     /* insert object into information object list */
     rt_list_insert_after(&(information->object_list), &(object->list));
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_insert(object, type);
+#endif
 
     /* unlock interrupt */
     rt_hw_interrupt_enable(temp);
@@ -444,12 +522,16 @@ void rt_object_delete(rt_object_t object)
 
     RT_OBJECT_HOOK_CALL(rt_object_detach_hook, (object));
 
-    /* reset object type */
-    object->type = RT_Object_Class_Null;
-
     /* lock interrupt */
     temp = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_OBJECT_HASH
+    _object_hash_remove(object, object->type);
+#endif
+
+    /* reset object type */
+    object->type = RT_Object_Class_Null;
+
     /* remove from old list */
     rt_list_remove(&(object->list));
 
@@ -512,7 +594,9 @@ rt_uint8_t rt_object_get_type(rt_object_t object)
 rt_object_t rt_object_find(const char *name, rt_uint8_t type)
 {
     struct rt_object *object = RT_NULL;
+#ifndef RT_USING_OBJECT_HASH
     struct rt_list_node *node = RT_NULL;
+#endif
     struct rt_object_information *information = RT_NULL;
 
     information = rt_object_get_information((enum rt_object_class_type)type);
@@ -526,6 +610,22 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
     /* enter critical */
     rt_enter_critical();
 
+#ifdef RT_USING_OBJECT_HASH
+    /* try to find object in the hash bucket of name */
+    for (object = rt_object_hash[_object_hash(name, type)];
+            object != RT_NULL;
+            object = object->hash_next)
+    {
+        if ((object->type & ~RT_Object_Class_Static) == type &&
+                rt_strncmp(object->name, name, RT_NAME_MAX) == 0)
+        {
+            /* leave critical */
+            rt_exit_critical();
+
+            return object;
+        }
+    }
+#else
     /* try to find object */
     rt_list_for_each(node, &(information->object_list))
     {
@@ -538,6 +638,7 @@ rt_object_t rt_object_find(const char *name, rt_uint8_t type)
             return object;
         }
     }
+#endif
 
     /* leave critical */
     rt_exit_critical();
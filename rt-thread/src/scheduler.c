@@ -27,6 +27,14 @@
  *                             rt_schedule_insert_thread won't insert current task to ready queue
  *                             in smp version, rt_hw_context_switch_interrupt maybe switch to
  *                               new task directly
+ * 2026-10-17     weizx208     use compiler intrinsic to find the highest
+ *                             ready priority, add trace of thread switch
+ * 2026-10-17     weizx208     add CPU usage accounting
+ * 2026-10-17     weizx208     pass the address of sp as rt_ubase_t for 64 bits
+ * 2026-10-17     weizx208     measure the scheduler locked spans
+ * 2026-10-17     weizx208     add preemption threshold, schedule on exit of
+ *                             critical section only if it's pending
+ * 2026-10-17     weizx208     add earliest deadline first scheduling class
  *
  */
 
@@ -42,8 +50,27 @@ rt_uint8_t rt_thread_ready_table[32];
 #endif
 
 
+/*
+ * the index of the least significant set bit of a non-zero value, the
+ * compiler intrinsic is used when it exists instead of the table lookup
+ * in __rt_ffs().
+ */
+#if defined(__CC_ARM) && defined(RT_USING_CPU_FFS)
+#define _rt_ffs_nonzero(value)          ((rt_ubase_t)__clz(__rbit(value)))
+#elif defined(__IAR_SYSTEMS_ICC__) && defined(RT_USING_CPU_FFS)
+#include <intrinsics.h>
+#define _rt_ffs_nonzero(value)          ((rt_ubase_t)__CLZ(__RBIT(value)))
+#elif defined(__GNUC__) || defined(__CLANG_ARM)
+#define _rt_ffs_nonzero(value)          ((rt_ubase_t)__builtin_ctz(value))
+#else
+#define _rt_ffs_nonzero(value)          ((rt_ubase_t)__rt_ffs(value) - 1)
+#endif
+
 extern volatile rt_uint8_t rt_interrupt_nest;
 static rt_int16_t rt_scheduler_lock_nest;
+/* a thread is inserted to ready queue, or rt_schedule() is deferred by the
+ * scheduler lock, since the last schedule */
+static rt_uint8_t rt_scheduler_pending;
 struct rt_thread *rt_current_thread = RT_NULL;
 rt_uint8_t rt_current_priority;
 
@@ -74,6 +101,147 @@ rt_scheduler_sethook(void (*hook)(struct rt_thread *from, struct rt_thread *to))
 /**@}*/
 #endif
 
+/* get the highest priority of ready threads, the idle thread is always ready */
+rt_inline rt_ubase_t _rt_get_highest_ready_priority(void)
+{
+#if RT_THREAD_PRIORITY_MAX > 32
+    register rt_ubase_t number;
+
+    number = _rt_ffs_nonzero(rt_thread_ready_priority_group);
+    return (number << 3) + _rt_ffs_nonzero(rt_thread_ready_table[number]);
+#else
+    return _rt_ffs_nonzero(rt_thread_ready_priority_group);
+#endif
+}
+
+#ifdef RT_USING_PREEMPT_THRESHOLD
+/* the ready thread of priority shall not preempt the current thread */
+rt_inline rt_bool_t _rt_preempt_held_off(rt_ubase_t priority)
+{
+    register struct rt_thread *thread = rt_current_thread;
+
+    return (thread != RT_NULL &&
+            (thread->stat & RT_THREAD_STAT_MASK) == RT_THREAD_READY &&
+            priority >= thread->preempt_threshold &&
+            priority < thread->current_priority);
+}
+#endif
+
+#ifdef RT_USING_EDF
+#ifndef RT_EDF_PRIORITY
+#define RT_EDF_PRIORITY         (RT_THREAD_PRIORITY_MAX / 2)
+#endif
+
+#if RT_EDF_PRIORITY >= RT_THREAD_PRIORITY_MAX - 1
+#error "RT_EDF_PRIORITY shall be higher than the idle thread"
+#endif
+
+/* the utilization of EDF threads is in the unit of 1 / RT_EDF_UTIL_ONE */
+#define RT_EDF_UTIL_ONE         1000
+
+/* the ready thread of earliest deadline in the list of RT_EDF_PRIORITY, the
+ * thread not in the class runs only if no EDF thread is ready */
+static struct rt_thread *_rt_edf_select(rt_list_t *list)
+{
+    register rt_list_t *node;
+    register struct rt_thread *thread, *earliest;
+
+    earliest = rt_list_entry(list->next, struct rt_thread, tlist);
+    for (node = list->next; node != list; node = node->next)
+    {
+        thread = rt_list_entry(node, struct rt_thread, tlist);
+        if (thread->edf.param.period == 0)
+            continue;
+
+        if (earliest->edf.param.period == 0 ||
+            (rt_int32_t)(thread->edf.deadline - earliest->edf.deadline) < 0)
+        {
+            earliest = thread;
+        }
+    }
+
+    return earliest;
+}
+
+/* the utilization of EDF threads except the one */
+static rt_uint32_t _rt_edf_utilization(struct rt_thread *except)
+{
+    rt_list_t *node;
+    rt_uint32_t util;
+    struct rt_thread *thread;
+    struct rt_object_information *info;
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+
+    util = 0;
+    for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+    {
+        thread = rt_list_entry(node, struct rt_thread, list);
+        if (thread != except && thread->edf.param.period != 0)
+            util += thread->edf.param.budget * RT_EDF_UTIL_ONE / thread->edf.param.deadline;
+    }
+
+    return util;
+}
+
+#ifdef RT_USING_MUTEX
+/* whether the thread owns a mutex, its priority may be inherited then */
+static rt_bool_t _rt_edf_holds_mutex(struct rt_thread *thread)
+{
+    rt_list_t *node;
+    struct rt_mutex *mutex;
+    struct rt_object_information *info;
+
+    info = rt_object_get_information(RT_Object_Class_Mutex);
+
+    for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+    {
+        mutex = rt_list_entry(node, struct rt_mutex, parent.parent.list);
+        if (mutex->owner == thread)
+            return RT_TRUE;
+#ifdef RT_USING_MUTEX_FAST
+        /* taken without contention */
+        if (mutex->lock == (rt_ubase_t)thread)
+            return RT_TRUE;
+#endif
+    }
+
+    return RT_FALSE;
+}
+#endif
+
+/* move to the next job, and return the ticks before it's released */
+static rt_int32_t _rt_edf_next_job(struct rt_thread *thread)
+{
+    thread->edf.release += thread->edf.param.period;
+    thread->edf.deadline = thread->edf.release + thread->edf.param.deadline;
+    thread->edf.used     = 0;
+
+    return (rt_int32_t)(thread->edf.release - rt_tick_get());
+}
+
+/* suspend the current thread until the next job is released */
+static void _rt_edf_sleep(struct rt_thread *thread, rt_tick_t tick)
+{
+    rt_thread_suspend(thread);
+    rt_timer_control(&(thread->thread_timer), RT_TIMER_CTRL_SET_TIME, &tick);
+    rt_timer_start(&(thread->thread_timer));
+}
+#endif
+
+/* get the thread to run in the ready list of priority */
+rt_inline struct rt_thread *_rt_get_ready_thread(rt_ubase_t priority)
+{
+#ifdef RT_USING_EDF
+    if (priority == RT_EDF_PRIORITY)
+        return _rt_edf_select(&rt_thread_priority_table[priority]);
+#endif
+
+    return rt_list_entry(rt_thread_priority_table[priority].next,
+                         struct rt_thread,
+                         tlist);
+}
+
 #ifdef RT_USING_OVERFLOW_CHECK
 static void _rt_scheduler_stack_check(struct rt_thread *thread)
 {
@@ -125,6 +293,7 @@ void rt_system_scheduler_init(void)
     register rt_base_t offset;
 
     rt_scheduler_lock_nest = 0;
+    rt_scheduler_pending   = 0;
 
     RT_DEBUG_LOG(RT_DEBUG_SCHEDULER, ("start scheduler: max priority 0x%02x\n",
                                       RT_THREAD_PRIORITY_MAX));
@@ -159,24 +328,21 @@ void rt_system_scheduler_start(void)
     register struct rt_thread *to_thread;
     register rt_ubase_t highest_ready_priority;
 
-#if RT_THREAD_PRIORITY_MAX > 32
-    register rt_ubase_t number;
-
-    number = __rt_ffs(rt_thread_ready_priority_group) - 1;
-    highest_ready_priority = (number << 3) + __rt_ffs(rt_thread_ready_table[number]) - 1;
-#else
-    highest_ready_priority = __rt_ffs(rt_thread_ready_priority_group) - 1;
-#endif
+    highest_ready_priority = _rt_get_highest_ready_priority();
 
     /* get switch to thread */
-    to_thread = rt_list_entry(rt_thread_priority_table[highest_ready_priority].next,
-                              struct rt_thread,
-                              tlist);
+    to_thread = _rt_get_ready_thread(highest_ready_priority);
 
     rt_current_thread = to_thread;
 
+    RT_TRACE_RECORD(RT_TRACE_THREAD_SWITCH, highest_ready_priority, to_thread);
+
+#ifdef RT_USING_CPU_USAGE
+    rt_cpu_usage_start();
+#endif
+
     /* switch to new thread */
-    rt_hw_context_switch_to((rt_uint32_t)&to_thread->sp);
+    rt_hw_context_switch_to((rt_ubase_t)&to_thread->sp);
 
     /* never come back */
 }
@@ -205,19 +371,21 @@ void rt_schedule(void)
     {
         register rt_ubase_t highest_ready_priority;
 
-#if RT_THREAD_PRIORITY_MAX <= 32
-        highest_ready_priority = __rt_ffs(rt_thread_ready_priority_group) - 1;
-#else
-        register rt_ubase_t number;
+        rt_scheduler_pending = 0;
+        highest_ready_priority = _rt_get_highest_ready_priority();
 
-        number = __rt_ffs(rt_thread_ready_priority_group) - 1;
-        highest_ready_priority = (number << 3) + __rt_ffs(rt_thread_ready_table[number]) - 1;
+#ifdef RT_USING_PREEMPT_THRESHOLD
+        if (_rt_preempt_held_off(highest_ready_priority))
+        {
+            /* enable interrupt */
+            rt_hw_interrupt_enable(level);
+
+            return ;
+        }
 #endif
 
         /* get switch to thread */
-        to_thread = rt_list_entry(rt_thread_priority_table[highest_ready_priority].next,
-                                  struct rt_thread,
-                                  tlist);
+        to_thread = _rt_get_ready_thread(highest_ready_priority);
 
         /* if the destination thread is not the same as current thread */
         if (to_thread != rt_current_thread)
@@ -227,6 +395,7 @@ void rt_schedule(void)
             rt_current_thread   = to_thread;
 
             RT_OBJECT_HOOK_CALL(rt_scheduler_hook, (from_thread, to_thread));
+            RT_TRACE_RECORD(RT_TRACE_THREAD_SWITCH, highest_ready_priority, to_thread);
 
             /* switch to new thread */
             RT_DEBUG_LOG(RT_DEBUG_SCHEDULER,
@@ -243,6 +412,10 @@ void rt_schedule(void)
 
             if (rt_interrupt_nest == 0)
             {
+#ifdef RT_USING_CPU_USAGE
+                rt_cpu_usage_account(from_thread);
+#endif
+
                 rt_hw_context_switch((rt_ubase_t)&from_thread->sp,
                                      (rt_ubase_t)&to_thread->sp);
 
@@ -260,6 +433,11 @@ void rt_schedule(void)
             }
         }
     }
+    else
+    {
+        /* do it when the scheduler is unlocked */
+        rt_scheduler_pending = 1;
+    }
 
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
@@ -283,6 +461,7 @@ void rt_schedule_insert_thread(struct rt_thread *thread)
 
     /* change stat */
     thread->stat = RT_THREAD_READY | (thread->stat & ~RT_THREAD_STAT_MASK);
+    rt_scheduler_pending = 1;
 
     /* insert thread to ready list */
     rt_list_insert_before(&(rt_thread_priority_table[thread->current_priority]),
@@ -341,7 +520,10 @@ void rt_schedule_remove_thread(struct rt_thread *thread)
                   thread->high_mask));
 #endif
 
-    /* remove thread from ready list */
+    /* remove thread from ready list, or the suspended list of a closed thread */
+#ifdef RT_USING_IPC_PRIO_INDEX
+    rt_ipc_prio_remove(thread);
+#endif
     rt_list_remove(&(thread->tlist));
     if (rt_list_isempty(&(rt_thread_priority_table[thread->current_priority])))
     {
@@ -360,6 +542,181 @@ void rt_schedule_remove_thread(struct rt_thread *thread)
     rt_hw_interrupt_enable(temp);
 }
 
+#ifdef RT_USING_EDF
+/**
+ * This function will move a thread to earliest deadline first scheduling
+ * class, where the threads run at RT_EDF_PRIORITY and the one of earliest
+ * deadline runs first. The first job is released at once. A job ends by
+ * rt_thread_edf_wait(), and it's suspended until the next period if the
+ * budget is exhausted before.
+ *
+ * @param thread the thread, which is started up
+ * @param param the period, budget and deadline in ticks, or the period of 0
+ *        to move the thread back to its initialized priority
+ *
+ * @return RT_EOK on successful, -RT_EFULL if the utilization of all threads
+ *         in the class would exceed 1, -RT_EBUSY if the thread holds a mutex,
+ *         whose inherited priority would be overwritten
+ */
+rt_err_t rt_schedule_edf_set(struct rt_thread *thread, const struct rt_edf_param *param)
+{
+    rt_base_t level;
+    rt_uint8_t priority;
+    rt_tick_t deadline;
+
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(param != RT_NULL);
+    /* the priority is reset when it's started up */
+    RT_ASSERT((thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_INIT);
+
+    /* the thread takes no mutex in between, as the scheduler is locked */
+    rt_enter_critical();
+#ifdef RT_USING_MUTEX
+    if (_rt_edf_holds_mutex(thread))
+    {
+        rt_exit_critical();
+
+        return -RT_EBUSY;
+    }
+#endif
+
+    if (param->period == 0)
+    {
+        level = rt_hw_interrupt_disable();
+        thread->edf.param.period = 0;
+        rt_hw_interrupt_enable(level);
+
+        priority = thread->init_priority;
+    }
+    else
+    {
+        deadline = (param->deadline != 0) ? param->deadline : param->period;
+        RT_ASSERT(param->budget > 0);
+        RT_ASSERT(param->budget <= deadline && deadline <= param->period);
+
+        /* admission test of EDF, the sum of budget / deadline <= 1 */
+        if (_rt_edf_utilization(thread) + param->budget * RT_EDF_UTIL_ONE / deadline >
+            RT_EDF_UTIL_ONE)
+        {
+            rt_exit_critical();
+
+            return -RT_EFULL;
+        }
+
+        level = rt_hw_interrupt_disable();
+        thread->edf.param          = *param;
+        thread->edf.param.deadline = deadline;
+        thread->edf.release        = rt_tick_get();
+        thread->edf.deadline       = thread->edf.release + deadline;
+        thread->edf.used           = 0;
+        thread->edf.jobs           = 0;
+        thread->edf.misses         = 0;
+        thread->edf.overruns       = 0;
+        rt_hw_interrupt_enable(level);
+
+        priority = RT_EDF_PRIORITY;
+    }
+
+    rt_thread_control(thread, RT_THREAD_CTRL_CHANGE_PRIORITY, &priority);
+    rt_exit_critical();
+    if (rt_current_thread != RT_NULL)
+        rt_schedule();
+
+    return RT_EOK;
+}
+
+/**
+ * This function will charge one tick to the job of current thread, and
+ * throttle it until the next period if the budget is exhausted. It's invoked
+ * in the tick interrupt.
+ *
+ * @note please don't invoke this routine in application
+ */
+void rt_schedule_edf_tick(void)
+{
+    rt_int32_t tick;
+    register rt_base_t level;
+    struct rt_thread *thread;
+
+    level = rt_hw_interrupt_disable();
+
+    thread = rt_current_thread;
+    if (thread == RT_NULL || thread->edf.param.period == 0)
+    {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    /* throttle it at the next tick if it's blocking or locks the scheduler */
+    thread->edf.used ++;
+    if (thread->edf.used < thread->edf.param.budget ||
+        (thread->stat & RT_THREAD_STAT_MASK) != RT_THREAD_READY ||
+        rt_scheduler_lock_nest != 0)
+    {
+        rt_hw_interrupt_enable(level);
+        return;
+    }
+
+    /* the job is throttled, it misses only if its deadline has passed already */
+    thread->edf.overruns ++;
+    if ((rt_int32_t)(rt_tick_get() - thread->edf.deadline) > 0)
+        thread->edf.misses ++;
+    tick = _rt_edf_next_job(thread);
+    if (tick > 0)
+        _rt_edf_sleep(thread, (rt_tick_t)tick);
+
+    rt_hw_interrupt_enable(level);
+
+    rt_schedule();
+}
+
+/**
+ * This function will end the job of current thread in earliest deadline
+ * first scheduling class, and suspend it until the next job is released.
+ *
+ * @return RT_EOK on successful, -RT_ERROR if the thread is not in the class
+ */
+rt_err_t rt_thread_edf_wait(void)
+{
+    rt_int32_t tick;
+    register rt_base_t level;
+    struct rt_thread *thread;
+
+    level = rt_hw_interrupt_disable();
+
+    thread = rt_current_thread;
+    RT_ASSERT(thread != RT_NULL);
+    if (thread->edf.param.period == 0)
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_ERROR;
+    }
+
+    thread->edf.jobs ++;
+    if ((rt_int32_t)(rt_tick_get() - thread->edf.deadline) > 0)
+        thread->edf.misses ++;
+
+    tick = _rt_edf_next_job(thread);
+    if (tick <= 0)
+    {
+        /* it's late, the next job is released already */
+        rt_hw_interrupt_enable(level);
+        return RT_EOK;
+    }
+
+    _rt_edf_sleep(thread, (rt_tick_t)tick);
+    rt_hw_interrupt_enable(level);
+
+    rt_schedule();
+
+    /* clear error number of this thread to RT_EOK */
+    if (thread->error == -RT_ETIMEOUT)
+        thread->error = RT_EOK;
+
+    return RT_EOK;
+}
+#endif /* RT_USING_EDF */
+
 /**
  * This function will lock the thread scheduler.
  */
@@ -375,6 +732,10 @@ void rt_enter_critical(void)
      * enough and does not check here
      */
     rt_scheduler_lock_nest ++;
+#ifdef RT_USING_IRQ_LATENCY
+    if (rt_scheduler_lock_nest == 1)
+        RT_IRQ_LATENCY_BEGIN(RT_IRQ_LATENCY_SCHED_LOCK, RT_RETURN_ADDRESS());
+#endif
 
     /* enable interrupt */
     rt_hw_interrupt_enable(level);
@@ -386,6 +747,7 @@ void rt_enter_critical(void)
 void rt_exit_critical(void)
 {
     register rt_base_t level;
+    register rt_uint8_t pending;
 
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
@@ -394,12 +756,14 @@ void rt_exit_critical(void)
     if (rt_scheduler_lock_nest <= 0)
     {
         rt_scheduler_lock_nest = 0;
+        RT_IRQ_LATENCY_END(RT_IRQ_LATENCY_SCHED_LOCK);
+        pending = rt_scheduler_pending;
         /* enable interrupt */
         rt_hw_interrupt_enable(level);
 
-        if (rt_current_thread)
+        if (pending && rt_current_thread)
         {
-            /* if scheduler is started, do a schedule */
+            /* if scheduler is started and a schedule is pending, do it */
             rt_schedule();
         }
     }
@@ -421,3 +785,43 @@ rt_uint16_t rt_critical_level(void)
 }
 /**@}*/
 
+#if defined(RT_USING_EDF) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+static long list_edf(void)
+{
+    rt_list_t *node;
+    rt_uint32_t util;
+    struct rt_thread *thread;
+    struct rt_object_information *info;
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+
+    /* the scheduler is locked so that the thread is not deleted */
+    rt_enter_critical();
+    util = _rt_edf_utilization(RT_NULL);
+    rt_kprintf("priority %d, utilization %d.%d%%\n", RT_EDF_PRIORITY,
+               util / 10, util % 10);
+    rt_kprintf("%-*.s   period   budget deadline       jobs     misses   overruns\n",
+               RT_NAME_MAX, "thread");
+    for (util = 0; util < RT_NAME_MAX; util ++)
+        rt_kprintf("-");
+    rt_kprintf(" -------- -------- -------- ---------- ---------- ----------\n");
+    for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+    {
+        thread = rt_list_entry(node, struct rt_thread, list);
+        if (thread->edf.param.period == 0)
+            continue;
+
+        rt_kprintf("%-*.*s %8d %8d %8d %10d %10d %10d\n", RT_NAME_MAX, RT_NAME_MAX,
+                   thread->name, thread->edf.param.period, thread->edf.param.budget,
+                   thread->edf.param.deadline, thread->edf.jobs, thread->edf.misses,
+                   thread->edf.overruns);
+    }
+    rt_exit_critical();
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_edf, list threads of earliest deadline first scheduling);
+#endif
+
@@ -26,6 +26,11 @@
                                bug when thread has not startup.
  * 2018-11-22     Jesven       yield is same to rt_schedule
  *                             add support for tasks bound to cpu
+ * 2026-10-17     weizx208     add stack watermark scanning
+ * 2026-10-17     weizx208     clear the CPU run time of thread
+ * 2026-10-17     weizx208     add preemption threshold
+ * 2026-10-17     weizx208     add earliest deadline first scheduling class
+ * 2026-10-17     weizx208     release the stack context of port
  */
 
 #include <rthw.h>
@@ -80,6 +85,20 @@ void rt_thread_inited_sethook(void (*hook)(rt_thread_t thread))
 
 #endif
 
+/**
+ * This function will release the context made by rt_hw_stack_init(), when the
+ * thread exits, is detached or deleted. The context is in the stack of thread
+ * on the CPU, there is nothing to release. It's replaced by the port which
+ * allocates the context elsewhere, such as the simulator.
+ *
+ * @param sp the stack pointer returned by rt_hw_stack_init
+ *
+ * @note the thread exiting runs on the context until it's switched out
+ */
+RT_WEAK void rt_hw_stack_free(void *sp)
+{
+}
+
 /* must be invoke witch rt_hw_interrupt_disable */
 static void _thread_cleanup_execute(rt_thread_t thread)
 {
@@ -91,6 +110,13 @@ static void _thread_cleanup_execute(rt_thread_t thread)
     if (thread->cleanup != RT_NULL)
         thread->cleanup(thread);
 
+#ifdef RT_USING_MEM_CACHE
+    /* the cached memory is released by idle thread */
+    rt_mem_cache_detach(thread);
+#endif
+
+    rt_hw_stack_free(thread->sp);
+
     rt_hw_interrupt_enable(level);
 }
 
@@ -167,6 +193,17 @@ static rt_err_t _rt_thread_init(struct rt_thread *thread,
     RT_ASSERT(priority < RT_THREAD_PRIORITY_MAX);
     thread->init_priority    = priority;
     thread->current_priority = priority;
+#ifdef RT_USING_PREEMPT_THRESHOLD
+    /* the lowest priority, no threshold */
+    thread->preempt_threshold = RT_THREAD_PRIORITY_MAX - 1;
+#endif
+#ifdef RT_USING_EDF
+    /* not in the class */
+    rt_memset(&(thread->edf), 0, sizeof(thread->edf));
+#endif
+#ifdef RT_USING_MUTEX_FAST
+    thread->mutex_taking = RT_NULL;
+#endif
 
     thread->number_mask = 0;
 #if RT_THREAD_PRIORITY_MAX > 32
@@ -186,6 +223,23 @@ static rt_err_t _rt_thread_init(struct rt_thread *thread,
     thread->cleanup   = 0;
     thread->user_data = 0;
 
+#ifdef RT_USING_MEM_CACHE
+    rt_memset(&(thread->mem_cache), 0, sizeof(thread->mem_cache));
+#endif
+
+#ifdef RT_USING_IPC_PRIO_INDEX
+    thread->wait_index = RT_NULL;
+#endif
+
+#ifdef RT_USING_STACK_WATERMARK
+    thread->stack_peak = 0;
+    thread->stack_scan = 0;
+#endif
+
+#ifdef RT_USING_CPU_USAGE
+    thread->run_time = 0;
+#endif
+
     /* initialize thread timer */
     rt_timer_init(&(thread->thread_timer),
                   thread->name,
@@ -618,6 +672,13 @@ rt_err_t rt_thread_mdelay(rt_int32_t ms)
  *  RT_THREAD_CTRL_CHANGE_PRIORITY for changing priority level of thread;
  *  RT_THREAD_CTRL_STARTUP for starting a thread;
  *  RT_THREAD_CTRL_CLOSE for delete a thread;
+ *  RT_THREAD_CTRL_PREEMPT_THRESHOLD for setting preemption threshold, only
+ *  the threads of higher priority than it preempt the thread, a threshold not
+ *  higher than the priority of thread has no effect;
+ *  RT_THREAD_CTRL_EDF for moving the thread to earliest deadline first
+ *  scheduling class with the parameters of struct rt_edf_param, or back to
+ *  its initialized priority if the period is 0, it's refused while the thread
+ *  holds a mutex;
  *  RT_THREAD_CTRL_BIND_CPU for bind the thread to a CPU.
  * @param arg the argument of control command
  *
@@ -676,6 +737,25 @@ rt_err_t rt_thread_control(rt_thread_t thread, int cmd, void *arg)
         rt_hw_interrupt_enable(temp);
         break;
 
+#ifdef RT_USING_PREEMPT_THRESHOLD
+    case RT_THREAD_CTRL_PREEMPT_THRESHOLD:
+        RT_ASSERT(*(rt_uint8_t *)arg < RT_THREAD_PRIORITY_MAX);
+
+        temp = rt_hw_interrupt_disable();
+        thread->preempt_threshold = *(rt_uint8_t *)arg;
+        rt_hw_interrupt_enable(temp);
+
+        /* the threads held off by the threshold may preempt now */
+        if (thread == rt_current_thread)
+            rt_schedule();
+        break;
+#endif
+
+#ifdef RT_USING_EDF
+    case RT_THREAD_CTRL_EDF:
+        return rt_schedule_edf_set(thread, (const struct rt_edf_param *)arg);
+#endif
+
     case RT_THREAD_CTRL_STARTUP:
         return rt_thread_startup(thread);
 
@@ -773,6 +853,9 @@ rt_err_t rt_thread_resume(rt_thread_t thread)
     temp = rt_hw_interrupt_disable();
 
     /* remove from suspend list */
+#ifdef RT_USING_IPC_PRIO_INDEX
+    rt_ipc_prio_remove(thread);
+#endif
     rt_list_remove(&(thread->tlist));
 
     rt_timer_stop(&thread->thread_timer);
@@ -808,6 +891,9 @@ void rt_thread_timeout(void *parameter)
     thread->error = -RT_ETIMEOUT;
 
     /* remove from suspend list */
+#ifdef RT_USING_IPC_PRIO_INDEX
+    rt_ipc_prio_remove(thread);
+#endif
     rt_list_remove(&(thread->tlist));
 
     /* insert to schedule ready list */
@@ -831,4 +917,148 @@ rt_thread_t rt_thread_find(char *name)
     return (rt_thread_t)rt_object_find(name, RT_Object_Class_Thread);
 }
 
+#ifdef RT_USING_STACK_WATERMARK
+#ifndef RT_STACK_SCAN_WORDS
+#define RT_STACK_SCAN_WORDS     16
+#endif
+
+/* the index of thread in object list to be scanned by idle thread */
+static rt_uint16_t _stack_scan_index = 0;
+
+/*
+ * Scan the unused part of stack from the far end, which is filled with '#'
+ * when the thread is initialized. It checks at most size bytes from the
+ * offset saved in thread, and returns RT_TRUE when the scan reaches the
+ * first used byte, which is the new peak usage.
+ */
+static rt_bool_t _thread_stack_scan(struct rt_thread *thread, rt_uint32_t size)
+{
+    rt_uint32_t offset, end;
+    rt_uint8_t *ptr;
+
+    /* the bytes beyond the peak are known to be used */
+    end = thread->stack_size - thread->stack_peak;
+    offset = thread->stack_scan;
+
+    for (; size > 0 && offset < end; size --, offset ++)
+    {
+#if defined(ARCH_CPU_STACK_GROWS_UPWARD)
+        ptr = (rt_uint8_t *)thread->stack_addr + thread->stack_size - 1 - offset;
+#else
+        ptr = (rt_uint8_t *)thread->stack_addr + offset;
+#endif
+        if (*ptr != '#')
+        {
+            thread->stack_peak = thread->stack_size - offset;
+            break;
+        }
+    }
+
+    if (size > 0)
+    {
+        /* start over in the next round */
+        thread->stack_scan = 0;
+
+        return RT_TRUE;
+    }
+    thread->stack_scan = offset;
+
+    return RT_FALSE;
+}
+
+/**
+ * This function will scan the whole stack of thread and return the maximum
+ * used size of stack.
+ *
+ * @param thread the thread to be scanned
+ *
+ * @return the maximum used size of stack in bytes
+ */
+rt_uint32_t rt_thread_stack_usage(rt_thread_t thread)
+{
+    RT_ASSERT(thread != RT_NULL);
+    RT_ASSERT(rt_object_get_type((rt_object_t)thread) == RT_Object_Class_Thread);
+
+    rt_enter_critical();
+    thread->stack_scan = 0;
+    _thread_stack_scan(thread, thread->stack_size);
+    rt_exit_critical();
+
+    return thread->stack_peak;
+}
+
+/**
+ * This function will scan RT_STACK_SCAN_WORDS words of stack of one thread,
+ * the threads are scanned in turn. It's invoked by the idle thread, so the
+ * peak usage of all threads is kept up to date in background.
+ */
+void rt_thread_stack_scan(void)
+{
+    rt_uint16_t index;
+    rt_list_t *node;
+    struct rt_object_information *info;
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+
+    /* the scheduler is locked so that the thread is not deleted */
+    rt_enter_critical();
+
+    index = 0;
+    for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+    {
+        if (index == _stack_scan_index)
+            break;
+        index ++;
+    }
+
+    if (node == &(info->object_list))
+    {
+        /* the last thread is scanned, start from the first one */
+        _stack_scan_index = 0;
+    }
+    else if (_thread_stack_scan(rt_list_entry(node, struct rt_thread, list),
+                                RT_STACK_SCAN_WORDS * sizeof(rt_ubase_t)))
+    {
+        _stack_scan_index ++;
+    }
+
+    rt_exit_critical();
+}
+#endif /* RT_USING_STACK_WATERMARK */
+
 /**@}*/
+
+#if defined(RT_USING_STACK_WATERMARK) && defined(RT_USING_FINSH)
+#include <finsh.h>
+
+static void stackstat(void)
+{
+    int index;
+    rt_uint32_t peak, suggest;
+    rt_list_t *node;
+    struct rt_thread *thread;
+    struct rt_object_information *info;
+
+    rt_kprintf("%-*.s   size   peak  usage  suggest\n", RT_NAME_MAX, "thread");
+    for (index = 0; index < RT_NAME_MAX; index ++)
+        rt_kprintf("-");
+    rt_kprintf(" ------ ------ ------ --------\n");
+
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    rt_enter_critical();
+    for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+    {
+        thread = rt_list_entry(node, struct rt_thread, list);
+
+        peak = rt_thread_stack_usage(thread);
+        /* a quarter more than the peak, for the paths not run yet */
+        suggest = RT_ALIGN(peak + peak / 4, 8);
+
+        rt_kprintf("%-*.*s %6d %6d %5d%% %8d%s\n", RT_NAME_MAX, RT_NAME_MAX, thread->name,
+                   thread->stack_size, peak, peak * 100 / thread->stack_size,
+                   suggest, suggest > thread->stack_size ? " !" : "");
+    }
+    rt_exit_critical();
+}
+MSH_CMD_EXPORT(stackstat, show the peak stack usage and suggested size of threads);
+#endif /* defined(RT_USING_STACK_WATERMARK) && defined(RT_USING_FINSH) */
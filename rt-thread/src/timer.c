@@ -16,6 +16,9 @@
  * 2012-12-15     Bernard      fix the next timeout issue in soft timer
  * 2014-07-12     Bernard      does not lock scheduler when invoking soft-timer
  *                             timeout function.
+ * 2026-10-17     weizx208     add hierarchical timing wheel backend
+ * 2026-10-17     weizx208     add trace of timer timeout
+ * 2026-10-17     weizx208     resync timing wheel on tick set backward
  */
 
 #include <rtthread.h>
@@ -24,6 +27,53 @@
 /* hard timer list */
 static rt_list_t rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
 
+#ifdef RT_USING_TIMER_WHEEL
+
+#ifndef RT_TIMER_WHEEL_BITS
+#define RT_TIMER_WHEEL_BITS             6
+#endif
+
+#ifndef RT_TIMER_WHEEL_LEVEL
+#define RT_TIMER_WHEEL_LEVEL            4
+#endif
+
+#if (RT_TIMER_WHEEL_BITS * (RT_TIMER_WHEEL_LEVEL - 1)) >= 32
+#error "RT_TIMER_WHEEL_BITS * (RT_TIMER_WHEEL_LEVEL - 1) shall be less than 32"
+#endif
+
+#define RT_TIMER_WHEEL_SIZE             (1UL << RT_TIMER_WHEEL_BITS)
+#define RT_TIMER_WHEEL_MASK             (RT_TIMER_WHEEL_SIZE - 1)
+#if (RT_TIMER_WHEEL_BITS * RT_TIMER_WHEEL_LEVEL) < 32
+/* the timeout ticks that the wheel can hold without re-cascading */
+#define RT_TIMER_WHEEL_SPAN             (1UL << (RT_TIMER_WHEEL_BITS * RT_TIMER_WHEEL_LEVEL))
+#endif
+
+/* the node of timer in the wheel slot or in the expired list */
+#define RT_TIMER_WHEEL_ROW              (RT_TIMER_SKIP_LIST_LEVEL - 1)
+
+/*
+ * Hierarchical timing wheel. Level 0 holds the timers which expire within
+ * RT_TIMER_WHEEL_SIZE ticks, one slot per tick. Each upper level holds timers
+ * RT_TIMER_WHEEL_SIZE times farther away, and one of its slots is cascaded
+ * into the lower levels every time the lower level wraps around.
+ *
+ * The timers which are due are moved to the timer list, so the timer list
+ * only works as the expired list when the wheel is used.
+ *
+ * The wheel runs forward with the tick. When the tick is set backward by
+ * rt_tick_set(), the wheel is rebuilt from the new tick on the next start or
+ * check of timer, it's O(n) of the timers in wheel.
+ */
+struct rt_timer_wheel
+{
+    rt_tick_t current;                                  /**< the next tick to process */
+    rt_list_t slot[RT_TIMER_WHEEL_LEVEL][RT_TIMER_WHEEL_SIZE];
+};
+
+/* hard timer wheel */
+static struct rt_timer_wheel rt_timer_wheel;
+#endif
+
 #ifdef RT_USING_TIMER_SOFT
 
 #define RT_SOFT_TIMER_IDLE              1
@@ -41,6 +91,10 @@ static rt_list_t rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
 static rt_uint8_t soft_timer_status = RT_SOFT_TIMER_IDLE;
 /* soft timer list */
 static rt_list_t rt_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL];
+#ifdef RT_USING_TIMER_WHEEL
+/* soft timer wheel */
+static struct rt_timer_wheel rt_soft_timer_wheel;
+#endif
 static struct rt_thread timer_thread;
 ALIGN(RT_ALIGN_SIZE)
 static rt_uint8_t timer_thread_stack[RT_TIMER_THREAD_STACK_SIZE];
@@ -110,6 +164,7 @@ static void _rt_timer_init(rt_timer_t timer,
     }
 }
 
+#ifndef RT_USING_TIMER_WHEEL
 /* the fist timer always in the last row */
 static rt_tick_t rt_timer_list_next_timeout(rt_list_t timer_list[])
 {
@@ -132,6 +187,7 @@ static rt_tick_t rt_timer_list_next_timeout(rt_list_t timer_list[])
 
     return timeout_tick;
 }
+#endif
 
 rt_inline void _rt_timer_remove(rt_timer_t timer)
 {
@@ -143,6 +199,278 @@ rt_inline void _rt_timer_remove(rt_timer_t timer)
     }
 }
 
+#ifdef RT_USING_TIMER_WHEEL
+static void _rt_timer_wheel_init(struct rt_timer_wheel *wheel)
+{
+    int lvl, i;
+
+    for (lvl = 0; lvl < RT_TIMER_WHEEL_LEVEL; lvl++)
+    {
+        for (i = 0; i < RT_TIMER_WHEEL_SIZE; i++)
+        {
+            rt_list_init(&(wheel->slot[lvl][i]));
+        }
+    }
+    wheel->current = rt_tick_get();
+}
+
+/* insert the timer into the slot of its timeout tick, it's O(1) */
+static void _rt_timer_wheel_insert(struct rt_timer_wheel *wheel, rt_timer_t timer)
+{
+    int lvl;
+    rt_tick_t expires, delta;
+
+    expires = timer->timeout_tick;
+    delta   = expires - wheel->current;
+    lvl     = 0;
+
+    if (delta > RT_TICK_MAX / 2)
+    {
+        /* it's already timeout, let it expire on the next processed tick */
+        expires = wheel->current;
+    }
+    else
+    {
+#ifdef RT_TIMER_WHEEL_SPAN
+        if (delta >= RT_TIMER_WHEEL_SPAN)
+        {
+            /* park it in the top level, it will be cascaded again later */
+            delta   = RT_TIMER_WHEEL_SPAN - 1;
+            expires = wheel->current + delta;
+        }
+#endif
+        while (lvl < RT_TIMER_WHEEL_LEVEL - 1 &&
+               delta >= ((rt_tick_t)1 << (RT_TIMER_WHEEL_BITS * (lvl + 1))))
+        {
+            lvl ++;
+        }
+    }
+
+    rt_list_insert_before(&(wheel->slot[lvl][(expires >> (RT_TIMER_WHEEL_BITS * lvl)) & RT_TIMER_WHEEL_MASK]),
+                          &(timer->row[RT_TIMER_WHEEL_ROW]));
+}
+
+/*
+ * get the offset of the first used slot of a level from the slot of the
+ * current tick, -1 if this level is empty.
+ */
+static int _rt_timer_wheel_first_slot(struct rt_timer_wheel *wheel, int lvl)
+{
+    int i, from;
+    rt_tick_t index;
+
+    index = (wheel->current >> (RT_TIMER_WHEEL_BITS * lvl)) & RT_TIMER_WHEEL_MASK;
+
+    /*
+     * the current slot of upper level has been cascaded, the timers in it
+     * will expire after a whole round, except the lower levels are going to
+     * wrap around on the current tick.
+     */
+    from = 0;
+    if (lvl > 0 && (wheel->current & (((rt_tick_t)1 << (RT_TIMER_WHEEL_BITS * lvl)) - 1)))
+        from = 1;
+
+    for (i = from; i < from + RT_TIMER_WHEEL_SIZE; i++)
+    {
+        if (!rt_list_isempty(&(wheel->slot[lvl][(index + i) & RT_TIMER_WHEEL_MASK])))
+            return i;
+    }
+
+    return -1;
+}
+
+/* get the ticks from the current tick to the next slot to be processed */
+static rt_tick_t _rt_timer_wheel_next_event(struct rt_timer_wheel *wheel)
+{
+    int lvl, offset;
+    rt_tick_t event, delta = RT_TICK_MAX;
+
+    for (lvl = 0; lvl < RT_TIMER_WHEEL_LEVEL; lvl++)
+    {
+        offset = _rt_timer_wheel_first_slot(wheel, lvl);
+        if (offset < 0)
+            continue;
+
+        /* the tick on which this slot will be expired or cascaded */
+        event = ((wheel->current >> (RT_TIMER_WHEEL_BITS * lvl)) + offset)
+                << (RT_TIMER_WHEEL_BITS * lvl);
+        if (event - wheel->current < delta)
+            delta = event - wheel->current;
+    }
+
+    return delta;
+}
+
+/* get the earliest timeout tick in the wheel, RT_TICK_MAX if it's empty */
+static rt_tick_t _rt_timer_wheel_next_timeout(struct rt_timer_wheel *wheel)
+{
+    int lvl, offset, count;
+    rt_tick_t index;
+    rt_list_t *slot, *node;
+    struct rt_timer *timer;
+    rt_tick_t timeout_tick = RT_TICK_MAX;
+
+    for (lvl = 0; lvl < RT_TIMER_WHEEL_LEVEL; lvl++)
+    {
+        offset = _rt_timer_wheel_first_slot(wheel, lvl);
+        if (offset < 0)
+            continue;
+
+        /*
+         * the slots of a level are expired in order, so only the first used
+         * slot needs to be checked, except the top level which may hold the
+         * parked timers beyond the span of wheel.
+         */
+        count = 1;
+#ifdef RT_TIMER_WHEEL_SPAN
+        if (lvl == RT_TIMER_WHEEL_LEVEL - 1)
+            count = RT_TIMER_WHEEL_SIZE - offset + (offset ? 1 : 0);
+#endif
+        index = (wheel->current >> (RT_TIMER_WHEEL_BITS * lvl)) + offset;
+        while (count--)
+        {
+            slot = &(wheel->slot[lvl][index++ & RT_TIMER_WHEEL_MASK]);
+            for (node = slot->next; node != slot; node = node->next)
+            {
+                timer = rt_list_entry(node, struct rt_timer, row[RT_TIMER_WHEEL_ROW]);
+                if (timeout_tick == RT_TICK_MAX ||
+                    (timeout_tick - timer->timeout_tick) < RT_TICK_MAX / 2)
+                {
+                    timeout_tick = timer->timeout_tick;
+                }
+            }
+        }
+    }
+
+    return timeout_tick;
+}
+
+/* process one tick of the wheel, move the timeout timers to the expired list */
+static void _rt_timer_wheel_step(struct rt_timer_wheel *wheel, rt_list_t *expired)
+{
+    int lvl;
+    rt_list_t *slot;
+    struct rt_timer *timer;
+
+    /* cascade one slot of the upper level when the lower level wraps around */
+    for (lvl = 1; lvl < RT_TIMER_WHEEL_LEVEL; lvl++)
+    {
+        if ((wheel->current >> (RT_TIMER_WHEEL_BITS * (lvl - 1))) & RT_TIMER_WHEEL_MASK)
+            break;
+
+        slot = &(wheel->slot[lvl][(wheel->current >> (RT_TIMER_WHEEL_BITS * lvl)) & RT_TIMER_WHEEL_MASK]);
+        while (!rt_list_isempty(slot))
+        {
+            timer = rt_list_entry(slot->next, struct rt_timer, row[RT_TIMER_WHEEL_ROW]);
+            rt_list_remove(&(timer->row[RT_TIMER_WHEEL_ROW]));
+            _rt_timer_wheel_insert(wheel, timer);
+        }
+    }
+
+    /* splice the slot of current tick to the tail of expired list */
+    slot = &(wheel->slot[0][wheel->current & RT_TIMER_WHEEL_MASK]);
+    if (!rt_list_isempty(slot))
+    {
+        slot->next->prev    = expired->prev;
+        expired->prev->next = slot->next;
+        slot->prev->next    = expired;
+        expired->prev       = slot->prev;
+        rt_list_init(slot);
+    }
+
+    wheel->current ++;
+}
+
+/* rebuild the wheel from the tick if the tick has been set backward */
+static void _rt_timer_wheel_sync(struct rt_timer_wheel *wheel, rt_tick_t tick)
+{
+    int lvl, i;
+    rt_list_t list, *slot;
+    struct rt_timer *timer;
+
+    /* the wheel has processed the tick or lags behind it */
+    if ((wheel->current - tick - 1) == 0 || (wheel->current - tick - 1) >= RT_TICK_MAX / 2)
+        return;
+
+    rt_list_init(&list);
+    for (lvl = 0; lvl < RT_TIMER_WHEEL_LEVEL; lvl++)
+    {
+        for (i = 0; i < RT_TIMER_WHEEL_SIZE; i++)
+        {
+            slot = &(wheel->slot[lvl][i]);
+            while (!rt_list_isempty(slot))
+            {
+                timer = rt_list_entry(slot->next, struct rt_timer, row[RT_TIMER_WHEEL_ROW]);
+                rt_list_remove(&(timer->row[RT_TIMER_WHEEL_ROW]));
+                rt_list_insert_before(&list, &(timer->row[RT_TIMER_WHEEL_ROW]));
+            }
+        }
+    }
+
+    /* the tick is processed again, as the timer list checks the timers due on it */
+    wheel->current = tick;
+    while (!rt_list_isempty(&list))
+    {
+        timer = rt_list_entry(list.next, struct rt_timer, row[RT_TIMER_WHEEL_ROW]);
+        rt_list_remove(&(timer->row[RT_TIMER_WHEEL_ROW]));
+        _rt_timer_wheel_insert(wheel, timer);
+    }
+}
+
+/* run the wheel up to the tick, the timeout timers are moved to the timer list */
+static void _rt_timer_wheel_run(struct rt_timer_wheel *wheel,
+                                rt_list_t             timer_list[],
+                                rt_tick_t             tick)
+{
+    rt_tick_t delta;
+
+    _rt_timer_wheel_sync(wheel, tick);
+
+    while ((tick - wheel->current) < RT_TICK_MAX / 2)
+    {
+        /* skip the empty slots at once when the wheel lags far behind */
+        if ((tick - wheel->current) >= RT_TIMER_WHEEL_SIZE)
+        {
+            delta = _rt_timer_wheel_next_event(wheel);
+            if (delta > tick - wheel->current)
+            {
+                wheel->current = tick + 1;
+                break;
+            }
+            wheel->current += delta;
+        }
+
+        _rt_timer_wheel_step(wheel, &timer_list[RT_TIMER_WHEEL_ROW]);
+    }
+}
+
+static rt_tick_t rt_timer_wheel_next_timeout(struct rt_timer_wheel *wheel,
+                                             rt_list_t             timer_list[])
+{
+    register rt_base_t level;
+    rt_tick_t timeout_tick;
+
+    /* disable interrupt */
+    level = rt_hw_interrupt_disable();
+
+    if (!rt_list_isempty(&timer_list[RT_TIMER_WHEEL_ROW]))
+    {
+        /* there are timers timeout but not handled yet */
+        timeout_tick = rt_list_entry(timer_list[RT_TIMER_WHEEL_ROW].next,
+                                     struct rt_timer, row[RT_TIMER_WHEEL_ROW])->timeout_tick;
+    }
+    else
+    {
+        timeout_tick = _rt_timer_wheel_next_timeout(wheel);
+    }
+
+    /* enable interrupt */
+    rt_hw_interrupt_enable(level);
+
+    return timeout_tick;
+}
+#endif
+
 #if RT_DEBUG_TIMER
 static int rt_timer_count_height(struct rt_timer *timer)
 {
@@ -173,6 +501,68 @@ void rt_timer_dump(rt_list_t timer_heads[])
 }
 #endif
 
+#ifndef RT_USING_TIMER_WHEEL
+/* insert the timer into the skip list in the order of timeout tick */
+static void _rt_timer_list_insert(rt_list_t timer_list[], rt_timer_t timer)
+{
+    unsigned int row_lvl;
+    rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
+    unsigned int tst_nr;
+    static unsigned int random_nr;
+
+    row_head[0]  = &timer_list[0];
+    for (row_lvl = 0; row_lvl < RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+    {
+        for (; row_head[row_lvl] != timer_list[row_lvl].prev;
+             row_head[row_lvl]  = row_head[row_lvl]->next)
+        {
+            struct rt_timer *t;
+            rt_list_t *p = row_head[row_lvl]->next;
+
+            /* fix up the entry pointer */
+            t = rt_list_entry(p, struct rt_timer, row[row_lvl]);
+
+            /* If we have two timers that timeout at the same time, it's
+             * preferred that the timer inserted early get called early.
+             * So insert the new timer to the end the the some-timeout timer
+             * list.
+             */
+            if ((t->timeout_tick - timer->timeout_tick) == 0)
+            {
+                continue;
+            }
+            else if ((t->timeout_tick - timer->timeout_tick) < RT_TICK_MAX / 2)
+            {
+                break;
+            }
+        }
+        if (row_lvl != RT_TIMER_SKIP_LIST_LEVEL - 1)
+            row_head[row_lvl + 1] = row_head[row_lvl] + 1;
+    }
+
+    /* Interestingly, this super simple timer insert counter works very very
+     * well on distributing the list height uniformly. By means of "very very
+     * well", I mean it beats the randomness of timer->timeout_tick very easily
+     * (actually, the timeout_tick is not random and easy to be attacked). */
+    random_nr++;
+    tst_nr = random_nr;
+
+    rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - 1],
+                         &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
+    for (row_lvl = 2; row_lvl <= RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+    {
+        if (!(tst_nr & RT_TIMER_SKIP_LIST_MASK))
+            rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - row_lvl],
+                                 &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - row_lvl]));
+        else
+            break;
+        /* Shift over the bits we have tested. Works well with 1 bit and 2
+         * bits. */
+        tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
+    }
+}
+#endif
+
 /**
  * @addtogroup Clock
  */
@@ -310,12 +700,7 @@ rt_err_t rt_timer_delete(rt_timer_t timer)
  */
 rt_err_t rt_timer_start(rt_timer_t timer)
 {
-    unsigned int row_lvl;
-    rt_list_t *timer_list;
     register rt_base_t level;
-    rt_list_t *row_head[RT_TIMER_SKIP_LIST_LEVEL];
-    unsigned int tst_nr;
-    static unsigned int random_nr;
 
     /* timer check */
     RT_ASSERT(timer != RT_NULL);
@@ -337,69 +722,35 @@ rt_err_t rt_timer_start(rt_timer_t timer)
     RT_ASSERT(timer->init_tick < RT_TICK_MAX / 2);
     timer->timeout_tick = rt_tick_get() + timer->init_tick;
 
+#ifdef RT_USING_TIMER_WHEEL
 #ifdef RT_USING_TIMER_SOFT
     if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
     {
-        /* insert timer to soft timer list */
-        timer_list = rt_soft_timer_list;
+        /* insert timer to soft timer wheel */
+        _rt_timer_wheel_sync(&rt_soft_timer_wheel, rt_tick_get());
+        _rt_timer_wheel_insert(&rt_soft_timer_wheel, timer);
     }
     else
 #endif
     {
-        /* insert timer to system timer list */
-        timer_list = rt_timer_list;
+        /* insert timer to system timer wheel */
+        _rt_timer_wheel_sync(&rt_timer_wheel, rt_tick_get());
+        _rt_timer_wheel_insert(&rt_timer_wheel, timer);
     }
-
-    row_head[0]  = &timer_list[0];
-    for (row_lvl = 0; row_lvl < RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+#else
+#ifdef RT_USING_TIMER_SOFT
+    if (timer->parent.flag & RT_TIMER_FLAG_SOFT_TIMER)
     {
-        for (; row_head[row_lvl] != timer_list[row_lvl].prev;
-             row_head[row_lvl]  = row_head[row_lvl]->next)
-        {
-            struct rt_timer *t;
-            rt_list_t *p = row_head[row_lvl]->next;
-
-            /* fix up the entry pointer */
-            t = rt_list_entry(p, struct rt_timer, row[row_lvl]);
-
-            /* If we have two timers that timeout at the same time, it's
-             * preferred that the timer inserted early get called early.
-             * So insert the new timer to the end the the some-timeout timer
-             * list.
-             */
-            if ((t->timeout_tick - timer->timeout_tick) == 0)
-            {
-                continue;
-            }
-            else if ((t->timeout_tick - timer->timeout_tick) < RT_TICK_MAX / 2)
-            {
-                break;
-            }
-        }
-        if (row_lvl != RT_TIMER_SKIP_LIST_LEVEL - 1)
-            row_head[row_lvl + 1] = row_head[row_lvl] + 1;
+        /* insert timer to soft timer list */
+        _rt_timer_list_insert(rt_soft_timer_list, timer);
     }
-
-    /* Interestingly, this super simple timer insert counter works very very
-     * well on distributing the list height uniformly. By means of "very very
-     * well", I mean it beats the randomness of timer->timeout_tick very easily
-     * (actually, the timeout_tick is not random and easy to be attacked). */
-    random_nr++;
-    tst_nr = random_nr;
-
-    rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - 1],
-                         &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - 1]));
-    for (row_lvl = 2; row_lvl <= RT_TIMER_SKIP_LIST_LEVEL; row_lvl++)
+    else
+#endif
     {
-        if (!(tst_nr & RT_TIMER_SKIP_LIST_MASK))
-            rt_list_insert_after(row_head[RT_TIMER_SKIP_LIST_LEVEL - row_lvl],
-                                 &(timer->row[RT_TIMER_SKIP_LIST_LEVEL - row_lvl]));
-        else
-            break;
-        /* Shift over the bits we have tested. Works well with 1 bit and 2
-         * bits. */
-        tst_nr >>= (RT_TIMER_SKIP_LIST_MASK + 1) >> 1;
+        /* insert timer to system timer list */
+        _rt_timer_list_insert(rt_timer_list, timer);
     }
+#endif
 
     timer->parent.flag |= RT_TIMER_FLAG_ACTIVATED;
 
@@ -535,6 +886,11 @@ void rt_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_TIMER_WHEEL
+    /* move the timeout timers from wheel to timer list */
+    _rt_timer_wheel_run(&rt_timer_wheel, rt_timer_list, current_tick);
+#endif
+
     while (!rt_list_isempty(&rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
     {
         t = rt_list_entry(rt_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
@@ -547,6 +903,7 @@ void rt_timer_check(void)
         if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
         {
             RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+            RT_TRACE_RECORD(RT_TRACE_TIMER_EXPIRE, t->parent.flag, t);
 
             /* remove timer from timer list firstly */
             _rt_timer_remove(t);
@@ -595,7 +952,11 @@ void rt_timer_check(void)
  */
 rt_tick_t rt_timer_next_timeout_tick(void)
 {
+#ifdef RT_USING_TIMER_WHEEL
+    return rt_timer_wheel_next_timeout(&rt_timer_wheel, rt_timer_list);
+#else
     return rt_timer_list_next_timeout(rt_timer_list);
+#endif
 }
 
 #ifdef RT_USING_TIMER_SOFT
@@ -617,6 +978,11 @@ void rt_soft_timer_check(void)
     /* disable interrupt */
     level = rt_hw_interrupt_disable();
 
+#ifdef RT_USING_TIMER_WHEEL
+    /* move the timeout timers from wheel to soft timer list */
+    _rt_timer_wheel_run(&rt_soft_timer_wheel, rt_soft_timer_list, rt_tick_get());
+#endif
+
     while (!rt_list_isempty(&rt_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1]))
     {
         t = rt_list_entry(rt_soft_timer_list[RT_TIMER_SKIP_LIST_LEVEL - 1].next,
@@ -631,6 +997,7 @@ void rt_soft_timer_check(void)
         if ((current_tick - t->timeout_tick) < RT_TICK_MAX / 2)
         {
             RT_OBJECT_HOOK_CALL(rt_timer_enter_hook, (t));
+            RT_TRACE_RECORD(RT_TRACE_TIMER_EXPIRE, t->parent.flag, t);
 
             /* remove timer from timer list firstly */
             _rt_timer_remove(t);
@@ -685,7 +1052,11 @@ static void rt_thread_timer_entry(void *parameter)
     while (1)
     {
         /* get the next timeout tick */
+#ifdef RT_USING_TIMER_WHEEL
+        next_timeout = rt_timer_wheel_next_timeout(&rt_soft_timer_wheel, rt_soft_timer_list);
+#else
         next_timeout = rt_timer_list_next_timeout(rt_soft_timer_list);
+#endif
         if (next_timeout == RT_TICK_MAX)
         {
             /* no software timer exist, suspend self. */
@@ -726,6 +1097,10 @@ void rt_system_timer_init(void)
     {
         rt_list_init(rt_timer_list + i);
     }
+
+#ifdef RT_USING_TIMER_WHEEL
+    _rt_timer_wheel_init(&rt_timer_wheel);
+#endif
 }
 
 /**
@@ -744,6 +1119,9 @@ void rt_system_timer_thread_init(void)
     {
         rt_list_init(rt_soft_timer_list + i);
     }
+#ifdef RT_USING_TIMER_WHEEL
+    _rt_timer_wheel_init(&rt_soft_timer_wheel);
+#endif
 
     /* start software timer thread */
     rt_thread_init(&timer_thread,
@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Two-Level Segregated Fit memory allocator.
+ *
+ * The free blocks are kept in a two-level array of lists, the first level is
+ * indexed by the power of 2 of the size and the second level divides each
+ * power of 2 range into 2^TLSF_SL_INDEX_LOG2 linear ranges. Two bitmaps record
+ * the non-empty lists, so the allocation and release take a constant time no
+ * matter how the heap is fragmented.
+ *
+ * Each block has only one word of header (the size and flags). The link of
+ * free lists is kept in the data area of free block, and the address of a
+ * free block is saved in its last word to merge with the next block.
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#if defined (RT_USING_HEAP) && defined (RT_USING_TLSF)
+
+#if defined (RT_USING_SMALL_MEM) || defined (RT_USING_SLAB) || defined (RT_USING_MEMHEAP_AS_HEAP)
+#error "RT_USING_TLSF can not be used with other heap algorithm"
+#endif
+
+/* the number of second level lists in log2 */
+#ifndef TLSF_SL_INDEX_LOG2
+#define TLSF_SL_INDEX_LOG2      4
+#endif
+/* the largest block is less than 2^(TLSF_FL_INDEX_MAX + 1) */
+#ifndef TLSF_FL_INDEX_MAX
+#define TLSF_FL_INDEX_MAX       20
+#endif
+
+#if RT_ALIGN_SIZE == 4
+#define TLSF_ALIGN_LOG2         2
+#elif RT_ALIGN_SIZE == 8
+#define TLSF_ALIGN_LOG2         3
+#elif RT_ALIGN_SIZE == 16
+#define TLSF_ALIGN_LOG2         4
+#else
+#error "RT_ALIGN_SIZE shall be 4, 8 or 16 for TLSF"
+#endif
+
+#if TLSF_FL_INDEX_MAX > 30 || TLSF_SL_INDEX_LOG2 > 5
+#error "the index of TLSF is out of range"
+#endif
+
+#define TLSF_SL_INDEX_COUNT     (1UL << TLSF_SL_INDEX_LOG2)
+/* the blocks smaller than it are all in the first level list 0 */
+#define TLSF_FL_INDEX_SHIFT     (TLSF_SL_INDEX_LOG2 + TLSF_ALIGN_LOG2)
+#define TLSF_FL_INDEX_COUNT     (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 2)
+#define TLSF_SMALL_BLOCK_SIZE   (1UL << TLSF_FL_INDEX_SHIFT)
+
+#define TLSF_BLOCK_FREE         0x01
+#define TLSF_BLOCK_PREV_FREE    0x02
+#define TLSF_BLOCK_FLAGS        (TLSF_BLOCK_FREE | TLSF_BLOCK_PREV_FREE)
+
+struct tlsf_block
+{
+    rt_size_t size;                     /* size of data area and the flags */
+};
+
+struct tlsf_link
+{
+    struct tlsf_block *next;            /* the next free block in list */
+    struct tlsf_block *prev;            /* the previous free block in list */
+};
+
+/* the header of block, it's the overhead of a used block */
+#define TLSF_HEAD_SIZE          RT_ALIGN(sizeof(struct tlsf_block), RT_ALIGN_SIZE)
+/* a free block holds the link and the address of itself at the end */
+#define TLSF_MIN_SIZE           RT_ALIGN(sizeof(struct tlsf_link) + sizeof(struct tlsf_block *), RT_ALIGN_SIZE)
+#define TLSF_MAX_SIZE           (((rt_size_t)2 << TLSF_FL_INDEX_MAX) - RT_ALIGN_SIZE)
+
+#define TLSF_BLOCK_SIZE(block)  ((block)->size & ~(rt_size_t)TLSF_BLOCK_FLAGS)
+#define TLSF_BLOCK_DATA(block)  ((void *)((rt_uint8_t *)(block) + TLSF_HEAD_SIZE))
+#define TLSF_DATA_BLOCK(data)   ((struct tlsf_block *)((rt_uint8_t *)(data) - TLSF_HEAD_SIZE))
+#define TLSF_BLOCK_LINK(block)  ((struct tlsf_link *)TLSF_BLOCK_DATA(block))
+#define TLSF_BLOCK_NEXT(block)  ((struct tlsf_block *)((rt_uint8_t *)TLSF_BLOCK_DATA(block) + TLSF_BLOCK_SIZE(block)))
+/* the address of previous block, it's valid only when the previous block is free */
+#define TLSF_BLOCK_PREV(block)  (((struct tlsf_block **)(block))[-1])
+
+/*
+ * the index of the most/least significant set bit of a non-zero value, the
+ * compiler intrinsic is used when it exists.
+ */
+#if defined(__CC_ARM)
+#define _tlsf_fls(value)        (31 - (int)__clz(value))
+#define _tlsf_ffs(value)        ((int)__clz(__rbit(value)))
+#elif defined(__IAR_SYSTEMS_ICC__)
+#include <intrinsics.h>
+#define _tlsf_fls(value)        (31 - (int)__CLZ(value))
+#define _tlsf_ffs(value)        ((int)__CLZ(__RBIT(value)))
+#elif defined(__GNUC__) || defined(__CLANG_ARM)
+#define _tlsf_fls(value)        (31 - __builtin_clz(value))
+#define _tlsf_ffs(value)        (__builtin_ctz(value))
+#else
+#define _tlsf_ffs(value)        (__rt_ffs(value) - 1)
+
+static int _tlsf_fls(rt_uint32_t value)
+{
+    int bit = 31;
+
+    if (!(value & 0xffff0000UL)) { value <<= 16; bit -= 16; }
+    if (!(value & 0xff000000UL)) { value <<= 8;  bit -= 8;  }
+    if (!(value & 0xf0000000UL)) { value <<= 4;  bit -= 4;  }
+    if (!(value & 0xc0000000UL)) { value <<= 2;  bit -= 2;  }
+    if (!(value & 0x80000000UL)) { bit -= 1; }
+
+    return bit;
+}
+#endif
+
+#ifdef RT_USING_HOOK
+static void (*rt_malloc_hook)(void *ptr, rt_size_t size);
+static void (*rt_free_hook)(void *ptr);
+
+/**
+ * @addtogroup Hook
+ */
+
+/**@{*/
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is allocated from heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_malloc_sethook(void (*hook)(void *ptr, rt_size_t size))
+{
+    rt_malloc_hook = hook;
+}
+
+/**
+ * This function will set a hook function, which will be invoked when a memory
+ * block is released to heap memory.
+ *
+ * @param hook the hook function
+ */
+void rt_free_sethook(void (*hook)(void *ptr))
+{
+    rt_free_hook = hook;
+}
+
+/**@}*/
+
+#endif
+
+/* the bitmap of non-empty first level and second level lists */
+static rt_uint32_t tlsf_fl_bitmap;
+static rt_uint32_t tlsf_sl_bitmap[TLSF_FL_INDEX_COUNT];
+static struct tlsf_block *tlsf_free[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+
+static rt_uint8_t *heap_ptr;
+static struct tlsf_block *heap_end;
+static rt_size_t mem_size_aligned;
+static rt_size_t used_mem, max_mem;
+
+/* get the list index of a block size */
+rt_inline void _tlsf_mapping(rt_size_t size, int *fl, int *sl)
+{
+    if (size < TLSF_SMALL_BLOCK_SIZE)
+    {
+        *fl = 0;
+        *sl = (int)(size >> TLSF_ALIGN_LOG2);
+    }
+    else
+    {
+        *fl = _tlsf_fls((rt_uint32_t)size);
+        *sl = (int)(size >> (*fl - TLSF_SL_INDEX_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+        *fl -= TLSF_FL_INDEX_SHIFT - 1;
+    }
+}
+
+static void _tlsf_insert(struct tlsf_block *block)
+{
+    int fl, sl;
+    struct tlsf_block *head;
+
+    _tlsf_mapping(TLSF_BLOCK_SIZE(block), &fl, &sl);
+
+    head = tlsf_free[fl][sl];
+    TLSF_BLOCK_LINK(block)->next = head;
+    TLSF_BLOCK_LINK(block)->prev = RT_NULL;
+    if (head != RT_NULL)
+        TLSF_BLOCK_LINK(head)->prev = block;
+    tlsf_free[fl][sl] = block;
+
+    tlsf_fl_bitmap |= 1UL << fl;
+    tlsf_sl_bitmap[fl] |= 1UL << sl;
+}
+
+static void _tlsf_remove(struct tlsf_block *block)
+{
+    int fl, sl;
+    struct tlsf_link *link;
+
+    _tlsf_mapping(TLSF_BLOCK_SIZE(block), &fl, &sl);
+
+    link = TLSF_BLOCK_LINK(block);
+    if (link->next != RT_NULL)
+        TLSF_BLOCK_LINK(link->next)->prev = link->prev;
+    if (link->prev != RT_NULL)
+    {
+        TLSF_BLOCK_LINK(link->prev)->next = link->next;
+    }
+    else
+    {
+        tlsf_free[fl][sl] = link->next;
+        if (link->next == RT_NULL)
+        {
+            tlsf_sl_bitmap[fl] &= ~(1UL << sl);
+            if (tlsf_sl_bitmap[fl] == 0)
+                tlsf_fl_bitmap &= ~(1UL << fl);
+        }
+    }
+}
+
+/* mark a block as free and tell it to the next block */
+rt_inline void _tlsf_set_free(struct tlsf_block *block)
+{
+    struct tlsf_block *next;
+
+    block->size |= TLSF_BLOCK_FREE;
+    next = TLSF_BLOCK_NEXT(block);
+    next->size |= TLSF_BLOCK_PREV_FREE;
+    TLSF_BLOCK_PREV(next) = block;
+}
+
+rt_inline void _tlsf_set_used(struct tlsf_block *block)
+{
+    block->size &= ~(rt_size_t)TLSF_BLOCK_FREE;
+    TLSF_BLOCK_NEXT(block)->size &= ~(rt_size_t)TLSF_BLOCK_PREV_FREE;
+}
+
+/* find a free block which is large enough for size, and take it out of list */
+static struct tlsf_block *_tlsf_search(rt_size_t size)
+{
+    int fl, sl;
+    rt_uint32_t map;
+    struct tlsf_block *block;
+
+    /* round up to the next list, so that any block in the list is fit */
+    if (size >= TLSF_SMALL_BLOCK_SIZE)
+        size += (1UL << (_tlsf_fls((rt_uint32_t)size) - TLSF_SL_INDEX_LOG2)) - 1;
+    _tlsf_mapping(size, &fl, &sl);
+    if (fl >= TLSF_FL_INDEX_COUNT)
+        return RT_NULL;
+
+    map = tlsf_sl_bitmap[fl] & (~0UL << sl);
+    if (map == 0)
+    {
+        /* no block in this first level, try the larger one */
+        map = tlsf_fl_bitmap & (~0UL << (fl + 1));
+        if (map == 0)
+            return RT_NULL;
+
+        fl  = _tlsf_ffs(map);
+        map = tlsf_sl_bitmap[fl];
+    }
+    sl = _tlsf_ffs(map);
+
+    block = tlsf_free[fl][sl];
+    RT_ASSERT(block != RT_NULL);
+    _tlsf_remove(block);
+
+    return block;
+}
+
+/* split the tail of block to a new free block if it's large enough */
+static void _tlsf_trim(struct tlsf_block *block, rt_size_t size)
+{
+    struct tlsf_block *remain, *next;
+    rt_size_t block_size;
+
+    block_size = TLSF_BLOCK_SIZE(block);
+    if (block_size < size + TLSF_HEAD_SIZE + TLSF_MIN_SIZE)
+        return;
+
+    remain = (struct tlsf_block *)((rt_uint8_t *)TLSF_BLOCK_DATA(block) + size);
+    remain->size = block_size - size - TLSF_HEAD_SIZE;
+    block->size  = size | (block->size & TLSF_BLOCK_FLAGS);
+
+    /* merge the remain with next block if it's free */
+    next = TLSF_BLOCK_NEXT(remain);
+    if (next->size & TLSF_BLOCK_FREE)
+    {
+        _tlsf_remove(next);
+        remain->size += TLSF_BLOCK_SIZE(next) + TLSF_HEAD_SIZE;
+    }
+
+    _tlsf_set_free(remain);
+    _tlsf_insert(remain);
+}
+
+/* adjust the request size to the size of data area */
+rt_inline rt_size_t _tlsf_adjust_size(rt_size_t size)
+{
+    if (size > TLSF_MAX_SIZE)
+        return 0;
+
+    size = RT_ALIGN(size, RT_ALIGN_SIZE);
+    if (size < TLSF_MIN_SIZE)
+        size = TLSF_MIN_SIZE;
+
+    return size;
+}
+
+/**
+ * @ingroup SystemInit
+ *
+ * This function will initialize system heap memory.
+ *
+ * @param begin_addr the beginning address of system heap memory.
+ * @param end_addr the end address of system heap memory.
+ */
+void rt_system_heap_init(void *begin_addr, void *end_addr)
+{
+    struct tlsf_block *block, *stub;
+    rt_size_t size;
+    rt_ubase_t begin_align = RT_ALIGN((rt_ubase_t)begin_addr, RT_ALIGN_SIZE);
+    rt_ubase_t end_align   = RT_ALIGN_DOWN((rt_ubase_t)end_addr, RT_ALIGN_SIZE);
+
+    RT_DEBUG_NOT_IN_INTERRUPT;
+
+    /* one block and the end stub at least */
+    if ((end_align <= begin_align) ||
+        (end_align - begin_align < 2 * TLSF_HEAD_SIZE + TLSF_MIN_SIZE))
+    {
+        rt_kprintf("mem init, error begin address 0x%x, and end address 0x%x\n",
+                   (rt_ubase_t)begin_addr, (rt_ubase_t)end_addr);
+
+        return;
+    }
+
+    heap_ptr = (rt_uint8_t *)begin_align;
+
+    /* the end stub is a used block without data */
+    heap_end = (struct tlsf_block *)(end_align - TLSF_HEAD_SIZE);
+    heap_end->size = 0;
+
+    /*
+     * split the heap to the blocks which are not larger than the maximum size,
+     * and each block is followed by a stub, so that they are never merged.
+     */
+    mem_size_aligned = 0;
+    block = (struct tlsf_block *)heap_ptr;
+    while (block < heap_end &&
+           (rt_uint8_t *)heap_end - (rt_uint8_t *)block >= TLSF_HEAD_SIZE + TLSF_MIN_SIZE)
+    {
+        size = (rt_uint8_t *)heap_end - (rt_uint8_t *)block - TLSF_HEAD_SIZE;
+        if (size > TLSF_MAX_SIZE)
+            size = TLSF_MAX_SIZE;
+
+        block->size = size;
+        stub = TLSF_BLOCK_NEXT(block);
+        stub->size = 0;
+        _tlsf_set_free(block);
+        _tlsf_insert(block);
+        mem_size_aligned += size + TLSF_HEAD_SIZE;
+
+        block = (struct tlsf_block *)((rt_uint8_t *)stub + TLSF_HEAD_SIZE);
+    }
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM, ("mem init, heap begin address 0x%x, size %d\n",
+                                (rt_ubase_t)heap_ptr, mem_size_aligned));
+}
+
+/**
+ * @addtogroup MM
+ */
+
+/**@{*/
+
+/**
+ * Allocate a block of memory with a minimum of 'size' bytes.
+ *
+ * @param size is the minimum size of the requested block in bytes.
+ *
+ * @return pointer to allocated memory or NULL if no free memory was found.
+ */
+void *rt_malloc(rt_size_t size)
+{
+    rt_base_t level;
+    struct tlsf_block *block;
+
+    if (size == 0)
+        return RT_NULL;
+
+#ifdef RT_USING_MEM_CACHE
+    /* try the small memory cache of thread first */
+    {
+        void *cached;
+
+        cached = rt_mem_cache_alloc(&size);
+        if (cached != RT_NULL)
+        {
+            RT_OBJECT_HOOK_CALL(rt_malloc_hook, (cached, size));
+
+            return cached;
+        }
+    }
+#endif
+
+    size = _tlsf_adjust_size(size);
+    if (size == 0)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("no memory\n"));
+
+        return RT_NULL;
+    }
+
+    /* the allocation takes a constant time, so the interrupt is disabled */
+    level = rt_hw_interrupt_disable();
+
+    block = _tlsf_search(size);
+    if (block == RT_NULL)
+    {
+        rt_hw_interrupt_enable(level);
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("no memory\n"));
+
+        return RT_NULL;
+    }
+
+    _tlsf_set_used(block);
+    _tlsf_trim(block, size);
+
+    used_mem += TLSF_BLOCK_SIZE(block) + TLSF_HEAD_SIZE;
+    if (max_mem < used_mem)
+        max_mem = used_mem;
+
+    rt_hw_interrupt_enable(level);
+
+    RT_ASSERT((((rt_ubase_t)TLSF_BLOCK_DATA(block)) & (RT_ALIGN_SIZE - 1)) == 0);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM,
+                 ("allocate memory at 0x%x, size: %d\n",
+                  (rt_ubase_t)TLSF_BLOCK_DATA(block),
+                  (rt_ubase_t)TLSF_BLOCK_SIZE(block)));
+
+    RT_OBJECT_HOOK_CALL(rt_malloc_hook, (TLSF_BLOCK_DATA(block), size));
+
+    return TLSF_BLOCK_DATA(block);
+}
+
+/**
+ * This function will change the previously allocated memory block.
+ *
+ * @param rmem pointer to memory allocated by rt_malloc
+ * @param newsize the required new size
+ *
+ * @return the changed memory block address
+ */
+void *rt_realloc(void *rmem, rt_size_t newsize)
+{
+    rt_base_t level;
+    rt_size_t size;
+    struct tlsf_block *block, *next;
+    void *nmem;
+
+    if (newsize == 0)
+    {
+        rt_free(rmem);
+
+        return RT_NULL;
+    }
+
+    /* allocate a new memory block */
+    if (rmem == RT_NULL)
+        return rt_malloc(newsize);
+
+    if ((rt_uint8_t *)rmem < heap_ptr || (rt_uint8_t *)rmem >= (rt_uint8_t *)heap_end)
+    {
+        /* illegal memory */
+        return rmem;
+    }
+
+    newsize = _tlsf_adjust_size(newsize);
+    if (newsize == 0)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("realloc: out of memory\n"));
+
+        return RT_NULL;
+    }
+
+    block = TLSF_DATA_BLOCK(rmem);
+    RT_ASSERT(!(block->size & TLSF_BLOCK_FREE));
+
+    level = rt_hw_interrupt_disable();
+
+    size = TLSF_BLOCK_SIZE(block);
+    next = TLSF_BLOCK_NEXT(block);
+    if (newsize > size && (next->size & TLSF_BLOCK_FREE) &&
+        size + TLSF_HEAD_SIZE + TLSF_BLOCK_SIZE(next) >= newsize)
+    {
+        /* expand to the next free block */
+        _tlsf_remove(next);
+        block->size += TLSF_BLOCK_SIZE(next) + TLSF_HEAD_SIZE;
+        _tlsf_set_used(block);
+    }
+
+    if (newsize <= TLSF_BLOCK_SIZE(block))
+    {
+        /* shrink the block in place */
+        _tlsf_trim(block, newsize);
+
+        used_mem += TLSF_BLOCK_SIZE(block);
+        used_mem -= size;
+        if (max_mem < used_mem)
+            max_mem = used_mem;
+
+        rt_hw_interrupt_enable(level);
+
+        return rmem;
+    }
+    rt_hw_interrupt_enable(level);
+
+    /* move to a new memory block */
+    nmem = rt_malloc(newsize);
+    if (nmem != RT_NULL)
+    {
+        rt_memcpy(nmem, rmem, size);
+        rt_free(rmem);
+    }
+
+    return nmem;
+}
+
+/**
+ * This function will contiguously allocate enough space for count objects
+ * that are size bytes of memory each and returns a pointer to the allocated
+ * memory.
+ *
+ * The allocated memory is filled with bytes of value zero.
+ *
+ * @param count number of objects to allocate
+ * @param size size of the objects to allocate
+ *
+ * @return pointer to allocated memory / NULL pointer if there is an error
+ */
+void *rt_calloc(rt_size_t count, rt_size_t size)
+{
+    void *p;
+
+    /* the total size is overflow */
+    if (size != 0 && count > ~(rt_size_t)0 / size)
+        return RT_NULL;
+
+    /* allocate 'count' objects of size 'size' */
+    p = rt_malloc(count * size);
+
+    /* zero the memory */
+    if (p)
+        rt_memset(p, 0, count * size);
+
+    return p;
+}
+
+/* release a used block, it's invoked with interrupt disabled */
+static void _tlsf_release(struct tlsf_block *block)
+{
+    struct tlsf_block *prev, *next;
+
+    used_mem -= TLSF_BLOCK_SIZE(block) + TLSF_HEAD_SIZE;
+
+    /* merge with the previous and next block if they are free */
+    if (block->size & TLSF_BLOCK_PREV_FREE)
+    {
+        prev = TLSF_BLOCK_PREV(block);
+        _tlsf_remove(prev);
+        prev->size += TLSF_BLOCK_SIZE(block) + TLSF_HEAD_SIZE;
+        block = prev;
+    }
+    next = TLSF_BLOCK_NEXT(block);
+    if (next->size & TLSF_BLOCK_FREE)
+    {
+        _tlsf_remove(next);
+        block->size += TLSF_BLOCK_SIZE(next) + TLSF_HEAD_SIZE;
+    }
+
+    _tlsf_set_free(block);
+    _tlsf_insert(block);
+}
+
+/**
+ * This function will release the previously allocated memory block by
+ * rt_malloc. The released memory block is taken back to system heap.
+ *
+ * @param rmem the address of memory which will be released
+ */
+void rt_free(void *rmem)
+{
+    rt_base_t level;
+    struct tlsf_block *block;
+
+    if (rmem == RT_NULL)
+        return;
+
+    RT_ASSERT((((rt_ubase_t)rmem) & (RT_ALIGN_SIZE - 1)) == 0);
+    RT_ASSERT((rt_uint8_t *)rmem >= heap_ptr &&
+              (rt_uint8_t *)rmem < (rt_uint8_t *)heap_end);
+
+    RT_OBJECT_HOOK_CALL(rt_free_hook, (rmem));
+
+    if ((rt_uint8_t *)rmem < heap_ptr || (rt_uint8_t *)rmem >= (rt_uint8_t *)heap_end)
+    {
+        RT_DEBUG_LOG(RT_DEBUG_MEM, ("illegal memory\n"));
+
+        return;
+    }
+
+    block = TLSF_DATA_BLOCK(rmem);
+
+    RT_DEBUG_LOG(RT_DEBUG_MEM,
+                 ("release memory 0x%x, size: %d\n",
+                  (rt_ubase_t)rmem, (rt_ubase_t)TLSF_BLOCK_SIZE(block)));
+
+#ifdef RT_USING_MEM_CACHE
+    /* keep it in the small memory cache of thread */
+    if (!(block->size & TLSF_BLOCK_FREE) && rt_mem_cache_free(rmem, TLSF_BLOCK_SIZE(block)))
+        return;
+#endif
+
+    level = rt_hw_interrupt_disable();
+
+    if (block->size & TLSF_BLOCK_FREE)
+    {
+        rt_hw_interrupt_enable(level);
+        rt_kprintf("to free a bad data block: 0x%08x\n", rmem);
+        RT_ASSERT(0);
+
+        return;
+    }
+
+    _tlsf_release(block);
+
+    rt_hw_interrupt_enable(level);
+}
+
+#ifdef RT_USING_MEM_CACHE
+/**
+ * This function will release a list of memory blocks to system heap, the
+ * interrupt is disabled once for all of them. It's used by the small memory
+ * cache of thread, the free hook has been invoked when the blocks were cached.
+ *
+ * @param list the first block, each block is linked by its first word
+ */
+void rt_free_list(void *list)
+{
+    rt_base_t level;
+    void *rmem;
+    struct tlsf_block *block;
+
+    level = rt_hw_interrupt_disable();
+    while (list != RT_NULL)
+    {
+        rmem = list;
+        list = *(void **)rmem;
+
+        block = TLSF_DATA_BLOCK(rmem);
+        RT_ASSERT(!(block->size & TLSF_BLOCK_FREE));
+        _tlsf_release(block);
+    }
+    rt_hw_interrupt_enable(level);
+}
+#endif
+
+void rt_memory_info(rt_uint32_t *total,
+                    rt_uint32_t *used,
+                    rt_uint32_t *max_used)
+{
+    if (total != RT_NULL)
+        *total = mem_size_aligned;
+    if (used  != RT_NULL)
+        *used = used_mem;
+    if (max_used != RT_NULL)
+        *max_used = max_mem;
+}
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+void list_mem(void)
+{
+    rt_kprintf("total memory: %d\n", mem_size_aligned);
+    rt_kprintf("used memory : %d\n", used_mem);
+    rt_kprintf("maximum allocated memory: %d\n", max_mem);
+}
+FINSH_FUNCTION_EXPORT(list_mem, list memory usage information)
+#endif
+
+/**@}*/
+
+#endif /* defined (RT_USING_HEAP) && defined (RT_USING_TLSF) */
@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_TRACE
+
+#ifndef RT_TRACE_BUF_SIZE
+#define RT_TRACE_BUF_SIZE       256
+#endif
+
+#if (RT_TRACE_BUF_SIZE & (RT_TRACE_BUF_SIZE - 1)) != 0
+#error "RT_TRACE_BUF_SIZE shall be power of 2"
+#endif
+
+/* trace ring buffer, the oldest record is overwritten when it's full */
+static struct rt_trace_record _trace_buf[RT_TRACE_BUF_SIZE];
+/* the number of records written, it's the index of next record */
+static volatile rt_uint32_t _trace_index = 0;
+static volatile rt_uint8_t _trace_enable = 1;
+
+/* reserve one record without locking */
+rt_inline rt_uint32_t _trace_reserve(void)
+{
+#if defined(__CC_ARM) && (defined(__TARGET_ARCH_7_M) || defined(__TARGET_ARCH_7E_M))
+    rt_uint32_t index;
+
+    do
+    {
+        index = __ldrex(&_trace_index);
+    }
+    while (__strex(index + 1, &_trace_index));
+
+    return index;
+#elif defined(__GNUC__) && defined(__GCC_HAVE_SYNC_COMPARE_AND_SWAP_4)
+    return __atomic_fetch_add(&_trace_index, 1, __ATOMIC_RELAXED);
+#else
+    rt_base_t level;
+    rt_uint32_t index;
+
+    level = rt_hw_interrupt_disable();
+    index = _trace_index ++;
+    rt_hw_interrupt_enable(level);
+
+    return index;
+#endif
+}
+
+/**
+ * @addtogroup Kernel
+ */
+
+/**@{*/
+
+/**
+ * This function will put one record into the trace buffer. It's invoked by
+ * the kernel through RT_TRACE_RECORD.
+ *
+ * @param event the trace event
+ * @param arg the argument of event
+ * @param object the thread or object of event
+ */
+void rt_trace_record(rt_uint8_t event, rt_uint16_t arg, void *object)
+{
+    rt_uint32_t timestamp;
+    struct rt_trace_record *record;
+
+    if (!_trace_enable)
+        return;
+
+    /* the time of event, before the record is reserved against the others */
+    timestamp = rt_timestamp_get();
+    record = &_trace_buf[_trace_reserve() & (RT_TRACE_BUF_SIZE - 1)];
+    record->timestamp = timestamp;
+    record->event     = event;
+    record->arg       = arg;
+    record->object    = (rt_ubase_t)object;
+}
+
+/**
+ * This function will start recording trace events.
+ */
+void rt_trace_start(void)
+{
+    _trace_enable = 1;
+}
+
+/**
+ * This function will stop recording trace events.
+ */
+void rt_trace_stop(void)
+{
+    _trace_enable = 0;
+}
+
+/**
+ * This function will drop all the records in trace buffer.
+ */
+void rt_trace_clear(void)
+{
+    rt_base_t level;
+
+    level = rt_hw_interrupt_disable();
+    _trace_index = 0;
+    rt_hw_interrupt_enable(level);
+}
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+static void _trace_dump(void)
+{
+    rt_uint8_t enable;
+    rt_uint32_t index, count;
+    rt_list_t *node;
+    struct rt_object *object;
+    struct rt_object_information *info;
+    struct rt_trace_record *record;
+
+    /* stop recording while the buffer is printed */
+    enable = _trace_enable;
+    _trace_enable = 0;
+
+    count = _trace_index;
+    index = count > RT_TRACE_BUF_SIZE ? count - RT_TRACE_BUF_SIZE : 0;
+
+    /* the header: version, timestamp frequency, records, lost records */
+    rt_kprintf("# rt-trace 1 %u %u %u\n", rt_timestamp_get_frequency(), count - index, index);
+
+    /* the name of threads */
+    info = rt_object_get_information(RT_Object_Class_Thread);
+    rt_enter_critical();
+    for (node = info->object_list.next; node != &(info->object_list); node = node->next)
+    {
+        object = rt_list_entry(node, struct rt_object, list);
+        rt_kprintf("T %p %.*s\n", object, RT_NAME_MAX, object->name);
+    }
+    rt_exit_critical();
+
+    for (; index != count; index ++)
+    {
+        record = &_trace_buf[index & (RT_TRACE_BUF_SIZE - 1)];
+        rt_kprintf("R %08x %02x %04x %p\n", record->timestamp, record->event,
+                   record->arg, (void *)record->object);
+    }
+
+    _trace_enable = enable;
+}
+
+static int trace(int argc, char **argv)
+{
+    if (argc == 2 && !rt_strcmp(argv[1], "start"))
+    {
+        rt_trace_start();
+    }
+    else if (argc == 2 && !rt_strcmp(argv[1], "stop"))
+    {
+        rt_trace_stop();
+    }
+    else if (argc == 2 && !rt_strcmp(argv[1], "clear"))
+    {
+        rt_trace_clear();
+    }
+    else if (argc == 2 && !rt_strcmp(argv[1], "dump"))
+    {
+        _trace_dump();
+    }
+    else
+    {
+        rt_kprintf("Usage: trace start|stop|clear|dump\n");
+        rt_kprintf("records: %d, recording: %s\n", _trace_index,
+                   _trace_enable ? "yes" : "no");
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(trace, kernel event trace);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_TRACE */
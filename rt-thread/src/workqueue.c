@@ -0,0 +1,482 @@
+/*
+ * Copyright (c) 2006-2021, RT-Thread Development Team
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Change Logs:
+ * Date           Author       Notes
+ * 2026-10-17     weizx208     the first version
+ */
+
+/*
+ * Workqueue.
+ *
+ * The work is run by the thread of workqueue in the order of submitting, it's
+ * the bottom half of interrupt. The work structure is allocated by the user,
+ * so that submitting never allocates memory and can be done in interrupt. The
+ * delayed work is pending when its timer expires.
+ *
+ * Each workqueue measures the time from the work pending to running, and the
+ * time of work function, see finsh command "list_workqueue".
+ */
+
+#include <rthw.h>
+#include <rtthread.h>
+
+#ifdef RT_USING_WORKQUEUE
+
+#ifndef RT_USING_SEMAPHORE
+#error "workqueue requires RT_USING_SEMAPHORE"
+#endif
+
+#ifndef RT_SYSTEM_WORKQUEUE_PRIORITY
+#define RT_SYSTEM_WORKQUEUE_PRIORITY    (RT_THREAD_PRIORITY_MAX / 4)
+#endif
+#ifndef RT_SYSTEM_WORKQUEUE_STACKSIZE
+#define RT_SYSTEM_WORKQUEUE_STACKSIZE   1024
+#endif
+
+/* all workqueues, for the list in finsh */
+static rt_workqueue_t _workqueue_list = RT_NULL;
+
+static struct rt_workqueue _system_workqueue;
+static struct rt_thread _system_workqueue_thread;
+ALIGN(RT_ALIGN_SIZE)
+static rt_uint8_t _system_workqueue_stack[RT_SYSTEM_WORKQUEUE_STACKSIZE];
+
+/* make the work pending, invoked with interrupt disabled */
+static void _workqueue_pending(rt_workqueue_t queue, struct rt_work *work)
+{
+    rt_bool_t empty;
+
+    empty = rt_list_isempty(&(queue->work_list));
+
+    work->flags |= RT_WORK_STATE_PENDING;
+    work->stamp  = rt_timestamp_get();
+    rt_list_insert_before(&(queue->work_list), &(work->list));
+
+    /* the thread takes the semaphore only when the list is empty */
+    if (empty)
+        rt_sem_release(&(queue->sem));
+}
+
+static void _workqueue_thread_entry(void *parameter)
+{
+    rt_base_t level;
+    rt_uint32_t start, latency, time;
+    struct rt_work *work;
+    rt_workqueue_t queue;
+
+    queue = (rt_workqueue_t)parameter;
+    while (1)
+    {
+        level = rt_hw_interrupt_disable();
+        if (rt_list_isempty(&(queue->work_list)))
+        {
+            rt_hw_interrupt_enable(level);
+            rt_sem_take(&(queue->sem), RT_WAITING_FOREVER);
+            continue;
+        }
+
+        work = rt_list_entry(queue->work_list.next, struct rt_work, list);
+        rt_list_remove(&(work->list));
+        work->flags &= ~RT_WORK_STATE_PENDING;
+        queue->work_current = work;
+        start   = rt_timestamp_get();
+        latency = start - work->stamp;
+        rt_hw_interrupt_enable(level);
+
+        /* the work may be submitted again in the function */
+        work->work_func(work, work->work_data);
+        time = rt_timestamp_get() - start;
+
+        level = rt_hw_interrupt_disable();
+        queue->work_current = RT_NULL;
+        queue->done ++;
+        queue->latency_sum += latency;
+        if (latency > queue->latency_max)
+            queue->latency_max = latency;
+        if (time > queue->run_max)
+            queue->run_max = time;
+        rt_hw_interrupt_enable(level);
+    }
+}
+
+static void _workqueue_delayed_timeout(void *parameter)
+{
+    rt_base_t level;
+    struct rt_work *work;
+
+    work = (struct rt_work *)parameter;
+
+    level = rt_hw_interrupt_disable();
+    if (work->flags & RT_WORK_STATE_SUBMITTING)
+    {
+        rt_list_remove(&(work->list));
+        work->flags &= ~RT_WORK_STATE_SUBMITTING;
+        _workqueue_pending(work->workqueue, work);
+    }
+    rt_hw_interrupt_enable(level);
+}
+
+static void _workqueue_start(rt_workqueue_t queue)
+{
+    rt_base_t level;
+
+    rt_list_init(&(queue->work_list));
+    rt_list_init(&(queue->delayed_list));
+    queue->work_current = RT_NULL;
+    queue->done         = 0;
+    queue->latency_max  = 0;
+    queue->latency_sum  = 0;
+    queue->run_max      = 0;
+
+    level = rt_hw_interrupt_disable();
+    queue->next = _workqueue_list;
+    _workqueue_list = queue;
+    rt_hw_interrupt_enable(level);
+
+    rt_thread_startup(queue->work_thread);
+}
+
+/**
+ * @addtogroup IPC
+ */
+
+/**@{*/
+
+/**
+ * This function will initialize a workqueue and start its thread.
+ *
+ * @param queue the workqueue
+ * @param thread the thread object of workqueue
+ * @param name the name of workqueue and its thread
+ * @param stack the stack of thread
+ * @param stack_size the size of stack
+ * @param priority the priority of thread
+ *
+ * @return the operation status, RT_EOK on successful
+ */
+rt_err_t rt_workqueue_init(rt_workqueue_t queue,
+                           struct rt_thread *thread,
+                           const char *name,
+                           void       *stack,
+                           rt_uint32_t stack_size,
+                           rt_uint8_t  priority)
+{
+    rt_err_t result;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(thread != RT_NULL);
+
+    rt_sem_init(&(queue->sem), name, 0, RT_IPC_FLAG_FIFO);
+    result = rt_thread_init(thread, name, _workqueue_thread_entry, queue,
+                            stack, stack_size, priority, 10);
+    if (result != RT_EOK)
+    {
+        rt_sem_detach(&(queue->sem));
+        return result;
+    }
+
+    queue->work_thread = thread;
+    _workqueue_start(queue);
+
+    return RT_EOK;
+}
+
+#ifdef RT_USING_HEAP
+/**
+ * This function will create a workqueue and start its thread.
+ *
+ * @param name the name of workqueue and its thread
+ * @param stack_size the stack size of thread
+ * @param priority the priority of thread
+ *
+ * @return the created workqueue, RT_NULL on error
+ */
+rt_workqueue_t rt_workqueue_create(const char *name,
+                                   rt_uint32_t stack_size,
+                                   rt_uint8_t  priority)
+{
+    rt_workqueue_t queue;
+
+    queue = (rt_workqueue_t)RT_KERNEL_MALLOC(sizeof(struct rt_workqueue));
+    if (queue == RT_NULL)
+        return RT_NULL;
+
+    queue->work_thread = rt_thread_create(name, _workqueue_thread_entry, queue,
+                                          stack_size, priority, 10);
+    if (queue->work_thread == RT_NULL)
+    {
+        RT_KERNEL_FREE(queue);
+        return RT_NULL;
+    }
+
+    rt_sem_init(&(queue->sem), name, 0, RT_IPC_FLAG_FIFO);
+    _workqueue_start(queue);
+
+    return queue;
+}
+#endif
+
+/**
+ * This function will initialize a work. It shall be initialized once, and it
+ * can be submitted many times. Its timer object is detached by rt_work_detach.
+ *
+ * @param work the work
+ * @param work_func the function run by the thread of workqueue
+ * @param work_data the parameter of function
+ */
+void rt_work_init(struct rt_work *work,
+                  void (*work_func)(struct rt_work *work, void *work_data),
+                  void *work_data)
+{
+    RT_ASSERT(work != RT_NULL);
+    RT_ASSERT(work_func != RT_NULL);
+
+    rt_list_init(&(work->list));
+    work->work_func = work_func;
+    work->work_data = work_data;
+    work->flags     = 0;
+    work->workqueue = RT_NULL;
+    rt_timer_init(&(work->timer), "work", _workqueue_delayed_timeout, work,
+                  1, RT_TIMER_FLAG_ONE_SHOT);
+}
+
+/**
+ * This function will submit a work to a workqueue. It can be invoked in
+ * interrupt.
+ *
+ * @param queue the workqueue
+ * @param work the work
+ * @param time the delay in ticks, 0 to be pending at once
+ *
+ * @return RT_EOK on successful, -RT_EBUSY if the work is pending already. The
+ *         delayed work is submitted again with the new delay.
+ */
+rt_err_t rt_workqueue_submit_work(rt_workqueue_t queue, struct rt_work *work, rt_tick_t time)
+{
+    rt_base_t level;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(work != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    if (work->flags & RT_WORK_STATE_PENDING)
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EBUSY;
+    }
+
+    if (work->flags & RT_WORK_STATE_SUBMITTING)
+    {
+        rt_timer_stop(&(work->timer));
+        rt_list_remove(&(work->list));
+        work->flags &= ~RT_WORK_STATE_SUBMITTING;
+    }
+
+    work->workqueue = queue;
+    if (time == 0)
+    {
+        _workqueue_pending(queue, work);
+    }
+    else
+    {
+        work->flags |= RT_WORK_STATE_SUBMITTING;
+        rt_list_insert_before(&(queue->delayed_list), &(work->list));
+        rt_timer_control(&(work->timer), RT_TIMER_CTRL_SET_TIME, &time);
+        rt_timer_start(&(work->timer));
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will cancel a work which is pending or delayed.
+ *
+ * @param queue the workqueue
+ * @param work the work
+ *
+ * @return RT_EOK on successful, -RT_EBUSY if the work is running
+ */
+rt_err_t rt_workqueue_cancel_work(rt_workqueue_t queue, struct rt_work *work)
+{
+    rt_base_t level;
+
+    RT_ASSERT(queue != RT_NULL);
+    RT_ASSERT(work != RT_NULL);
+
+    level = rt_hw_interrupt_disable();
+    if (queue->work_current == work)
+    {
+        rt_hw_interrupt_enable(level);
+        return -RT_EBUSY;
+    }
+
+    if (work->flags & RT_WORK_STATE_SUBMITTING)
+        rt_timer_stop(&(work->timer));
+    if (work->flags & (RT_WORK_STATE_PENDING | RT_WORK_STATE_SUBMITTING))
+    {
+        rt_list_remove(&(work->list));
+        work->flags &= ~(RT_WORK_STATE_PENDING | RT_WORK_STATE_SUBMITTING);
+    }
+    rt_hw_interrupt_enable(level);
+
+    return RT_EOK;
+}
+
+/**
+ * This function will cancel a work and detach its timer object, then the work
+ * can be initialized again. It shall not be submitted after that.
+ *
+ * @param work the work
+ *
+ * @return RT_EOK on successful, -RT_EBUSY if the work is running
+ */
+rt_err_t rt_work_detach(struct rt_work *work)
+{
+    rt_err_t result;
+
+    RT_ASSERT(work != RT_NULL);
+
+    /* the work never submitted is in no workqueue */
+    if (work->workqueue != RT_NULL)
+    {
+        result = rt_workqueue_cancel_work(work->workqueue, work);
+        if (result != RT_EOK)
+            return result;
+    }
+
+    rt_timer_detach(&(work->timer));
+
+    return RT_EOK;
+}
+
+/**
+ * This function will initialize the system workqueue, it's invoked when the
+ * system starts.
+ *
+ * @note please don't invoke this routine in application
+ */
+void rt_system_workqueue_init(void)
+{
+    rt_workqueue_init(&_system_workqueue, &_system_workqueue_thread, "sysworkq",
+                      _system_workqueue_stack, sizeof(_system_workqueue_stack),
+                      RT_SYSTEM_WORKQUEUE_PRIORITY);
+}
+
+/**
+ * This function will submit a work to the system workqueue. It can be invoked
+ * in interrupt.
+ *
+ * @param work the work
+ * @param time the delay in ticks, 0 to be pending at once
+ *
+ * @return RT_EOK on successful, -RT_EBUSY if the work is pending already
+ */
+rt_err_t rt_work_submit(struct rt_work *work, rt_tick_t time)
+{
+    return rt_workqueue_submit_work(&_system_workqueue, work, time);
+}
+
+/**
+ * This function will cancel a work of the system workqueue.
+ *
+ * @param work the work
+ *
+ * @return RT_EOK on successful, -RT_EBUSY if the work is running
+ */
+rt_err_t rt_work_cancel(struct rt_work *work)
+{
+    return rt_workqueue_cancel_work(&_system_workqueue, work);
+}
+
+/**@}*/
+
+#ifdef RT_USING_FINSH
+#include <finsh.h>
+
+#define LIST_WORK_MAX   8
+
+struct _list_work
+{
+    void      (*work_func)(struct rt_work *work, void *work_data);
+    void       *work_data;
+    rt_uint32_t time;
+};
+
+/* the copy of work in list, the time is the waiting time of pending work,
+ * or the ticks to run of delayed work */
+static int _list_work_copy(rt_list_t *list, struct _list_work *copy, rt_bool_t delayed)
+{
+    int count;
+    rt_list_t *node;
+    struct rt_work *work;
+
+    count = 0;
+    for (node = list->next; node != list && count < LIST_WORK_MAX; node = node->next)
+    {
+        work = rt_list_entry(node, struct rt_work, list);
+        copy[count].work_func = work->work_func;
+        copy[count].work_data = work->work_data;
+        if (delayed)
+            copy[count].time = work->timer.timeout_tick - rt_tick_get();
+        else
+            copy[count].time = rt_timestamp_get() - work->stamp;
+        count ++;
+    }
+
+    return count;
+}
+
+static rt_uint32_t _list_us(rt_uint64_t time)
+{
+    return (rt_uint32_t)(time * 1000000 / rt_timestamp_get_frequency());
+}
+
+static long list_workqueue(void)
+{
+    int index, pending, delayed;
+    rt_base_t level;
+    rt_workqueue_t queue;
+    struct rt_workqueue stat;
+    struct _list_work pending_work[LIST_WORK_MAX], delayed_work[LIST_WORK_MAX];
+
+    rt_kprintf("%-*.s pri       done  avg(us)  max(us)  run max(us)\n", RT_NAME_MAX, "workqueue");
+    for (index = 0; index < RT_NAME_MAX; index ++)
+        rt_kprintf("-");
+    rt_kprintf(" --- ---------- -------- -------- ------------\n");
+
+    for (queue = _workqueue_list; queue != RT_NULL; queue = queue->next)
+    {
+        level = rt_hw_interrupt_disable();
+        stat    = *queue;
+        pending = _list_work_copy(&(queue->work_list), pending_work, RT_FALSE);
+        delayed = _list_work_copy(&(queue->delayed_list), delayed_work, RT_TRUE);
+        rt_hw_interrupt_enable(level);
+
+        rt_kprintf("%-*.*s %3d %10d %8d %8d %12d\n", RT_NAME_MAX, RT_NAME_MAX,
+                   stat.work_thread->name, stat.work_thread->current_priority, stat.done,
+                   stat.done ? _list_us(stat.latency_sum / stat.done) : 0,
+                   _list_us(stat.latency_max), _list_us(stat.run_max));
+
+        if (stat.work_current != RT_NULL)
+            rt_kprintf("  running: func 0x%p data 0x%p\n",
+                       stat.work_current->work_func, stat.work_current->work_data);
+        for (index = 0; index < pending; index ++)
+            rt_kprintf("  pending: func 0x%p data 0x%p, waiting %d us\n",
+                       pending_work[index].work_func, pending_work[index].work_data,
+                       _list_us(pending_work[index].time));
+        for (index = 0; index < delayed; index ++)
+            rt_kprintf("  delayed: func 0x%p data 0x%p, in %d ticks\n",
+                       delayed_work[index].work_func, delayed_work[index].work_data,
+                       delayed_work[index].time);
+    }
+
+    return 0;
+}
+MSH_CMD_EXPORT(list_workqueue, list workqueue and the pending work);
+#endif /* RT_USING_FINSH */
+
+#endif /* RT_USING_WORKQUEUE */
@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2021, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-17     weizx208     the first version
+# 2026-10-17     weizx208     decode the words in pointer width
+#
+# Decode the output of finsh command "blog dump" (RT_USING_BLOG). The format
+# strings are read from the firmware image, which shall be the ELF file (.axf
+# or .elf) of the running firmware.
+#
+# usage: blog_decode.py firmware.elf [log file]
+#
+
+import re
+import struct
+import sys
+
+TIMESTAMP_MASK = 0x0fffffff
+
+CONVERSION = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|z)?([diouxXcsp%])")
+
+
+class Image:
+    """the loadable sections of an ELF file"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+
+        if data[:4] != b"\x7fELF":
+            raise ValueError("%s is not an ELF file" % path)
+
+        is64 = data[4] == 2
+        endian = "<" if data[5] == 1 else ">"
+        if is64:
+            shoff, = struct.unpack_from(endian + "Q", data, 0x28)
+            shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x3a)
+            header = endian + "IIQQQQ"
+        else:
+            shoff, = struct.unpack_from(endian + "I", data, 0x20)
+            shentsize, shnum = struct.unpack_from(endian + "HH", data, 0x2e)
+            header = endian + "IIIIII"
+
+        self.sections = []
+        for index in range(shnum):
+            _, kind, flags, addr, offset, size = \
+                struct.unpack_from(header, data, shoff + index * shentsize)
+            # SHT_PROGBITS with SHF_ALLOC
+            if kind == 1 and flags & 0x2 and size:
+                self.sections.append((addr, data[offset:offset + size]))
+
+    def string(self, address):
+        for base, content in self.sections:
+            if base <= address < base + len(content):
+                end = content.find(b"\0", address - base)
+                if end < 0:
+                    end = len(content)
+                return content[address - base:end].decode("ascii", "replace")
+        return None
+
+
+def parse(lines):
+    frequency = 0
+    dropped = 0
+    # the words are 32 bits in version 1
+    size = 4
+    names = {}
+    records = []
+
+    for line in lines:
+        fields = line.split()
+        if len(fields) >= 6 and fields[0] == "#" and fields[1] == "rt-blog":
+            frequency = int(fields[3])
+            dropped = int(fields[5])
+            if int(fields[2]) >= 2 and len(fields) >= 7:
+                size = int(fields[6])
+        elif len(fields) >= 2 and fields[0] == "O":
+            names[int(fields[1], 16)] = fields[2] if len(fields) > 2 else ""
+        elif len(fields) >= 3 and fields[0] == "L":
+            records.append((int(fields[1], 16), int(fields[2], 16),
+                            [int(arg, 16) for arg in fields[3:]]))
+
+    return frequency, dropped, size, names, records
+
+
+def signed(value, bits):
+    value &= (1 << bits) - 1
+    return value - (1 << bits) if value >> (bits - 1) else value
+
+
+def format_record(image, names, size, format, args):
+    args = list(args)
+
+    def take():
+        return args.pop(0) if args else 0
+
+    def convert(match):
+        flags, width, precision, qualifier, kind = match.groups()
+        if kind == "%":
+            return "%"
+
+        if width == "*":
+            width = str(signed(take(), 32))
+        if precision == "*":
+            precision = str(take())
+        spec = "%" + flags + (width or "") + ("." + precision if precision else "")
+
+        # the int arguments are sign extended to the word by RT_BLOG
+        bits = 32
+        if qualifier in ("l", "z"):
+            bits = size * 8
+        elif qualifier == "ll":
+            bits = 64
+
+        value = take()
+        if kind in "di":
+            return (spec + "d") % signed(value, bits)
+        if kind == "c":
+            return (spec + "c") % chr(value & 0xff)
+        if kind == "p":
+            # the same as rt_kprintf, zero padded hex without "0x"
+            return (spec + "s") % ("%0*x" % (size * 2, value))
+        if kind == "s":
+            text = names.get(value)
+            if text is None:
+                text = image.string(value)
+            if text is None:
+                text = "<0x%0*x>" % (size * 2, value)
+            return (spec + "s") % text
+        return (spec + kind) % (value & ((1 << bits) - 1))
+
+    return CONVERSION.sub(convert, format)
+
+
+def decode(image, frequency, dropped, size, names, records):
+    if not records:
+        print("no binary log records found")
+        return
+
+    print("records %d, dropped %d" % (len(records), dropped))
+
+    elapsed = 0
+    last = records[0][1]
+    for address, timestamp, args in records:
+        elapsed += (timestamp - last) & TIMESTAMP_MASK
+        last = timestamp
+
+        format = image.string(address)
+        if format is None:
+            text = "<unknown format 0x%0*x> %s" % \
+                (size * 2, address, " ".join("%0*x" % (size * 2, arg) for arg in args))
+        else:
+            text = format_record(image, names, size, format, args)
+
+        if frequency:
+            print("[%12.6f] %s" % (elapsed / float(frequency), text.rstrip("\n")))
+        else:
+            print("[%12d] %s" % (elapsed, text.rstrip("\n")))
+
+
+def main():
+    if len(sys.argv) < 2:
+        print("usage: blog_decode.py firmware.elf [log file]")
+        sys.exit(1)
+
+    image = Image(sys.argv[1])
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], errors="replace") as f:
+            lines = f.readlines()
+    else:
+        lines = sys.stdin.readlines()
+
+    decode(image, *parse(lines))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,169 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2006-2021, RT-Thread Development Team
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Change Logs:
+# Date           Author       Notes
+# 2026-10-17     weizx208     the first version
+#
+# Decode the output of finsh command "trace dump" (RT_USING_TRACE), and
+# report the run time of threads, the wake up latency and the interrupt
+# durations.
+#
+# usage: trace_decode.py [log file]
+#
+
+import sys
+
+RT_TRACE_THREAD_SWITCH = 0x01
+RT_TRACE_IRQ_ENTER     = 0x02
+RT_TRACE_IRQ_LEAVE     = 0x03
+RT_TRACE_IPC_BLOCK     = 0x04
+RT_TRACE_IPC_WAKE      = 0x05
+RT_TRACE_TIMER_EXPIRE  = 0x06
+
+TIMESTAMP_MASK = 0xffffffff
+
+
+class Histogram:
+    """histogram of durations in power of 2 microseconds"""
+
+    def __init__(self):
+        self.buckets = {}
+        self.count = 0
+        self.total = 0.0
+        self.max = 0.0
+
+    def add(self, us):
+        bucket = 1
+        while bucket < us:
+            bucket <<= 1
+        self.buckets[bucket] = self.buckets.get(bucket, 0) + 1
+        self.count += 1
+        self.total += us
+        self.max = max(self.max, us)
+
+    def show(self, title):
+        print(title)
+        if self.count == 0:
+            print("    (none)")
+            return
+        print("    count %d, avg %.2f us, max %.2f us" %
+              (self.count, self.total / self.count, self.max))
+        width = max(self.buckets.values())
+        for bucket in sorted(self.buckets):
+            bar = "#" * max(1, self.buckets[bucket] * 40 // width)
+            print("    <= %8d us %8d %s" % (bucket, self.buckets[bucket], bar))
+
+
+def parse(lines):
+    frequency = 0
+    lost = 0
+    names = {}
+    records = []
+
+    for line in lines:
+        fields = line.split()
+        if len(fields) >= 6 and fields[0] == "#" and fields[1] == "rt-trace":
+            frequency = int(fields[3])
+            lost = int(fields[5])
+        elif len(fields) >= 2 and fields[0] == "T":
+            names[int(fields[1], 16)] = fields[2] if len(fields) > 2 else "?"
+        elif len(fields) == 5 and fields[0] == "R":
+            records.append((int(fields[1], 16), int(fields[2], 16),
+                            int(fields[3], 16), int(fields[4], 16)))
+
+    return frequency, lost, names, records
+
+
+def decode(frequency, lost, names, records):
+    if frequency == 0 or not records:
+        print("no trace records found")
+        return
+
+    def us(delta):
+        return (delta & TIMESTAMP_MASK) * 1000000.0 / frequency
+
+    def name(address):
+        return names.get(address, "0x%08x" % address)
+
+    run_time = {}
+    switches = {}
+    blocks = {}
+    wake_at = {}
+    irq_enter = []
+    timers = {}
+    wakeup = Histogram()
+    irq = Histogram()
+
+    current = None
+    since = records[0][0]
+    elapsed = 0
+
+    for index, (timestamp, event, arg, obj) in enumerate(records):
+        if index > 0:
+            elapsed += (timestamp - records[index - 1][0]) & TIMESTAMP_MASK
+
+        if event == RT_TRACE_THREAD_SWITCH:
+            if current is not None:
+                run_time[current] = run_time.get(current, 0) + \
+                    ((timestamp - since) & TIMESTAMP_MASK)
+            current = obj
+            since = timestamp
+            switches[obj] = switches.get(obj, 0) + 1
+            if obj in wake_at:
+                wakeup.add(us(timestamp - wake_at.pop(obj)))
+        elif event == RT_TRACE_IRQ_ENTER:
+            irq_enter.append(timestamp)
+        elif event == RT_TRACE_IRQ_LEAVE:
+            if irq_enter:
+                enter = irq_enter.pop()
+                # only the outermost interrupt blocks the threads
+                if not irq_enter:
+                    irq.add(us(timestamp - enter))
+        elif event == RT_TRACE_IPC_BLOCK:
+            blocks[obj] = blocks.get(obj, 0) + 1
+        elif event == RT_TRACE_IPC_WAKE:
+            wake_at.setdefault(obj, timestamp)
+        elif event == RT_TRACE_TIMER_EXPIRE:
+            timers[obj] = timers.get(obj, 0) + 1
+
+    if current is not None:
+        run_time[current] = run_time.get(current, 0) + \
+            ((records[-1][0] - since) & TIMESTAMP_MASK)
+
+    print("records %d, lost %d, duration %.3f ms" %
+          (len(records), lost, us(elapsed) / 1000))
+    print("")
+    print("%-*s %12s %6s %8s %8s" % (16, "thread", "run(us)", "cpu", "switch", "block"))
+    print("-" * 56)
+    for thread in sorted(run_time, key=run_time.get, reverse=True):
+        print("%-*s %12.1f %5.1f%% %8d %8d" %
+              (16, name(thread), us(run_time[thread]),
+               run_time[thread] * 100.0 / elapsed if elapsed else 0,
+               switches.get(thread, 0), blocks.get(thread, 0)))
+    print("")
+    wakeup.show("wake up latency (IPC wake to switch in):")
+    print("")
+    irq.show("interrupt duration (threads are held off):")
+    if timers:
+        print("")
+        print("timer timeouts:")
+        for timer in sorted(timers, key=timers.get, reverse=True):
+            print("    0x%08x %8d" % (timer, timers[timer]))
+
+
+def main():
+    if len(sys.argv) > 1:
+        with open(sys.argv[1], errors="replace") as f:
+            lines = f.readlines()
+    else:
+        lines = sys.stdin.readlines()
+
+    decode(*parse(lines))
+
+
+if __name__ == "__main__":
+    main()